@@ -0,0 +1,175 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "SerialDate.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+const std::vector<Date> &Dates() {
+	static const auto dates = [] {
+		std::vector<Date> dates;
+		std::mt19937_64 random(37);
+		for (int i = 0; i < 1024; ++i)
+			dates.emplace_back(date::year_month_day(date::sys_days(date::year(1950) / 1 / 1) + date::days(random() % 40000)));
+		return dates;
+	}();
+	return dates;
+}
+
+const std::vector<SerialDate> &SerialDates() {
+	static const std::vector<SerialDate> dates(Dates().begin(), Dates().end());
+	return dates;
+}
+
+const std::vector<TimeDelta> &Deltas() {
+	static const auto deltas = [] {
+		std::vector<TimeDelta> deltas;
+		std::mt19937_64 random(41);
+		for (int i = 0; i < 1024; ++i)
+			deltas.emplace_back(date::days(random() % 1000), std::chrono::seconds(random() % 86400), std::chrono::microseconds(random() % 1000000));
+		return deltas;
+	}();
+	return deltas;
+}
+
+/// What a scheduler does with dates: steps them, measures the distance to others and, one step
+/// in eight, reads the month.
+template<class DateType>
+void Schedule(std::size_t iterations, const std::vector<DateType> &dates) {
+	const auto &deltas = Deltas();
+	std::int64_t days = 0;
+	unsigned months = 0;
+	for (std::size_t i = 0; i < iterations; ++i) {
+		auto next = dates[i % 1024] + deltas[(i * 7) % 1024];
+		days += (next - dates[(i * 13) % 1024]).Days();
+		if (i % 8 == 0)
+			months += static_cast<unsigned>(next.Month());
+	}
+	DoNotOptimize(days);
+	DoNotOptimize(months);
+}
+
+const std::vector<DateTime<>> &DateTimes() {
+	static const auto values = [] {
+		std::vector<DateTime<>> values;
+		std::mt19937_64 random(43);
+		auto zone = date::locate_zone("Europe/Berlin");
+		for (int i = 0; i < 1024; ++i)
+			values.emplace_back(date::make_zoned(zone, date::sys_days(date::year(2024) / 1 / 1) + std::chrono::seconds(random() % (366 * 86400))));
+		return values;
+	}();
+	return values;
+}
+}
+
+DATETIME_BENCHMARK("Date/AddDelta", [](std::size_t iterations) {
+	const auto &dates = Dates();
+	const auto &deltas = Deltas();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(dates[i % 1024] + deltas[(i * 7) % 1024]);
+});
+DATETIME_BENCHMARK("Date/Difference", [](std::size_t iterations) {
+	const auto &dates = Dates();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(dates[i % 1024] - dates[(i * 7) % 1024]);
+});
+DATETIME_BENCHMARK("Date/Weekday", [](std::size_t iterations) {
+	const auto &dates = Dates();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(dates[i % 1024].Weekday());
+});
+DATETIME_BENCHMARK("Date/IsoWeek", [](std::size_t iterations) {
+	const auto &dates = Dates();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(dates[i % 1024].IsoWeek());
+});
+DATETIME_BENCHMARK("Date/Schedule", [](std::size_t iterations) { Schedule(iterations, Dates()); });
+DATETIME_BENCHMARK("SerialDate/AddDelta", [](std::size_t iterations) {
+	const auto &dates = SerialDates();
+	const auto &deltas = Deltas();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(dates[i % 1024] + deltas[(i * 7) % 1024]);
+});
+DATETIME_BENCHMARK("SerialDate/Difference", [](std::size_t iterations) {
+	const auto &dates = SerialDates();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(dates[i % 1024] - dates[(i * 7) % 1024]);
+});
+DATETIME_BENCHMARK("SerialDate/Weekday", [](std::size_t iterations) {
+	const auto &dates = SerialDates();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(dates[i % 1024].Weekday());
+});
+DATETIME_BENCHMARK("SerialDate/IsoWeek", [](std::size_t iterations) {
+	const auto &dates = SerialDates();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(dates[i % 1024].IsoWeek());
+});
+/// Per date, the weeks of a whole column written at once.
+DATETIME_BENCHMARK("SerialDate/IsoWeeks", [](std::size_t iterations) {
+	const auto &dates = SerialDates();
+	std::uint8_t weeks[1024];
+	for (std::size_t i = 0; i < iterations; i += 1024) {
+		IsoWeeks(dates.data(), 1024, weeks);
+		DoNotOptimize(weeks);
+	}
+});
+DATETIME_BENCHMARK("SerialDate/Schedule", [](std::size_t iterations) { Schedule(iterations, SerialDates()); });
+DATETIME_BENCHMARK("SerialDate/FromDate", [](std::size_t iterations) {
+	const auto &dates = Dates();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(SerialDate(dates[i % 1024]));
+});
+DATETIME_BENCHMARK("SerialDate/ToDate", [](std::size_t iterations) {
+	const auto &dates = SerialDates();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(Date(dates[i % 1024]));
+});
+DATETIME_BENCHMARK("TimeDelta/Add", [](std::size_t iterations) {
+	const auto &deltas = Deltas();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(deltas[i % 1024] + deltas[(i * 7) % 1024]);
+});
+DATETIME_BENCHMARK("TimeDelta/Subtract", [](std::size_t iterations) {
+	const auto &deltas = Deltas();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(deltas[i % 1024] - deltas[(i * 7) % 1024]);
+});
+DATETIME_BENCHMARK("TimeDelta/MultiplyInt", [](std::size_t iterations) {
+	const auto &deltas = Deltas();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(deltas[i % 1024] * static_cast<int>(i % 13));
+});
+DATETIME_BENCHMARK("TimeDelta/MultiplyDouble", [](std::size_t iterations) {
+	const auto &deltas = Deltas();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(deltas[i % 1024] * (0.5 + static_cast<double>(i % 13)));
+});
+DATETIME_BENCHMARK("DateTime/AddDelta", [](std::size_t iterations) {
+	const auto &values = DateTimes();
+	const auto &deltas = Deltas();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(values[i % 1024] + deltas[(i * 7) % 1024]);
+});
+DATETIME_BENCHMARK("DateTime/Difference", [](std::size_t iterations) {
+	const auto &values = DateTimes();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(values[i % 1024] - values[(i * 7) % 1024]);
+});
+DATETIME_BENCHMARK("DateTime/Date", [](std::size_t iterations) {
+	const auto &values = DateTimes();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(values[i % 1024].Date());
+});
+DATETIME_BENCHMARK("DateTime/Compare", [](std::size_t iterations) {
+	const auto &values = DateTimes();
+	std::size_t less = 0;
+	for (std::size_t i = 0; i < iterations; ++i)
+		less += values[i % 1024] < values[(i * 7) % 1024];
+	DoNotOptimize(less);
+});
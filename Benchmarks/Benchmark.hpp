@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace datetime::bench {
+/// Keeps the compiler from optimising away a value computed by a benchmark.
+template<class T>
+void DoNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void *sink;
+	sink = &value;
+#endif
+}
+
+/// A named benchmark, run is called with the number of operations it has to perform. With
+/// more than one thread the runner calls it on that many threads at once, each performing
+/// the given number of operations.
+struct Benchmark {
+	std::string name;
+	std::function<void(std::size_t iterations)> run;
+	unsigned threads = 1;
+};
+
+inline std::vector<Benchmark> &Registry() {
+	static std::vector<Benchmark> benchmarks;
+	return benchmarks;
+}
+
+/// Figures a benchmark reports next to its time, such as bytes per value. Set them from
+/// one thread only.
+inline std::vector<std::pair<std::string, double>> &Counters() {
+	static std::vector<std::pair<std::string, double>> counters;
+	return counters;
+}
+
+inline void SetCounter(const std::string &name, double value) {
+	for (auto &counter : Counters()) {
+		if (counter.first == name) {
+			counter.second = value;
+			return;
+		}
+	}
+	Counters().emplace_back(name, value);
+}
+
+/// Heap allocations made by the process so far, counted by the benchmark runner.
+std::size_t Allocations();
+
+/// Heap bytes allocated and not yet freed, from operator new, so memory the C library
+/// allocates for itself is not included.
+std::size_t LiveBytes();
+
+struct Register {
+	Register(std::string name, std::function<void(std::size_t)> run) {
+		Registry().push_back({std::move(name), std::move(run)});
+	}
+
+	/// One benchmark per thread count, named name/Threads:n.
+	Register(const std::string &name, std::initializer_list<unsigned> threads, std::function<void(std::size_t)> run) {
+		for (auto n : threads)
+			Registry().push_back({name + "/Threads:" + std::to_string(n), run, n});
+	}
+};
+}
+
+#define DATETIME_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define DATETIME_BENCHMARK_CONCAT(a, b) DATETIME_BENCHMARK_CONCAT_IMPL(a, b)
+
+/// Registers a benchmark body taking a std::size_t iterations argument, for example
+///   DATETIME_BENCHMARK("Cron/NextAfter", [](std::size_t iterations) { ... });
+/// or, to measure how it scales, once per thread count
+///   DATETIME_BENCHMARK("Format/ISO8601", {1, 2, 4, 8}, [](std::size_t iterations) { ... });
+#define DATETIME_BENCHMARK(name, ...) \
+	static datetime::bench::Register DATETIME_BENCHMARK_CONCAT(benchmarkRegister, __LINE__)(name, __VA_ARGS__)
@@ -0,0 +1,77 @@
+#include <iterator>
+#include <vector>
+
+#include "CronSchedule.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+const char *corpus[] = {
+	"* * * * *",
+	"*/15 * * * *",
+	"0 * * * *",
+	"30 2 * * *",
+	"0 9-17 * * MON-FRI",
+	"0 0 1 * *",
+	"0 0 1,15 * *",
+	"0 12 * * 0",
+	"0 0 13 * FRI",
+	"0 4 8-14 * *",
+	"0 0 1 1 *",
+	"0 3 29 2 *",
+	"*/10 * * * * *",
+	"0 0 0 * JAN,JUL SAT",
+};
+
+void NextAfterCorpus(std::size_t iterations, const char *zoneName) {
+	std::vector<CronSchedule> schedules;
+	for (auto expression : corpus)
+		schedules.push_back(CronSchedule::Parse(expression));
+	auto zone = date::locate_zone(zoneName);
+	auto start = date::sys_days(date::year(2024) / 1 / 1) + std::chrono::seconds(0);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		auto &schedule = schedules[i % schedules.size()];
+		DoNotOptimize(schedule.NextAfter(start + std::chrono::minutes(i % 100000), zone));
+	}
+}
+
+/// The approach NextAfter replaces, stepping a minute at a time until the fields match.
+void ProbeByMinute(std::size_t iterations) {
+	auto zone = date::locate_zone("Europe/Berlin");
+	auto start = date::sys_days(date::year(2024) / 1 / 1) + std::chrono::seconds(0);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		auto tp = date::floor<std::chrono::minutes>(start + std::chrono::minutes(i % 100000)) + std::chrono::minutes(1);
+		for (;; tp += std::chrono::minutes(1)) {
+			auto local = zone->to_local(tp);
+			auto tod = date::make_time(local - date::floor<date::days>(local));
+			if (tod.hours().count() == 2 && tod.minutes().count() == 30)
+				break;
+		}
+		DoNotOptimize(tp);
+	}
+}
+}
+
+DATETIME_BENCHMARK("Cron/Parse", [](std::size_t iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(CronSchedule::Parse(corpus[i % std::size(corpus)]));
+});
+DATETIME_BENCHMARK("Cron/NextAfter/UTC", [](std::size_t iterations) { NextAfterCorpus(iterations, "UTC"); });
+DATETIME_BENCHMARK("Cron/NextAfter/Europe/Berlin", [](std::size_t iterations) { NextAfterCorpus(iterations, "Europe/Berlin"); });
+DATETIME_BENCHMARK("Cron/NextAfter/Sparse", [](std::size_t iterations) {
+	auto schedule = CronSchedule::Parse("0 3 29 2 *");
+	auto zone = date::locate_zone("America/New_York");
+	auto start = date::sys_days(date::year(2024) / 1 / 1) + std::chrono::seconds(0);
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(schedule.NextAfter(start + std::chrono::hours(i % 100000), zone));
+});
+DATETIME_BENCHMARK("Cron/NextN/100", [](std::size_t iterations) {
+	auto schedule = CronSchedule::Parse("*/15 9-17 * * MON-FRI");
+	auto start = DateTime<std::chrono::seconds>(date::make_zoned("Europe/Berlin", date::sys_days(date::year(2024) / 3 / 1) + std::chrono::seconds(0)));
+	std::vector<DateTime<std::chrono::seconds>> fires(100);
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(schedule.NextN(start, fires.size(), fires.begin()));
+});
+DATETIME_BENCHMARK("Cron/ProbeByMinute/Daily", ProbeByMinute);
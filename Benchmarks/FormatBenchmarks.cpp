@@ -0,0 +1,97 @@
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+/// Instants of 2024 spread over a few zones.
+const std::vector<DateTime<>> &Values() {
+	static const auto values = [] {
+		const char *zones[] = {"Europe/Berlin", "America/New_York", "Asia/Kolkata", "Australia/Sydney"};
+		std::vector<DateTime<>> values;
+		std::mt19937_64 random(23);
+		auto begin = date::sys_days(date::year(2024) / 1 / 1);
+		for (int i = 0; i < 1024; ++i)
+			values.emplace_back(date::make_zoned(zones[i % 4], begin + std::chrono::seconds(random() % (366 * 86400))));
+		return values;
+	}();
+	return values;
+}
+
+/// Runs body on the values in turn, allocations per operation are reported by the runner.
+template<class Body>
+void ForEachValue(std::size_t iterations, Body body) {
+	const auto &values = Values();
+	for (std::size_t i = 0; i < iterations; ++i)
+		body(values[i % values.size()]);
+}
+
+const std::pair<const char *, std::string_view> formats[] = {
+	{"ISO8601", ISO8601_FORMAT}, {"ISO8601_FRAC", ISO8601_FRAC_FORMAT}, {"RFC822", RFC822_FORMAT}, {"RFC1123", RFC1123_FORMAT},
+	{"HTTP", HTTP_FORMAT}, {"RFC850", RFC850_FORMAT}, {"RFC1036", RFC1036_FORMAT}, {"ASCTIME", ASCTIME_FORMAT}, {"SORTABLE", SORTABLE_FORMAT},
+};
+
+const bool registered = [] {
+	for (const auto &format : formats) {
+		auto pattern = format.second;
+		Register(std::string("Format/Constant/") + format.first, [pattern](std::size_t iterations) {
+			ForEachValue(iterations, [pattern](const DateTime<> &dt) { DoNotOptimize(dt.Format(pattern)); });
+		});
+	}
+	return true;
+}();
+}
+
+/// What Format did before the single pass path, for comparison.
+DATETIME_BENCHMARK("Format/DateFormat/ISO8601", [](std::size_t iterations) {
+	ForEachValue(iterations, [](const DateTime<> &dt) { DoNotOptimize(date::format("%Y-%m-%dT%H:%M:%S%z", dt.ZonedTime())); });
+});
+DATETIME_BENCHMARK("Format/ISO8601", [](std::size_t iterations) {
+	ForEachValue(iterations, [](const DateTime<> &dt) { DoNotOptimize(dt.Format()); });
+});
+DATETIME_BENCHMARK("Format/ISO8601", {1, 2, 4, 8}, [](std::size_t iterations) {
+	ForEachValue(iterations, [](const DateTime<> &dt) { DoNotOptimize(dt.Format()); });
+});
+DATETIME_BENCHMARK("Format/Abbreviation", [](std::size_t iterations) {
+	ForEachValue(iterations, [](const DateTime<> &dt) { DoNotOptimize(dt.Format("%d %H:%M %Z")); });
+});
+DATETIME_BENCHMARK("FormatTo/ISO8601", [](std::size_t iterations) {
+	ForEachValue(iterations, [](const DateTime<> &dt) {
+		char buffer[64];
+		DoNotOptimize(dt.FormatTo(buffer));
+	});
+});
+DATETIME_BENCHMARK("FormatTo/Abbreviation", [](std::size_t iterations) {
+	ForEachValue(iterations, [](const DateTime<> &dt) {
+		char buffer[64];
+		DoNotOptimize(dt.FormatTo(buffer, "%F %T %Z"));
+	});
+});
+DATETIME_BENCHMARK("UtcOffset", [](std::size_t iterations) {
+	ForEachValue(iterations, [](const DateTime<> &dt) { DoNotOptimize(dt.UtcOffset()); });
+});
+DATETIME_BENCHMARK("GetInfo", [](std::size_t iterations) {
+	ForEachValue(iterations, [](const DateTime<> &dt) { DoNotOptimize(dt.ZonedTime().get_info()); });
+});
+DATETIME_BENCHMARK("GetInfoView", [](std::size_t iterations) {
+	ForEachValue(iterations, [](const DateTime<> &dt) { DoNotOptimize(dt.Timezone()->get_info_view(dt.ZonedTime().get_sys_time())); });
+});
+DATETIME_BENCHMARK("Format/FixedOffset/ISO8601", [](std::size_t iterations) {
+	static const auto values = [] {
+		std::vector<DateTime<std::chrono::system_clock::duration, FixedOffsetZone>> values;
+		for (const auto &dt : Values())
+			values.emplace_back(date::zoned_time<std::chrono::system_clock::duration, FixedOffsetZone>(
+				FixedOffsetZone(std::chrono::minutes(dt.UtcOffset().TotalSeconds() / 60)), dt.ZonedTime().get_sys_time()));
+		return values;
+	}();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(values[i % values.size()].Format());
+});
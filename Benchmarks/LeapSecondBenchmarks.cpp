@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "LeapSeconds.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+using GpsTime = date::gps_time<std::chrono::microseconds>;
+using SysTime = date::sys_time<std::chrono::microseconds>;
+
+/// Telemetry samples in GPS time, sorted and spread over the last few years.
+const std::vector<GpsTime> &Samples() {
+	static const auto samples = [] {
+		std::vector<GpsTime> samples(1 << 16);
+		std::mt19937_64 random(13);
+		auto base = date::clock_cast<date::gps_clock>(SysTime(date::sys_days(date::year(2015) / 1 / 1)));
+		for (auto &t : samples)
+			t = base + std::chrono::microseconds(random() % (std::uint64_t(8) * 365 * 86400000000));
+		std::sort(samples.begin(), samples.end());
+		return samples;
+	}();
+	return samples;
+}
+
+void ClockCast(std::size_t iterations) {
+	const auto &samples = Samples();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(date::clock_cast<std::chrono::system_clock>(samples[i % samples.size()]));
+}
+
+void Scalar(std::size_t iterations) {
+	const auto &samples = Samples();
+	LeapSeconds leaps;
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(leaps.ToSys(samples[i % samples.size()]));
+}
+
+void Span(std::size_t iterations) {
+	const auto &samples = Samples();
+	LeapSeconds leaps;
+	std::vector<SysTime> out(samples.size());
+	for (std::size_t i = 0; i < iterations; i += samples.size()) {
+		auto count = static_cast<std::ptrdiff_t>(std::min(samples.size(), iterations - i));
+		leaps.ToSys(samples.begin(), samples.begin() + count, out.begin());
+		DoNotOptimize(out.back());
+	}
+}
+}
+
+DATETIME_BENCHMARK("LeapSeconds/ClockCast/GpsToSys", ClockCast);
+DATETIME_BENCHMARK("LeapSeconds/Scalar/GpsToSys", Scalar);
+DATETIME_BENCHMARK("LeapSeconds/Span/GpsToSys", Span);
@@ -0,0 +1,67 @@
+#include <vector>
+
+#include "LocalTimeFilter.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+/// A sorted column of 100M event times about 4 seconds apart, covering a dozen years.
+const std::vector<date::sys_seconds> &Column() {
+	static const auto column = [] {
+		std::vector<date::sys_seconds> column(100000000);
+		auto t = date::sys_seconds(date::sys_days(date::year(2012) / 1 / 1));
+		std::uint64_t state = 88172645463325252ull;
+		for (auto &row : column) {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			t += std::chrono::seconds(state % 8);
+			row = t;
+		}
+		return column;
+	}();
+	return column;
+}
+
+LocalTimeFilter BusinessHours() {
+	return LocalTimeFilter(date::locate_zone("Europe/Berlin"))
+		.TimeOfDay(std::chrono::hours(9), std::chrono::hours(17))
+		.OnWeekdays({date::Monday, date::Tuesday, date::Wednesday, date::Thursday, date::Friday});
+}
+
+/// Filters iterations rows, wrapping around the column in whole mask words.
+void Filter(std::size_t iterations, const LocalTimeFilter &filter) {
+	const auto &column = Column();
+	static std::vector<std::uint64_t> mask(column.size() / 64 + 1);
+	static std::size_t position = 0;
+	std::size_t matches = 0;
+	for (std::size_t done = 0; done < iterations;) {
+		auto rows = std::min(column.size() - position, (iterations - done + 63) / 64 * 64);
+		matches += filter.Evaluate(column.data() + position, column.data() + position + rows, mask.data() + position / 64);
+		done += rows;
+		position = (position + rows) % column.size() / 64 * 64;
+	}
+	DoNotOptimize(matches);
+}
+}
+
+DATETIME_BENCHMARK("LocalTimeFilter/BusinessHours/100M", [](std::size_t iterations) { Filter(iterations, BusinessHours()); });
+DATETIME_BENCHMARK("LocalTimeFilter/NightInDst/100M", [](std::size_t iterations) {
+	Filter(iterations, LocalTimeFilter(date::locate_zone("America/New_York")).TimeOfDay(std::chrono::hours(22), std::chrono::hours(6)).InDst(true));
+});
+DATETIME_BENCHMARK("LocalTimeFilter/DateTimePerRow/100M", [](std::size_t iterations) {
+	const auto &column = Column();
+	auto zone = date::locate_zone("Europe/Berlin");
+	std::size_t matches = 0;
+	for (std::size_t i = 0; i < iterations; ++i) {
+		DateTime<std::chrono::seconds> dt{date::make_zoned(zone, column[i % column.size()])};
+		auto local = dt.ZonedTime().get_local_time();
+		auto day = date::floor<date::days>(local);
+		auto time = local - day;
+		auto weekday = date::weekday(day);
+		matches += time >= std::chrono::hours(9) && time < std::chrono::hours(17) && weekday != date::Saturday && weekday != date::Sunday;
+	}
+	DoNotOptimize(matches);
+});
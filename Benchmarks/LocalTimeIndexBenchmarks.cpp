@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LocalTimeIndex.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+using Local = date::local_time<std::chrono::seconds>;
+
+/// Sorted local timestamps of a log written in Berlin during 2024, DST changes included.
+const std::vector<std::string> &Lines() {
+	static const auto lines = [] {
+		std::mt19937_64 random(29);
+		std::vector<std::int64_t> seconds(1 << 16);
+		for (auto &s : seconds)
+			s = static_cast<std::int64_t>(random() % (366 * 86400));
+		std::sort(seconds.begin(), seconds.end());
+		std::vector<std::string> lines;
+		auto begin = date::local_days(date::year(2024) / 1 / 1);
+		for (auto s : seconds)
+			lines.push_back(date::format("%Y-%m-%d %H:%M:%S", begin + std::chrono::seconds(s)));
+		return lines;
+	}();
+	return lines;
+}
+
+const std::vector<Local> &Parsed() {
+	static const auto parsed = [] {
+		std::vector<Local> parsed(Lines().size());
+		for (std::size_t i = 0; i < parsed.size(); ++i)
+			detail::FastParse(Lines()[i], SORTABLE_FORMAT, parsed[i]);
+		return parsed;
+	}();
+	return parsed;
+}
+
+const date::time_zone *Berlin() {
+	static const auto zone = date::locate_zone("Europe/Berlin");
+	return zone;
+}
+
+const LocalTimeIndex &Index() {
+	static const LocalTimeIndex index(Berlin(), date::year(2000), date::year(2040));
+	return index;
+}
+}
+
+DATETIME_BENCHMARK("LocalTimeIndex/Parse/MakeZoned", [](std::size_t iterations) {
+	const auto &lines = Lines();
+	for (std::size_t i = 0; i < iterations; ++i) {
+		Local local;
+		detail::FastParse(lines[i % lines.size()], SORTABLE_FORMAT, local);
+		DoNotOptimize(date::make_zoned(Berlin(), local, date::choose::earliest).get_sys_time());
+	}
+});
+DATETIME_BENCHMARK("LocalTimeIndex/Parse/Index", [](std::size_t iterations) {
+	const auto &lines = Lines();
+	const auto &index = Index();
+	for (std::size_t i = 0; i < iterations; ++i) {
+		Local local;
+		detail::FastParse(lines[i % lines.size()], SORTABLE_FORMAT, local);
+		DoNotOptimize(index.ToSys(local, DstPolicy::Earliest));
+	}
+});
+DATETIME_BENCHMARK("LocalTimeIndex/Convert/ToSys", [](std::size_t iterations) {
+	const auto &parsed = Parsed();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(Berlin()->to_sys(parsed[i % parsed.size()], date::choose::earliest));
+});
+DATETIME_BENCHMARK("LocalTimeIndex/Convert/Index", [](std::size_t iterations) {
+	const auto &parsed = Parsed();
+	const auto &index = Index();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(index.ToSys(parsed[i % parsed.size()], DstPolicy::Earliest));
+});
+DATETIME_BENCHMARK("LocalTimeIndex/Convert/Batch", [](std::size_t iterations) {
+	const auto &parsed = Parsed();
+	const auto &index = Index();
+	std::vector<date::sys_seconds> out(parsed.size());
+	for (std::size_t i = 0; i < iterations; i += parsed.size()) {
+		auto count = std::min(parsed.size(), iterations - i);
+		index.ToSys(parsed.begin(), parsed.begin() + static_cast<std::ptrdiff_t>(count), out.begin(), DstPolicy::Earliest);
+		DoNotOptimize(out[count - 1]);
+	}
+});
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+using namespace datetime::bench;
+
+namespace {
+std::atomic<std::size_t> allocations{0};
+std::atomic<std::size_t> liveBytes{0};
+
+/// Every block starts with a header holding its size, so that frees know what they give back.
+constexpr std::size_t HeaderSize = alignof(std::max_align_t);
+
+void *Allocate(std::size_t size, std::size_t align) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	auto header = std::max(HeaderSize, align);
+	auto p = static_cast<char *>(align <= HeaderSize ? std::malloc(header + size) : std::aligned_alloc(align, (header + size + align - 1) / align * align));
+	if (p == nullptr)
+		throw std::bad_alloc();
+	liveBytes.fetch_add(size, std::memory_order_relaxed);
+	p += header;
+	std::memcpy(p - sizeof(std::size_t), &size, sizeof(std::size_t));
+	return p;
+}
+
+void Free(void *p, std::size_t align) {
+	if (p == nullptr)
+		return;
+	std::size_t size;
+	std::memcpy(&size, static_cast<char *>(p) - sizeof(std::size_t), sizeof(std::size_t));
+	liveBytes.fetch_sub(size, std::memory_order_relaxed);
+	std::free(static_cast<char *>(p) - std::max(HeaderSize, align));
+}
+}
+
+std::size_t datetime::bench::Allocations() { return allocations.load(std::memory_order_relaxed); }
+std::size_t datetime::bench::LiveBytes() { return liveBytes.load(std::memory_order_relaxed); }
+
+void *operator new(std::size_t size) { return Allocate(size, HeaderSize); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return Allocate(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void *p) noexcept { Free(p, HeaderSize); }
+void operator delete(void *p, std::size_t) noexcept { Free(p, HeaderSize); }
+void operator delete(void *p, std::align_val_t alignment) noexcept { Free(p, static_cast<std::size_t>(alignment)); }
+void operator delete(void *p, std::size_t, std::align_val_t alignment) noexcept { Free(p, static_cast<std::size_t>(alignment)); }
+
+namespace {
+/// Timed runs of a benchmark, ns/op is their mean.
+constexpr std::size_t RunCount = 20;
+/// The percentiles are taken over batches of operations that take about this long, far
+/// longer than reading the clock, and long enough for a batch of fast operations to go
+/// through the fixtures the benchmarks cycle through.
+constexpr std::chrono::nanoseconds BatchTime = std::chrono::microseconds(100);
+/// Bounds on the batches timed per thread.
+constexpr std::size_t MinBatches = 200, MaxBatches = 20000;
+
+struct Result {
+	std::string name;
+	unsigned threads;
+	std::size_t iterations;
+	double nsPerOp;
+	double p50;
+	double p99;
+	double allocsPerOp;
+	std::vector<std::pair<std::string, double>> counters;
+};
+
+/// Calls body with the index of each of threads threads, all started at once, and returns
+/// the wall time until the last one finishes. One thread runs on the calling thread.
+template<class Body>
+std::chrono::nanoseconds OnThreads(unsigned threads, const Body &body) {
+	if (threads <= 1) {
+		auto start = std::chrono::steady_clock::now();
+		body(0u);
+		return std::chrono::steady_clock::now() - start;
+	}
+	std::atomic<unsigned> ready{0};
+	std::atomic<bool> go{false};
+	std::vector<std::thread> workers;
+	for (unsigned t = 0; t < threads; ++t) {
+		workers.emplace_back([&, t] {
+			++ready;
+			while (!go.load(std::memory_order_acquire))
+				std::this_thread::yield();
+			body(t);
+		});
+	}
+	while (ready != threads)
+		std::this_thread::yield();
+	auto start = std::chrono::steady_clock::now();
+	go.store(true, std::memory_order_release);
+	for (auto &worker : workers)
+		worker.join();
+	return std::chrono::steady_clock::now() - start;
+}
+
+/// Runs benchmark once with iterations operations per thread, returning the wall time.
+std::chrono::nanoseconds Time(const Benchmark &benchmark, std::size_t iterations) {
+	return OnThreads(benchmark.threads, [&](unsigned) { benchmark.run(iterations); });
+}
+
+/// The ns/op of count batches of batch operations, timed on each thread by itself.
+std::vector<double> Batches(const Benchmark &benchmark, std::size_t batch, std::size_t count) {
+	std::vector<std::vector<double>> perThread(std::max(1u, benchmark.threads));
+	for (auto &samples : perThread)
+		samples.reserve(count);
+	OnThreads(benchmark.threads, [&](unsigned t) {
+		auto &samples = perThread[t];
+		for (std::size_t i = 0; i < count; ++i) {
+			auto start = std::chrono::steady_clock::now();
+			benchmark.run(batch);
+			std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+			samples.push_back(static_cast<double>(elapsed.count()) / static_cast<double>(batch));
+		}
+	});
+	std::vector<double> samples;
+	for (const auto &thread : perThread)
+		samples.insert(samples.end(), thread.begin(), thread.end());
+	return samples;
+}
+
+/// Doubles the iteration count until a run takes a share of minimumTime, then times
+/// RunCount runs of that many iterations for the mean and allocations. The percentiles
+/// come from another minimumTime spent in batches of about BatchTime, so a p99 is one of
+/// at least MinBatches samples per thread rather than the slowest of a few runs. An untimed
+/// first run lets benchmarks build large fixtures lazily.
+Result Measure(const Benchmark &benchmark, std::chrono::nanoseconds minimumTime) {
+	Counters().clear();
+	benchmark.run(1);
+	std::size_t iterations = 1;
+	while (Time(benchmark, iterations) < minimumTime / RunCount && iterations < (std::size_t(1) << 40))
+		iterations *= 2;
+
+	std::chrono::nanoseconds total{};
+	auto allocations = Allocations();
+	for (std::size_t i = 0; i < RunCount; ++i)
+		total += Time(benchmark, iterations);
+	auto operations = static_cast<double>(iterations * RunCount);
+	auto allocsPerOp = static_cast<double>(Allocations() - allocations) / (operations * benchmark.threads);
+	auto nsPerOp = static_cast<double>(total.count()) / operations;
+
+	auto batch = std::max<std::size_t>(1, static_cast<std::size_t>(static_cast<double>(BatchTime.count()) / nsPerOp));
+	auto count = std::clamp<std::size_t>(static_cast<std::size_t>(static_cast<double>(minimumTime.count()) / (nsPerOp * batch)), MinBatches, MaxBatches);
+	auto samples = Batches(benchmark, batch, count);
+	std::sort(samples.begin(), samples.end());
+	auto percentile = [&](double p) { return samples[static_cast<std::size_t>(std::ceil(p * samples.size())) - 1]; };
+	return {benchmark.name, benchmark.threads, iterations * RunCount, nsPerOp, percentile(0.5), percentile(0.99), allocsPerOp, Counters()};
+}
+
+std::string JsonString(const std::string &text) {
+	std::string quoted = "\"";
+	for (auto c : text) {
+		if (c == '"' || c == '\\')
+			quoted += '\\';
+		quoted += c;
+	}
+	return quoted + '"';
+}
+
+void PrintConsoleHeader() {
+	std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(12) << "ns/op" << std::setw(12) << "p50" << std::setw(12) << "p99"
+		<< std::setw(12) << "allocs/op" << std::setw(14) << "iterations" << std::endl;
+}
+
+void PrintConsole(const Result &result) {
+	std::cout << std::left << std::setw(48) << result.name << std::right << std::fixed << std::setprecision(2) << std::setw(12) << result.nsPerOp
+		<< std::setw(12) << result.p50 << std::setw(12) << result.p99 << std::setw(12) << result.allocsPerOp << std::setw(14) << result.iterations;
+	for (const auto &counter : result.counters)
+		std::cout << "  " << counter.first << '=' << std::setprecision(3) << counter.second;
+	std::cout << std::endl;
+}
+
+void PrintCsvHeader() {
+	std::cout << "name,threads,iterations,ns_per_op,p50_ns,p99_ns,allocs_per_op,counters" << std::endl;
+}
+
+void PrintCsv(const Result &result) {
+	std::cout << result.name << ',' << result.threads << ',' << result.iterations << ',' << std::setprecision(6) << result.nsPerOp << ','
+		<< result.p50 << ',' << result.p99 << ',' << result.allocsPerOp << ',';
+	for (std::size_t i = 0; i < result.counters.size(); ++i)
+		std::cout << (i ? ";" : "") << result.counters[i].first << '=' << result.counters[i].second;
+	std::cout << std::endl;
+}
+
+void PrintJson(const Result &result, bool first) {
+	std::cout << (first ? "\n" : ",\n") << "    {\"name\": " << JsonString(result.name) << ", \"threads\": " << result.threads
+		<< ", \"iterations\": " << result.iterations << std::setprecision(6) << ", \"ns_per_op\": " << result.nsPerOp
+		<< ", \"p50_ns\": " << result.p50 << ", \"p99_ns\": " << result.p99 << ", \"allocs_per_op\": " << result.allocsPerOp << ", \"counters\": {";
+	for (std::size_t i = 0; i < result.counters.size(); ++i)
+		std::cout << (i ? ", " : "") << JsonString(result.counters[i].first) << ": " << result.counters[i].second;
+	std::cout << "}}" << std::flush;
+}
+}
+
+/// Runs every registered benchmark whose name contains the filter, in name order, and prints
+/// the mean ns/op, the median and 99th percentile ns/op of batches of operations and the heap
+/// allocations per operation. With several threads ns/op is the wall time over the operations
+/// of one thread, so it stays flat for as long as a benchmark scales, and each thread times
+/// its own batches.
+///
+///   DateTimeCPP_bench [filter] [--format=console|csv|json] [--min-time=milliseconds]
+///
+/// Benchmarks that reload the tz database, under ZoneDatabase/, sort last so that the zones
+/// other benchmarks keep in fixtures stay valid.
+int main(int argc, char **argv) {
+	std::string filter;
+	std::string format = "console";
+	std::chrono::nanoseconds minimumTime = std::chrono::milliseconds(200);
+	for (int i = 1; i < argc; ++i) {
+		if (std::strncmp(argv[i], "--format=", 9) == 0)
+			format = argv[i] + 9;
+		else if (std::strncmp(argv[i], "--min-time=", 11) == 0)
+			minimumTime = std::chrono::milliseconds(std::atoi(argv[i] + 11));
+		else
+			filter = argv[i];
+	}
+	if (format != "console" && format != "csv" && format != "json") {
+		std::cerr << "unknown format " << format << ", expected console, csv or json" << std::endl;
+		return 1;
+	}
+
+	auto benchmarks = Registry();
+	std::stable_sort(benchmarks.begin(), benchmarks.end(), [](const Benchmark &x, const Benchmark &y) { return x.name < y.name; });
+
+	if (format == "console")
+		PrintConsoleHeader();
+	else if (format == "csv")
+		PrintCsvHeader();
+	else
+		std::cout << "{\n  \"benchmarks\": [";
+	bool first = true;
+	for (const auto &benchmark : benchmarks) {
+		if (benchmark.name.find(filter) == std::string::npos)
+			continue;
+		auto result = Measure(benchmark, minimumTime);
+		if (format == "console")
+			PrintConsole(result);
+		else if (format == "csv")
+			PrintCsv(result);
+		else
+			PrintJson(result, first);
+		first = false;
+	}
+	if (format == "json")
+		std::cout << "\n  ]\n}" << std::endl;
+	return 0;
+}
@@ -0,0 +1,83 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+using Value = DateTime<std::chrono::seconds>;
+
+const std::pair<const char *, std::string_view> formats[] = {
+	{"ISO8601", ISO8601_FORMAT}, {"ISO8601_FRAC", ISO8601_FRAC_FORMAT}, {"RFC822", RFC822_FORMAT}, {"RFC1123", RFC1123_FORMAT},
+	{"HTTP", HTTP_FORMAT}, {"RFC850", RFC850_FORMAT}, {"RFC1036", RFC1036_FORMAT}, {"ASCTIME", ASCTIME_FORMAT}, {"SORTABLE", SORTABLE_FORMAT},
+};
+
+/// Texts of format for instants between 10:00 and 20:00 UTC, which no DST change of the
+/// current zone can make nonexistent when parsed back as local times.
+std::vector<std::string> Texts(std::string_view format) {
+	std::vector<std::string> texts;
+	std::mt19937_64 random(31);
+	auto utc = date::locate_zone("UTC");
+	for (int i = 0; i < 1024; ++i) {
+		auto day = date::sys_days(date::year(2000) / 1 / 1) + date::days(random() % 10000);
+		Value dt(date::make_zoned(utc, date::sys_seconds(day) + std::chrono::seconds(36000 + random() % 36000)));
+		texts.push_back(dt.Format(format));
+	}
+	return texts;
+}
+
+void Parse(std::size_t iterations, const std::vector<std::string> &texts, const std::string &format) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(Value::Parse(texts[i % texts.size()], format));
+}
+
+/// Also reports the share of texts that parse back, formats date::parse cannot read fail fast.
+void TryParse(std::size_t iterations, const std::vector<std::string> &texts, const std::string &format) {
+	std::size_t parsed = 0;
+	Value dt;
+	for (std::size_t i = 0; i < iterations; ++i)
+		parsed += Value::TryParse(texts[i % texts.size()], format, dt);
+	DoNotOptimize(dt);
+	SetCounter("parsed", static_cast<double>(parsed) / static_cast<double>(iterations));
+}
+
+const bool registered = [] {
+	for (const auto &format : formats) {
+		auto texts = std::make_shared<std::vector<std::string>>();
+		std::string pattern(format.second);
+		// Texts are made on first use, locating zones while registering would load the tzdb.
+		auto fixture = [texts, pattern]() -> const std::vector<std::string> & {
+			if (texts->empty())
+				*texts = Texts(pattern);
+			return *texts;
+		};
+		Register(std::string("Parse/") + format.first, [fixture, pattern](std::size_t iterations) {
+			Parse(iterations, fixture(), pattern);
+		});
+		Register(std::string("TryParse/") + format.first, [fixture, pattern](std::size_t iterations) {
+			TryParse(iterations, fixture(), pattern);
+		});
+	}
+	return true;
+}();
+}
+
+/// Offset bearing text into a FixedOffsetZone, without a zone of the tz database.
+DATETIME_BENCHMARK("ParseOffset/ISO8601", [](std::size_t iterations) {
+	static const auto texts = [] {
+		std::vector<std::string> texts;
+		const char *offsets[] = {"+0530", "-0800", "Z", "+01"};
+		for (int i = 0; i < 1024; ++i)
+			texts.push_back("20" + std::to_string(10 + i % 20) + "-0" + std::to_string(1 + i % 9) + "-1" + std::to_string(i % 10) + "T12:34:56" + offsets[i % 4]);
+		return texts;
+	}();
+	std::string format(ISO8601_FORMAT);
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(Value::ParseOffset(texts[i % texts.size()], format));
+});
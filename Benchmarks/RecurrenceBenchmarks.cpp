@@ -0,0 +1,40 @@
+#include "RecurrenceRule.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+using Seconds = DateTime<std::chrono::seconds>;
+
+Seconds Local(int y, unsigned m, unsigned d) {
+	return {date::make_zoned("Europe/Berlin", date::local_days(date::year(y) / m / d) + std::chrono::hours(9))};
+}
+
+/// Queries one week, 50 years after DTSTART, directly or by expanding from DTSTART.
+void FarWindow(std::size_t iterations, const char *text, bool fromStart) {
+	auto rule = RecurrenceRule::Parse(text);
+	auto dtstart = Local(2000, 1, 3);
+	auto from = Local(2050, 6, 1), to = Local(2050, 6, 8);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		std::size_t count = 0;
+		for (const auto &occurrence : rule.Between(dtstart, fromStart ? dtstart : from, to)) {
+			if (!fromStart || occurrence >= from)
+				++count;
+		}
+		DoNotOptimize(count);
+	}
+}
+}
+
+DATETIME_BENCHMARK("RRule/Parse", [](std::size_t iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(RecurrenceRule::Parse("FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-1;UNTIL=20301231T000000Z"));
+});
+DATETIME_BENCHMARK("RRule/Daily/FarWindow", [](std::size_t iterations) { FarWindow(iterations, "FREQ=DAILY", false); });
+DATETIME_BENCHMARK("RRule/Daily/FarWindow/ExpandFromStart", [](std::size_t iterations) { FarWindow(iterations, "FREQ=DAILY", true); });
+DATETIME_BENCHMARK("RRule/DailyCount/FarWindow", [](std::size_t iterations) { FarWindow(iterations, "FREQ=DAILY;COUNT=100000", false); });
+DATETIME_BENCHMARK("RRule/Weekly/FarWindow", [](std::size_t iterations) { FarWindow(iterations, "FREQ=WEEKLY;INTERVAL=2;BYDAY=MO,WE,FR", false); });
+DATETIME_BENCHMARK("RRule/Weekly/FarWindow/ExpandFromStart", [](std::size_t iterations) { FarWindow(iterations, "FREQ=WEEKLY;INTERVAL=2;BYDAY=MO,WE,FR", true); });
+DATETIME_BENCHMARK("RRule/WeeklyCount/FarWindow", [](std::size_t iterations) { FarWindow(iterations, "FREQ=WEEKLY;BYDAY=TU,TH;COUNT=10000", false); });
+DATETIME_BENCHMARK("RRule/MonthlyLastWeekday/FarWindow", [](std::size_t iterations) { FarWindow(iterations, "FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-1", false); });
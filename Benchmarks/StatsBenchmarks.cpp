@@ -0,0 +1,33 @@
+#include <random>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+// Instrumentation costs nothing when it is off: compare the other benchmarks of a build with
+// DATETIMECPP_STATS against one without.
+
+DATETIME_BENCHMARK("Stats/Snapshot", [](std::size_t iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(Stats());
+});
+
+/// Offset lookups with the lookups counted per operation, 1 when instrumentation is on.
+DATETIME_BENCHMARK("Stats/GetInfoView", [](std::size_t iterations) {
+	static const auto instants = [] {
+		std::vector<date::sys_seconds> instants(1024);
+		std::mt19937_64 random(47);
+		for (auto &t : instants)
+			t = date::sys_seconds(std::chrono::seconds(1700000000 + random() % 100000000));
+		return instants;
+	}();
+	auto zone = date::locate_zone("Europe/Berlin");
+	auto before = Stats();
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(zone->get_info_view(instants[i % instants.size()]));
+	auto counted = Stats() - before;
+	SetCounter("counted/op", static_cast<double>(counted.sysInfoCalls) / static_cast<double>(iterations));
+});
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "TimeBuckets.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+using Milliseconds = date::sys_time<std::chrono::milliseconds>;
+
+/// A sorted column of event times spread over ten years.
+const std::vector<Milliseconds> &Column() {
+	static const auto column = [] {
+		std::vector<Milliseconds> column(1 << 16);
+		std::mt19937_64 random(7);
+		auto base = Milliseconds(date::sys_days(date::year(2015) / 1 / 1));
+		for (auto &t : column)
+			t = base + std::chrono::milliseconds(random() % (std::uint64_t(10) * 365 * 86400000));
+		std::sort(column.begin(), column.end());
+		return column;
+	}();
+	return column;
+}
+
+void Bucket(std::size_t iterations, const TimeBuckets &buckets) {
+	const auto &column = Column();
+	std::vector<std::int64_t> indices(column.size());
+	for (std::size_t i = 0; i < iterations; i += column.size()) {
+		buckets.BucketIndex(column.begin(), column.end(), indices.begin());
+		DoNotOptimize(indices.back());
+	}
+}
+
+/// Builds a DateTime per event and reconstructs local midnight, the approach TimeBuckets replaces.
+void PerEventDateTime(std::size_t iterations) {
+	const auto &column = Column();
+	auto zone = date::locate_zone("Europe/Berlin");
+	for (std::size_t i = 0; i < iterations; ++i) {
+		DateTime<std::chrono::milliseconds> dt{date::make_zoned(zone, column[i % column.size()])};
+		auto day = dt.Date();
+		auto start = date::make_zoned(zone, date::local_days(day.YearMonthDay()), date::choose::earliest);
+		DoNotOptimize(start);
+	}
+}
+}
+
+DATETIME_BENCHMARK("TimeBuckets/PerEventDateTime/Day", PerEventDateTime);
+DATETIME_BENCHMARK("TimeBuckets/Direct/Day", [](std::size_t iterations) {
+	Bucket(iterations, TimeBuckets(CalendarUnit::Day, date::locate_zone("Europe/Berlin")));
+});
+DATETIME_BENCHMARK("TimeBuckets/Table/Day", [](std::size_t iterations) {
+	static const auto buckets = TimeBuckets(CalendarUnit::Day, date::locate_zone("Europe/Berlin")).Precompute(date::year(2015), date::year(2024));
+	Bucket(iterations, buckets);
+});
+DATETIME_BENCHMARK("TimeBuckets/Table/Month", [](std::size_t iterations) {
+	static const auto buckets = TimeBuckets(CalendarUnit::Month, date::locate_zone("Europe/Berlin")).Precompute(date::year(2015), date::year(2024));
+	Bucket(iterations, buckets);
+});
+DATETIME_BENCHMARK("TimeBuckets/Table/15min", [](std::size_t iterations) {
+	static const auto buckets = TimeBuckets(std::chrono::minutes(15), date::locate_zone("Europe/Berlin")).Precompute(date::year(2015), date::year(2024));
+	Bucket(iterations, buckets);
+});
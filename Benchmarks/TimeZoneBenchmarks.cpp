@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+const char *zoneNames[] = {"Europe/Berlin", "America/New_York", "Australia/Sydney", "America/Sao_Paulo"};
+
+/// Random instants of the years [first, last). Backends are compared by building with and
+/// without DATETIMECPP_USE_OS_TZDB, the text database answers the years of its transition
+/// table window from the table and other years from its rule engine.
+std::vector<date::sys_seconds> Instants(int first, int last) {
+	std::vector<date::sys_seconds> instants(1 << 12);
+	std::mt19937_64 random(17);
+	auto begin = date::sys_seconds(date::sys_days(date::year(first) / 1 / 1));
+	auto span = static_cast<std::uint64_t>((date::sys_days(date::year(last) / 1 / 1) - date::sys_days(date::year(first) / 1 / 1)) / std::chrono::seconds(1));
+	for (auto &t : instants)
+		t = begin + std::chrono::seconds(random() % span);
+	return instants;
+}
+
+void SysInfo(std::size_t iterations, const std::vector<date::sys_seconds> &instants) {
+	const date::time_zone *zones[4];
+	for (int z = 0; z < 4; ++z)
+		zones[z] = date::locate_zone(zoneNames[z]);
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(zones[i % 4]->get_info(instants[i % instants.size()]));
+}
+
+/// Offsets in a zone with a long history of transitions, for searches that land anywhere in
+/// it or, sorted, next to the previous one.
+void NewYork(std::size_t iterations, const std::vector<date::sys_seconds> &instants) {
+	auto zone = date::locate_zone("America/New_York");
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(zone->get_info_view(instants[i % instants.size()]));
+}
+
+void LocalInfo(std::size_t iterations, const std::vector<date::sys_seconds> &instants) {
+	const date::time_zone *zones[4];
+	for (int z = 0; z < 4; ++z)
+		zones[z] = date::locate_zone(zoneNames[z]);
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(zones[i % 4]->get_info(date::local_seconds(instants[i % instants.size()].time_since_epoch())));
+}
+}
+
+DATETIME_BENCHMARK("TimeZone/SysInfo/1970-2100", [](std::size_t iterations) {
+	static const auto instants = Instants(1970, 2100);
+	SysInfo(iterations, instants);
+});
+DATETIME_BENCHMARK("TimeZone/SysInfo/2200-2300", [](std::size_t iterations) {
+	static const auto instants = Instants(2200, 2300);
+	SysInfo(iterations, instants);
+});
+DATETIME_BENCHMARK("TimeZone/LocalInfo/1970-2100", [](std::size_t iterations) {
+	static const auto instants = Instants(1970, 2100);
+	LocalInfo(iterations, instants);
+});
+DATETIME_BENCHMARK("TimeZone/LocalInfo/2200-2300", [](std::size_t iterations) {
+	static const auto instants = Instants(2200, 2300);
+	LocalInfo(iterations, instants);
+});
+DATETIME_BENCHMARK("TimeZone/NewYork/Random", [](std::size_t iterations) {
+	static const auto instants = Instants(1883, 2037);
+	NewYork(iterations, instants);
+});
+DATETIME_BENCHMARK("TimeZone/NewYork/Sorted", [](std::size_t iterations) {
+	static const auto instants = [] {
+		auto instants = Instants(1883, 2037);
+		std::sort(instants.begin(), instants.end());
+		return instants;
+	}();
+	NewYork(iterations, instants);
+});
+// A year past the transitions of zoneinfo files, which the OS database answers from the
+// rule at the end of each file.
+DATETIME_BENCHMARK("TimeZone/SysInfo/2040", [](std::size_t iterations) {
+	static const auto instants = Instants(2040, 2041);
+	SysInfo(iterations, instants);
+});
+// The same lookups on several threads at once, named apart from the single threaded one so
+// that a filter selects either.
+DATETIME_BENCHMARK("TimeZone/ConcurrentSysInfo/1970-2100", {1, 2, 4, 8}, [](std::size_t iterations) {
+	static const auto instants = Instants(1970, 2100);
+	SysInfo(iterations, instants);
+});
+DATETIME_BENCHMARK("TimeZone/LocateZone", {1, 2, 4, 8}, [](std::size_t iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(date::locate_zone(zoneNames[i % 4]));
+});
+DATETIME_BENCHMARK("DateTime/Now", [](std::size_t iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(DateTime<>::Now());
+});
+DATETIME_BENCHMARK("DateTime/Now/Zone", [](std::size_t iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(DateTime<>::Now(zoneNames[i % 4]));
+});
+DATETIME_BENCHMARK("DateTime/UtcNow", [](std::size_t iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(DateTime<>::UtcNow());
+});
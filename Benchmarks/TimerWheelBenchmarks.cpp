@@ -0,0 +1,131 @@
+#include <memory>
+#include <queue>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "TimerWheel.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+using Microseconds = date::sys_time<std::chrono::microseconds>;
+
+constexpr auto Horizon = std::chrono::microseconds(std::chrono::hours(1));
+
+/// The priority_queue based scheduler the wheel replaces, cancelled timers are skipped lazily.
+class HeapBaseline {
+public:
+	std::uint32_t Schedule(Microseconds deadline) {
+		auto id = static_cast<std::uint32_t>(_cancelled.size());
+		_cancelled.push_back(false);
+		_queue.push({deadline, id});
+		return id;
+	}
+
+	void Cancel(std::uint32_t id) { _cancelled[id] = true; }
+
+	template<class Function>
+	void Advance(Microseconds now, Function &&onExpired) {
+		while (!_queue.empty() && _queue.top().first <= now) {
+			auto id = _queue.top().second;
+			_queue.pop();
+			if (!_cancelled[id])
+				onExpired(id);
+		}
+	}
+
+private:
+	using Entry = std::pair<Microseconds, std::uint32_t>;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> _queue;
+	std::vector<bool> _cancelled;
+};
+
+/// A scheduler holding deadlines uniformly spread over the next hour, kept alive
+/// between runs so only the first one pays for filling it.
+template<class Scheduler>
+struct Population {
+	Population(Scheduler scheduler, std::size_t timers) :
+		scheduler(std::move(scheduler)), now(date::sys_days(date::year(2024) / 1 / 1)), step(Horizon / timers) {
+		for (std::size_t i = 0; i < timers; ++i)
+			this->scheduler.Schedule(Deadline(), 0);
+	}
+
+	Microseconds Deadline() { return now + std::chrono::microseconds(random() % Horizon.count()); }
+
+	Scheduler scheduler;
+	Microseconds now;
+	std::chrono::microseconds step;
+	std::mt19937_64 random{42};
+};
+
+struct WheelScheduler {
+	TimerWheel<std::uint32_t> wheel;
+	TimerWheel<std::uint32_t>::TimerId Schedule(Microseconds deadline, std::uint32_t value) { return wheel.Schedule(deadline, value); }
+};
+
+struct HeapScheduler {
+	HeapBaseline heap;
+	std::uint32_t Schedule(Microseconds deadline, std::uint32_t) { return heap.Schedule(deadline); }
+};
+
+Population<WheelScheduler> &Wheel(std::size_t timers) {
+	static std::unique_ptr<Population<WheelScheduler>> population;
+	static std::size_t size = 0;
+	if (!population || size != timers) {
+		population.reset();
+		population = std::make_unique<Population<WheelScheduler>>(
+			WheelScheduler{TimerWheel<std::uint32_t>(Microseconds(date::sys_days(date::year(2024) / 1 / 1)))}, timers);
+		size = timers;
+	}
+	return *population;
+}
+
+Population<HeapScheduler> &Heap(std::size_t timers) {
+	static std::unique_ptr<Population<HeapScheduler>> population;
+	static std::size_t size = 0;
+	if (!population || size != timers) {
+		population.reset();
+		population = std::make_unique<Population<HeapScheduler>>(HeapScheduler{}, timers);
+		size = timers;
+	}
+	return *population;
+}
+
+/// Steady state churn, every operation schedules one timer and advances far enough to
+/// expire one on average.
+template<class Scheduler>
+void Churn(std::size_t iterations, Population<Scheduler> &population) {
+	std::size_t expired = 0;
+	for (std::size_t i = 0; i < iterations; ++i) {
+		population.scheduler.Schedule(population.Deadline(), 1);
+		population.now += population.step;
+		if constexpr (std::is_same_v<Scheduler, WheelScheduler>)
+			population.scheduler.wheel.Advance(population.now, [&](std::uint32_t) { ++expired; });
+		else
+			population.scheduler.heap.Advance(population.now, [&](std::uint32_t) { ++expired; });
+	}
+	DoNotOptimize(expired);
+}
+
+/// Schedules a timer and cancels it again, the session that ends before its timeout.
+template<class Scheduler>
+void ScheduleCancel(std::size_t iterations, Population<Scheduler> &population) {
+	for (std::size_t i = 0; i < iterations; ++i) {
+		auto id = population.scheduler.Schedule(population.Deadline(), 1);
+		if constexpr (std::is_same_v<Scheduler, WheelScheduler>)
+			population.scheduler.wheel.Cancel(id);
+		else
+			population.scheduler.heap.Cancel(id);
+	}
+}
+}
+
+DATETIME_BENCHMARK("TimerWheel/Churn/1M", [](std::size_t iterations) { Churn(iterations, Wheel(1000000)); });
+DATETIME_BENCHMARK("TimerWheel/HeapBaseline/Churn/1M", [](std::size_t iterations) { Churn(iterations, Heap(1000000)); });
+DATETIME_BENCHMARK("TimerWheel/ScheduleCancel/1M", [](std::size_t iterations) { ScheduleCancel(iterations, Wheel(1000000)); });
+DATETIME_BENCHMARK("TimerWheel/HeapBaseline/ScheduleCancel/1M", [](std::size_t iterations) { ScheduleCancel(iterations, Heap(1000000)); });
+DATETIME_BENCHMARK("TimerWheel/Churn/10M", [](std::size_t iterations) { Churn(iterations, Wheel(10000000)); });
+DATETIME_BENCHMARK("TimerWheel/HeapBaseline/Churn/10M", [](std::size_t iterations) { Churn(iterations, Heap(10000000)); });
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "TimestampCodec.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+using Instant = date::sys_time<std::chrono::system_clock::duration>;
+
+constexpr std::size_t ColumnSize = 1 << 20;
+
+/// A reading every ten seconds, exactly on schedule.
+const std::vector<Instant> &Regular() {
+	static const auto column = [] {
+		std::vector<Instant> column(ColumnSize);
+		auto t = Instant(date::sys_days(date::year(2024) / 1 / 1));
+		for (auto &value : column)
+			value = t += std::chrono::seconds(10);
+		return column;
+	}();
+	return column;
+}
+
+/// A reading every ten seconds give or take a few milliseconds, with the occasional outage.
+const std::vector<Instant> &Jittered() {
+	static const auto column = [] {
+		std::vector<Instant> column(ColumnSize);
+		std::mt19937_64 random(11);
+		auto t = Instant(date::sys_days(date::year(2024) / 1 / 1));
+		for (auto &value : column) {
+			t += std::chrono::seconds(10) + std::chrono::milliseconds(static_cast<int>(random() % 9) - 4);
+			if (random() % 1000 == 0)
+				t += std::chrono::minutes(random() % 600);
+			value = t;
+		}
+		return column;
+	}();
+	return column;
+}
+
+void Encode(std::size_t iterations, const std::vector<Instant> &column) {
+	TimestampEncoder<> encoder;
+	std::size_t bytes = 0, values = 0;
+	for (std::size_t i = 0; i < iterations; i += column.size()) {
+		auto count = std::min(column.size(), iterations - i);
+		encoder.Append(column.begin(), column.begin() + static_cast<std::ptrdiff_t>(count));
+		auto compressed = encoder.Finish();
+		bytes += compressed.Bytes();
+		values += compressed.Size();
+	}
+	SetCounter("bytes/value", static_cast<double>(bytes) / static_cast<double>(values));
+	SetCounter("ratio", static_cast<double>(values * sizeof(DateTime<>)) / static_cast<double>(bytes));
+}
+
+void Decode(std::size_t iterations, const std::vector<Instant> &column) {
+	static const std::vector<Instant> *encoded = nullptr;
+	static CompressedTimestamps<> compressed;
+	if (encoded != &column) {
+		TimestampEncoder<> encoder;
+		encoder.Append(column.begin(), column.end());
+		compressed = encoder.Finish();
+		encoded = &column;
+	}
+	std::vector<Instant> out(column.size());
+	for (std::size_t i = 0; i < iterations; i += column.size()) {
+		compressed.Decode(0, std::min(column.size(), iterations - i), out.data());
+		DoNotOptimize(out.back());
+	}
+	SetCounter("bytes/value", static_cast<double>(compressed.Bytes()) / static_cast<double>(compressed.Size()));
+}
+
+/// Decodes a thousand values from a random position, the cost of seeking included.
+void DecodeRange(std::size_t iterations, const std::vector<Instant> &column) {
+	static const auto compressed = [&] {
+		TimestampEncoder<> encoder;
+		encoder.Append(column.begin(), column.end());
+		return encoder.Finish();
+	}();
+	std::mt19937_64 random(3);
+	Instant out[1000];
+	for (std::size_t i = 0; i < iterations; i += 1000) {
+		compressed.Decode(random() % (column.size() - 1000), 1000, out);
+		DoNotOptimize(out[999]);
+	}
+}
+}
+
+DATETIME_BENCHMARK("TimestampCodec/Encode/Regular", [](std::size_t iterations) { Encode(iterations, Regular()); });
+DATETIME_BENCHMARK("TimestampCodec/Encode/Jittered", [](std::size_t iterations) { Encode(iterations, Jittered()); });
+DATETIME_BENCHMARK("TimestampCodec/Decode/Regular", [](std::size_t iterations) { Decode(iterations, Regular()); });
+DATETIME_BENCHMARK("TimestampCodec/Decode/Jittered", [](std::size_t iterations) { Decode(iterations, Jittered()); });
+DATETIME_BENCHMARK("TimestampCodec/DecodeRange/Regular", [](std::size_t iterations) { DecodeRange(iterations, Regular()); });
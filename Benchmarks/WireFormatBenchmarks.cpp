@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "WireFormat.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+using Microseconds = std::chrono::microseconds;
+
+/// Event times in a handful of zones, the shape of a typical message batch.
+const std::vector<DateTime<Microseconds>> &Batch() {
+	static const auto batch = [] {
+		const char *zones[] = {"Europe/Berlin", "America/New_York", "Asia/Tokyo", "Etc/UTC"};
+		std::vector<DateTime<Microseconds>> batch;
+		std::mt19937_64 random(5);
+		auto base = date::sys_time<Microseconds>(date::sys_days(date::year(2024) / 1 / 1));
+		for (std::size_t i = 0; i < 1024; ++i) {
+			auto t = base + Microseconds(random() % (std::uint64_t(365) * 86400000000));
+			batch.emplace_back(date::make_zoned(zones[random() % 4], t));
+		}
+		return batch;
+	}();
+	return batch;
+}
+
+/// Formats every value as ISO 8601 with fractional seconds and parses it back, the round
+/// trip the wire format replaces.
+void StringRoundTrip(std::size_t iterations) {
+	const auto &batch = Batch();
+	std::size_t bytes = 0;
+	for (std::size_t i = 0; i < iterations; ++i) {
+		auto text = batch[i % batch.size()].Format(ISO8601_FRAC_FORMAT);
+		bytes += text.size();
+		DoNotOptimize(DateTime<Microseconds>::Parse(text, std::string(ISO8601_FRAC_FORMAT)));
+	}
+	SetCounter("bytes/value", static_cast<double>(bytes) / static_cast<double>(iterations));
+}
+
+/// Writes the batch into one buffer and reads it back, per value.
+void WireRoundTrip(std::size_t iterations) {
+	const auto &batch = Batch();
+	static std::uint8_t buffer[1024 * 32];
+	std::vector<DateTime<Microseconds>> out(batch.size());
+	std::size_t bytes = 0;
+	for (std::size_t i = 0; i < iterations; i += batch.size()) {
+		auto count = std::min(batch.size(), iterations - i);
+		WireWriter writer(buffer, sizeof(buffer));
+		writer.Write(batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(count));
+		WireReader reader(buffer, writer.Size());
+		reader.Read(out.begin(), count);
+		DoNotOptimize(out[count - 1]);
+		bytes += writer.Size();
+	}
+	SetCounter("bytes/value", static_cast<double>(bytes) / static_cast<double>(iterations));
+}
+
+void WireWrite(std::size_t iterations) {
+	const auto &batch = Batch();
+	static std::uint8_t buffer[1024 * 32];
+	for (std::size_t i = 0; i < iterations; i += batch.size()) {
+		WireWriter writer(buffer, sizeof(buffer));
+		writer.Write(batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(std::min(batch.size(), iterations - i)));
+		DoNotOptimize(buffer[0]);
+	}
+}
+
+void WireDates(std::size_t iterations) {
+	static const auto dates = [] {
+		std::vector<Date> dates;
+		for (const auto &dt : Batch())
+			dates.push_back(dt.Date());
+		return dates;
+	}();
+	static std::uint8_t buffer[1024 * 8];
+	std::vector<Date> out(dates.size());
+	for (std::size_t i = 0; i < iterations; i += dates.size()) {
+		auto count = std::min(dates.size(), iterations - i);
+		WireWriter writer(buffer, sizeof(buffer));
+		writer.Write(dates.begin(), dates.begin() + static_cast<std::ptrdiff_t>(count));
+		WireReader reader(buffer, writer.Size());
+		reader.Read(out.begin(), count);
+		DoNotOptimize(out[count - 1]);
+	}
+}
+}
+
+DATETIME_BENCHMARK("WireFormat/StringRoundTrip/DateTime", StringRoundTrip);
+DATETIME_BENCHMARK("WireFormat/RoundTrip/DateTime", WireRoundTrip);
+DATETIME_BENCHMARK("WireFormat/Write/DateTime", WireWrite);
+DATETIME_BENCHMARK("WireFormat/RoundTrip/Date", WireDates);
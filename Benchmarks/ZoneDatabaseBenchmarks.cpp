@@ -0,0 +1,155 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ZoneDatabase.hpp"
+#include "Benchmark.hpp"
+
+using namespace datetime;
+using namespace datetime::bench;
+
+namespace {
+const char *zoneNames[] = {"Europe/Berlin", "America/New_York", "Asia/Tokyo", "Australia/Sydney"};
+
+/// Formats one timestamp in a zone looked up inside its own read section.
+std::size_t FormatOnce(std::size_t i) {
+	auto guard = ZoneDatabase::Instance().Read();
+	DateTime<std::chrono::seconds> dt(date::make_zoned(guard.Locate(zoneNames[i % 4]), date::sys_seconds(std::chrono::seconds(1700000000 + i * 37))));
+	return dt.Format().size();
+}
+
+void ReadSection(std::size_t iterations) {
+	for (std::size_t i = 0; i < iterations; ++i) {
+		auto guard = ZoneDatabase::Instance().Read();
+		DoNotOptimize(guard.Database());
+	}
+}
+
+void Format(std::size_t iterations) {
+	std::size_t length = 0;
+	for (std::size_t i = 0; i < iterations; ++i)
+		length += FormatOnce(i);
+	DoNotOptimize(length);
+}
+
+/// Worker threads format timestamps while this thread reloads the database in a loop, so
+/// every reload frees databases the workers were using moments before. The ZoneDatabase tests
+/// check the output of the same load.
+void FormatDuringReloads(std::size_t iterations, std::size_t threads) {
+	std::atomic<std::size_t> running{threads};
+	std::vector<std::thread> workers;
+	for (std::size_t t = 0; t < threads; ++t) {
+		workers.emplace_back([&, t] {
+			std::size_t length = 0;
+			for (std::size_t i = t; i < iterations; i += threads)
+				length += FormatOnce(i);
+			DoNotOptimize(length);
+			--running;
+		});
+	}
+	std::size_t reloads = 0;
+	while (running != 0) {
+		ZoneDatabase::Instance().Reload();
+		++reloads;
+	}
+	for (auto &worker : workers)
+		worker.join();
+	SetCounter("reloads", static_cast<double>(reloads));
+}
+
+/// Loads the database again and every zone in it, what a process that ends up using all of
+/// them pays, then destroys the previous database. Reports the heap the new database holds
+/// per zone and in all, the allocations loading it made per zone and how long destroying
+/// the previous one took. Build with DATETIMECPP_TZDB_ARENA to compare the arena layout.
+/// Goes around ZoneDatabase, whose Reload would free the previous database itself.
+void LoadAllZones(std::size_t iterations) {
+	auto &list = date::get_tzdb_list();
+	auto instant = date::sys_seconds(std::chrono::seconds(1700000000));
+	for (std::size_t i = 0; i < iterations; ++i) {
+		auto bytes = LiveBytes();
+		auto allocations = Allocations();
+		const auto &database = date::reload_tzdb();
+		for (const auto &zone : database.zones)
+			DoNotOptimize(zone.get_info(instant));
+		auto zones = static_cast<double>(database.zones.size());
+		auto held = static_cast<double>(LiveBytes() - bytes);
+		SetCounter("KiB", held / 1024);
+		SetCounter("bytes/zone", held / zones);
+		SetCounter("allocs/zone", static_cast<double>(Allocations() - allocations) / zones);
+		auto start = std::chrono::steady_clock::now();
+		while (std::next(list.begin()) != list.end())
+			list.erase_after(list.begin());
+		SetCounter("teardown-us", std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+	}
+}
+
+/// Offsets of every zone of the database in turn, so lookups rarely find the zone they
+/// read in the cache.
+void SysInfoAllZones(std::size_t iterations) {
+	auto guard = ZoneDatabase::Instance().Read();
+	const auto &zones = guard.Database().zones;
+	for (std::size_t i = 0; i < iterations; ++i)
+		DoNotOptimize(zones[i % zones.size()].get_info(date::sys_seconds(std::chrono::seconds(1700000000 + (i % 4096) * 7919))));
+}
+
+#if TZ_ZONE_BUDGET
+/// What SysInfoUnderBudget carries from one call to the next, so the runs and batches of a
+/// benchmark go on through the lookups instead of repeating their start.
+struct BudgetRun {
+	std::mt19937_64 random{29};
+	std::size_t lookups = 0;
+	std::uint64_t evictions = 0;
+};
+
+/// Offsets of a few dozen hot zones, with one lookup in a hundred going to any zone of the
+/// database, under a budget of zone memory. Reports what stays resident and how often a lookup
+/// drops the tables of a zone to read those of another, over every lookup of the benchmark.
+/// Build with DATETIMECPP_ZONE_BUDGET.
+void SysInfoUnderBudget(std::size_t iterations, std::size_t budget, BudgetRun &run) {
+	auto guard = ZoneDatabase::Instance().Read();
+	const auto &zones = guard.Database().zones;
+	if (date::get_zone_memory().budget != budget)
+		date::set_zone_memory_budget(budget);
+	auto before = date::get_zone_memory();
+	for (std::size_t i = 0; i < iterations; ++i) {
+		auto r = run.random();
+		auto zone = r % 100 == 0 ? (r >> 8) % zones.size() : (r >> 8) % 32 * 17 % zones.size();
+		DoNotOptimize(zones[zone].get_info(date::sys_seconds(std::chrono::seconds(1700000000 + ((run.lookups + i) % 4096) * 7919))));
+	}
+	auto after = date::get_zone_memory();
+	run.lookups += iterations;
+	run.evictions += after.evictions - before.evictions;
+	SetCounter("resident-KiB", static_cast<double>(after.resident_bytes) / 1024);
+	SetCounter("evictions/1k", static_cast<double>(run.evictions) * 1000 / static_cast<double>(run.lookups));
+}
+#endif
+
+/// A cold start: the database is loaded again, a zone found in it and one offset looked up.
+void ColdLoad(std::size_t iterations) {
+	for (std::size_t i = 0; i < iterations; ++i) {
+		ZoneDatabase::Instance().Reload();
+		auto guard = ZoneDatabase::Instance().Read();
+		DoNotOptimize(guard.Locate(zoneNames[i % 4])->get_info(date::sys_seconds(std::chrono::seconds(1700000000))));
+	}
+}
+}
+
+DATETIME_BENCHMARK("ZoneDatabase/AllZones/Load", LoadAllZones);
+DATETIME_BENCHMARK("ZoneDatabase/AllZones/SysInfo", SysInfoAllZones);
+#if TZ_ZONE_BUDGET
+DATETIME_BENCHMARK("ZoneDatabase/AllZones/SysInfo/Budget:256KiB", [](std::size_t iterations) {
+	static BudgetRun run;
+	SysInfoUnderBudget(iterations, 256 * 1024, run);
+});
+DATETIME_BENCHMARK("ZoneDatabase/AllZones/SysInfo/Budget:none", [](std::size_t iterations) {
+	static BudgetRun run;
+	SysInfoUnderBudget(iterations, 0, run);
+});
+#endif
+DATETIME_BENCHMARK("ZoneDatabase/ColdLoad", ColdLoad);
+DATETIME_BENCHMARK("ZoneDatabase/ReadSection", ReadSection);
+DATETIME_BENCHMARK("ZoneDatabase/Format", Format);
+DATETIME_BENCHMARK("ZoneDatabase/FormatDuringReloads/4Threads", [](std::size_t iterations) { FormatDuringReloads(iterations, 4); });
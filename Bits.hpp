@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace datetime::detail {
+inline unsigned Popcount(std::uint64_t x) {
+#ifdef _MSC_VER
+	return static_cast<unsigned>(__popcnt64(x));
+#else
+	return static_cast<unsigned>(__builtin_popcountll(x));
+#endif
+}
+
+/// Undefined for x == 0, like the intrinsics it wraps.
+inline unsigned CountTrailingZeros(std::uint64_t x) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, x);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+/// Undefined for x == 0, like the intrinsics it wraps.
+inline unsigned CountLeadingZeros(std::uint64_t x) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, x);
+	return 63 - static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_clzll(x));
+#endif
+}
+
+/// Position of the r-th (0-based) set bit of x, r must be below Popcount(x).
+inline unsigned SelectBit(std::uint64_t x, unsigned r) {
+	unsigned base = 0;
+	for (unsigned c; r >= (c = Popcount(x & 0xFF)); x >>= 8, base += 8)
+		r -= c;
+	for (; r > 0; --r)
+		x &= x - 1;
+	return base + CountTrailingZeros(x);
+}
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <fstream>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Bits.hpp"
+#include "Date.hpp"
+
+namespace datetime {
+/// Business days between the first and the last year of the calendar, stored as one bit
+/// per day with a running count of business days before every 64 day word. Counting is a
+/// lookup plus a popcount, and finding the k-th business day starts from a sampled word
+/// so every query runs in constant time.
+class BusinessCalendar {
+public:
+	/// Reads one YYYY-MM-DD holiday per line, blank lines and lines starting with '#' are skipped.
+	/// Anything but spaces around the date is an error.
+	static BusinessCalendar FromFile(const std::string &filename, const date::year &first, const date::year &last,
+		std::initializer_list<date::weekday> weekend = {date::Saturday, date::Sunday}) {
+		std::ifstream file(filename);
+		if (!file)
+			throw std::runtime_error("unable to open holiday file " + filename);
+		std::vector<Date> holidays;
+		std::string line;
+		for (std::size_t number = 1; std::getline(file, line); ++number) {
+			auto start = line.find_first_not_of(" \t\r");
+			if (start == std::string::npos || line[start] == '#')
+				continue;
+			date::year_month_day ymd;
+			std::istringstream ss(line.substr(start));
+			ss >> date::parse("%Y-%m-%d", ymd);
+			std::string rest;
+			if (ss.fail() || ss >> rest)
+				throw std::runtime_error(filename + ":" + std::to_string(number) + ": invalid holiday " + line);
+			holidays.emplace_back(ymd);
+		}
+		return {first, last, weekend, holidays};
+	}
+
+	BusinessCalendar(const date::year &first, const date::year &last,
+		std::initializer_list<date::weekday> weekend = {date::Saturday, date::Sunday}, const std::vector<Date> &holidays = {}) :
+		_first(first / date::January / 1),
+		_size(static_cast<std::size_t>((date::sys_days(last / date::December / 31) - _first).count() + 1)) {
+		if (last < first)
+			throw std::invalid_argument("business calendar ends before it starts");
+
+		unsigned weekendMask = 0;
+		for (auto wd : weekend)
+			weekendMask |= 1u << wd.c_encoding();
+
+		_words.assign((_size + 63) / 64, 0);
+		auto weekday = date::weekday(_first).c_encoding();
+		for (std::size_t i = 0; i < _size; ++i, weekday = weekday == 6 ? 0 : weekday + 1) {
+			if ((weekendMask & (1u << weekday)) == 0)
+				_words[i / 64] |= std::uint64_t(1) << (i % 64);
+		}
+		for (const auto &holiday : holidays) {
+			auto i = (date::sys_days(holiday.YearMonthDay()) - _first).count();
+			if (i >= 0 && static_cast<std::size_t>(i) < _size)
+				_words[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+		}
+
+		_prefix.resize(_words.size() + 1);
+		_prefix[0] = 0;
+		for (std::size_t w = 0; w < _words.size(); ++w) {
+			_prefix[w + 1] = _prefix[w] + detail::Popcount(_words[w]);
+			for (auto k = _prefix[w]; k < _prefix[w + 1]; ++k) {
+				if (k % 64 == 0)
+					_samples.push_back(static_cast<std::uint32_t>(w));
+			}
+		}
+	}
+
+	Date First() const { return {_first}; }
+	Date Last() const { return {_first + date::days(_size - 1)}; }
+
+	bool IsBusinessDay(const Date &d) const {
+		auto i = Index(d);
+		return (_words[i / 64] >> (i % 64)) & 1;
+	}
+
+	/// The number of business days in [from, to), negative when to is before from.
+	std::int64_t BusinessDaysBetween(const Date &from, const Date &to) const {
+		return static_cast<std::int64_t>(Rank(Index(to))) - static_cast<std::int64_t>(Rank(Index(from)));
+	}
+
+	/// The n-th business day after d, or before d when n is negative. d itself does not
+	/// need to be a business day and is returned unchanged when n is 0.
+	Date AddBusinessDays(const Date &d, std::int64_t n) const {
+		if (n == 0)
+			return d;
+		auto i = Index(d);
+		auto k = n > 0 ? static_cast<std::int64_t>(Rank(i + 1)) + n : static_cast<std::int64_t>(Rank(i)) + n + 1;
+		return FromIndex(Select(k));
+	}
+
+	/// The first business day strictly after d.
+	Date NextBusinessDay(const Date &d) const { return AddBusinessDays(d, 1); }
+	/// The last business day strictly before d.
+	Date PreviousBusinessDay(const Date &d) const { return AddBusinessDays(d, -1); }
+
+	template<class InputIt, class OutputIt>
+	OutputIt IsBusinessDay(InputIt first, InputIt last, OutputIt out) const {
+		for (; first != last; ++first, ++out)
+			*out = IsBusinessDay(*first);
+		return out;
+	}
+
+	template<class InputIt1, class InputIt2, class OutputIt>
+	OutputIt BusinessDaysBetween(InputIt1 first, InputIt1 last, InputIt2 to, OutputIt out) const {
+		for (; first != last; ++first, ++to, ++out)
+			*out = BusinessDaysBetween(*first, *to);
+		return out;
+	}
+
+	template<class InputIt, class OutputIt>
+	OutputIt AddBusinessDays(InputIt first, InputIt last, std::int64_t n, OutputIt out) const {
+		for (; first != last; ++first, ++out)
+			*out = AddBusinessDays(*first, n);
+		return out;
+	}
+
+private:
+	std::size_t Index(const Date &d) const {
+		auto i = (date::sys_days(d.YearMonthDay()) - _first).count();
+		if (i < 0 || static_cast<std::size_t>(i) >= _size)
+			throw std::out_of_range("date outside of the business calendar");
+		return static_cast<std::size_t>(i);
+	}
+
+	Date FromIndex(std::size_t i) const {
+		return {_first + date::days(i)};
+	}
+
+	/// The number of business days before day i, i may be one past the last day.
+	std::uint32_t Rank(std::size_t i) const {
+		auto w = i / 64, bit = i % 64;
+		auto count = _prefix[w];
+		if (bit != 0)
+			count += detail::Popcount(_words[w] & ((std::uint64_t(1) << bit) - 1));
+		return count;
+	}
+
+	/// The day of the k-th (1-based) business day.
+	std::size_t Select(std::int64_t k) const {
+		if (k < 1 || k > static_cast<std::int64_t>(_prefix.back()))
+			throw std::out_of_range("business day outside of the business calendar");
+		auto r = static_cast<std::uint32_t>(k - 1);
+		std::size_t w = _samples[r / 64];
+		while (_prefix[w + 1] <= r)
+			++w;
+		return 64 * w + detail::SelectBit(_words[w], r - _prefix[w]);
+	}
+
+	date::sys_days _first;
+	std::size_t _size;
+	std::vector<std::uint64_t> _words;
+	std::vector<std::uint32_t> _prefix;
+	std::vector<std::uint32_t> _samples;
+};
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <date/tz.h>
+
+namespace datetime {
+/// Writes the spans of tz database work, loading the database, reading zones and leap seconds,
+/// expanding rules and reloads, to a file in the Chrome trace event format, which
+/// chrome://tracing and Perfetto open. Each span carries the zone or file it was for and the
+/// bytes it read, and is shown on the thread that did the work, so zones loaded inside
+/// requests stand out.
+///
+/// The writer installs itself as the tzdb tracer for its lifetime and restores the previous
+/// one when destroyed, which waits for spans still running on other threads to report.
+class ChromeTraceWriter : public date::tzdb_tracer {
+public:
+	explicit ChromeTraceWriter(const std::string &path) :
+		_out(path), _start(std::chrono::steady_clock::now()) {
+		if (!_out)
+			throw std::runtime_error("unable to open trace file " + path);
+		_out << std::fixed << std::setprecision(3) << "{\"traceEvents\": [";
+		_previous = date::set_tzdb_tracer(this);
+	}
+
+	ChromeTraceWriter(const ChromeTraceWriter &) = delete;
+	ChromeTraceWriter &operator=(const ChromeTraceWriter &) = delete;
+
+	~ChromeTraceWriter() override {
+		date::set_tzdb_tracer(_previous);
+		std::lock_guard<std::mutex> lock(_mutex);
+		_out << "\n]}\n";
+	}
+
+	void span(const date::tzdb_span &s) override {
+		using Microseconds = std::chrono::duration<double, std::micro>;
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto thread = _threads.emplace(std::this_thread::get_id(), _threads.size() + 1).first->second;
+		_out << (_events++ == 0 ? "\n" : ",\n") << "{\"name\": \"" << s.name << "\", \"cat\": \"tzdb\", \"ph\": \"X\", \"ts\": "
+			<< Microseconds(s.begin - _start).count() << ", \"dur\": " << Microseconds(s.end - s.begin).count()
+			<< ", \"pid\": 1, \"tid\": " << thread << ", \"args\": {";
+		if (s.detail != nullptr)
+			WriteDetail(s.detail);
+		_out << "\"bytes\": " << s.bytes << "}}";
+	}
+
+	/// Writes the events so far to the file, which stays incomplete JSON until the writer is destroyed.
+	void Flush() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_out.flush();
+	}
+
+private:
+	void WriteDetail(const char *detail) {
+		_out << "\"detail\": \"";
+		for (auto p = detail; *p != '\0'; ++p) {
+			if (*p == '"' || *p == '\\')
+				_out << '\\';
+			_out << *p;
+		}
+		_out << "\", ";
+	}
+
+	std::mutex _mutex;
+	std::ofstream _out;
+	std::chrono::steady_clock::time_point _start;
+	std::unordered_map<std::thread::id, std::uint64_t> _threads;
+	std::uint64_t _events = 0;
+	date::tzdb_tracer *_previous = nullptr;
+};
+}
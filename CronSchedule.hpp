@@ -0,0 +1,351 @@
+#pragma once
+
+#include <cctype>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Bits.hpp"
+#include "DateTime.hpp"
+
+namespace datetime {
+/// A cron schedule, either the standard five fields "minute hour day-of-month month day-of-week"
+/// or six fields with a leading seconds field. Each field is compiled into a bitset, the next
+/// fire time is found by jumping from one set bit to the next field by field in local time.
+///
+/// Supports '*', '?', lists, ranges, steps, month and weekday names, 7 as Sunday and the
+/// @yearly, @annually, @monthly, @weekly, @daily, @midnight and @hourly macros. As in Vixie
+/// cron, when both day fields are restricted a day matches if either of them does. A day
+/// field is unrestricted only when it is exactly '*' or '?', so */2 restricts it.
+class CronSchedule {
+public:
+	static CronSchedule Parse(std::string_view expression) {
+		CronSchedule schedule;
+		std::string error;
+		if (!schedule.Compile(expression, error))
+			throw std::invalid_argument("invalid cron expression \"" + std::string(expression) + "\": " + error);
+		return schedule;
+	}
+
+	static std::optional<CronSchedule> TryParse(std::string_view expression) {
+		CronSchedule schedule;
+		std::string error;
+		if (!schedule.Compile(expression, error))
+			return {};
+		return schedule;
+	}
+
+	/// The first fire time strictly after tp in the given zone. Local times skipped by a DST gap
+	/// fire at the end of the gap, local times repeated by a DST overlap fire only once on their
+	/// first occurrence. Empty if the schedule never fires, such as on the 30th of February.
+	std::optional<date::sys_seconds> NextAfter(date::sys_seconds tp, const date::time_zone *zone) const {
+		auto local = zone->to_local(tp) + std::chrono::seconds(1);
+		for (;;) {
+			auto candidate = NextLocal(local);
+			if (!candidate)
+				return {};
+			auto info = zone->get_info_view(*candidate);
+			date::sys_seconds fire;
+			if (info.result == date::local_info_view::nonexistent)
+				fire = info.second.begin;
+			else
+				fire = date::sys_seconds((*candidate - info.first.offset).time_since_epoch());
+			if (fire > tp)
+				return fire;
+			local = *candidate + std::chrono::seconds(1);
+		}
+	}
+
+	template<class Duration>
+	std::optional<DateTime<typename std::common_type<Duration, std::chrono::seconds>::type>> NextAfter(const DateTime<Duration> &dt) const {
+		using CommonDuration = typename std::common_type<Duration, std::chrono::seconds>::type;
+		auto zone = dt.Timezone();
+		auto fire = NextAfter(date::floor<std::chrono::seconds>(dt.ZonedTime().get_sys_time()), zone);
+		if (!fire)
+			return {};
+		return DateTime<CommonDuration>(date::zoned_time<CommonDuration>(zone, date::sys_time<CommonDuration>(*fire)));
+	}
+
+	/// Writes up to count successive fire times after dt, stopping early if the schedule ends.
+	template<class Duration, class OutputIt>
+	OutputIt NextN(const DateTime<Duration> &dt, std::size_t count, OutputIt out) const {
+		using CommonDuration = typename std::common_type<Duration, std::chrono::seconds>::type;
+		auto zone = dt.Timezone();
+		auto tp = date::floor<std::chrono::seconds>(dt.ZonedTime().get_sys_time());
+		for (std::size_t i = 0; i < count; ++i, ++out) {
+			auto fire = NextAfter(tp, zone);
+			if (!fire)
+				break;
+			*out = DateTime<CommonDuration>(date::zoned_time<CommonDuration>(zone, date::sys_time<CommonDuration>(*fire)));
+			tp = *fire;
+		}
+		return out;
+	}
+
+private:
+	enum Field { Second, Minute, Hour, DayOfMonth, Month, DayOfWeek };
+
+	CronSchedule() = default;
+
+	bool Compile(std::string_view expression, std::string &error) {
+		static constexpr std::pair<std::string_view, std::string_view> macros[] = {
+			{"@yearly", "0 0 1 1 *"}, {"@annually", "0 0 1 1 *"}, {"@monthly", "0 0 1 * *"},
+			{"@weekly", "0 0 * * 0"}, {"@daily", "0 0 * * *"}, {"@midnight", "0 0 * * *"}, {"@hourly", "0 * * * *"}
+		};
+		for (const auto &[name, replacement] : macros) {
+			if (expression == name) {
+				expression = replacement;
+				break;
+			}
+		}
+
+		std::vector<std::string_view> fields;
+		for (std::size_t i = 0; i < expression.size();) {
+			if (std::isspace(static_cast<unsigned char>(expression[i]))) {
+				++i;
+				continue;
+			}
+			auto j = i;
+			while (j < expression.size() && !std::isspace(static_cast<unsigned char>(expression[j])))
+				++j;
+			fields.push_back(expression.substr(i, j - i));
+			i = j;
+		}
+		if (fields.size() == 5)
+			fields.insert(fields.begin(), "0");
+		if (fields.size() != 6) {
+			error = "expected 5 or 6 fields";
+			return false;
+		}
+
+		std::uint64_t masks[6];
+		for (int f = Second; f <= DayOfWeek; ++f) {
+			if (!ParseField(fields[f], static_cast<Field>(f), masks[f], error))
+				return false;
+		}
+		_seconds = masks[Second];
+		_minutes = masks[Minute];
+		_hours = static_cast<std::uint32_t>(masks[Hour]);
+		_daysOfMonth = static_cast<std::uint32_t>(masks[DayOfMonth]);
+		_months = static_cast<std::uint16_t>(masks[Month]);
+		// 7 is an alias for Sunday
+		auto dow = masks[DayOfWeek];
+		_daysOfWeek = static_cast<std::uint8_t>((dow | (dow >> 7)) & 0x7F);
+		// A stepped star such as */2 restricts its field like any other list
+		_anyDayOfMonth = fields[DayOfMonth] == "*" || fields[DayOfMonth] == "?";
+		_anyDayOfWeek = fields[DayOfWeek] == "*" || fields[DayOfWeek] == "?";
+
+		// Days of a month whose first day falls on weekday w (Sunday is 0).
+		for (unsigned w = 0; w < 7; ++w) {
+			_weekdayDays[w] = 0;
+			for (unsigned d = 1; d <= 31; ++d) {
+				if (_daysOfWeek & (1u << ((w + d - 1) % 7)))
+					_weekdayDays[w] |= 1u << d;
+			}
+		}
+		return true;
+	}
+
+	static bool ParseValue(std::string_view text, Field field, int &value) {
+		static constexpr std::string_view months[] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+		static constexpr std::string_view weekdays[] = {"SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT"};
+		if (text.empty())
+			return false;
+		if (std::isalpha(static_cast<unsigned char>(text[0]))) {
+			if (text.size() != 3 || (field != Month && field != DayOfWeek))
+				return false;
+			std::string upper;
+			for (auto c : text)
+				upper.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+			if (field == Month) {
+				for (int i = 0; i < 12; ++i) {
+					if (upper == months[i]) {
+						value = i + 1;
+						return true;
+					}
+				}
+			} else {
+				for (int i = 0; i < 7; ++i) {
+					if (upper == weekdays[i]) {
+						value = i;
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+		value = 0;
+		for (auto c : text) {
+			if (c < '0' || c > '9' || value > 100)
+				return false;
+			value = 10 * value + (c - '0');
+		}
+		return true;
+	}
+
+	static bool ParseField(std::string_view text, Field field, std::uint64_t &mask, std::string &error) {
+		static constexpr int minimums[] = {0, 0, 0, 1, 1, 0};
+		static constexpr int maximums[] = {59, 59, 23, 31, 12, 7};
+		static constexpr const char *names[] = {"second", "minute", "hour", "day of month", "month", "day of week"};
+		auto min = minimums[field], max = maximums[field];
+
+		mask = 0;
+		while (!text.empty()) {
+			auto comma = text.find(',');
+			auto item = text.substr(0, comma);
+			text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+
+			int step = 1;
+			auto slash = item.find('/');
+			if (slash != std::string_view::npos) {
+				if (!ParseValue(item.substr(slash + 1), Hour, step) || step == 0) {
+					error = std::string("bad step in ") + names[field] + " field";
+					return false;
+				}
+				item = item.substr(0, slash);
+			}
+
+			int first, last;
+			if (item == "*" || item == "?") {
+				first = min;
+				last = max;
+			} else {
+				auto dash = item.find('-');
+				if (!ParseValue(item.substr(0, dash), field, first)) {
+					error = std::string("bad value in ") + names[field] + " field";
+					return false;
+				}
+				if (dash != std::string_view::npos) {
+					if (!ParseValue(item.substr(dash + 1), field, last)) {
+						error = std::string("bad range in ") + names[field] + " field";
+						return false;
+					}
+				} else {
+					last = slash != std::string_view::npos ? max : first;
+				}
+			}
+			if (first < min || last > max || first > last) {
+				error = std::string("value out of range in ") + names[field] + " field";
+				return false;
+			}
+			for (auto v = first; v <= last; v += step)
+				mask |= std::uint64_t(1) << v;
+		}
+		if (mask == 0) {
+			error = std::string("empty ") + names[field] + " field";
+			return false;
+		}
+		return true;
+	}
+
+	/// The next set bit of mask at or after from, or -1.
+	static int NextBit(std::uint64_t mask, int from) {
+		if (from > 63)
+			return -1;
+		auto rest = mask >> from;
+		return rest == 0 ? -1 : from + static_cast<int>(detail::CountTrailingZeros(rest));
+	}
+
+	std::uint32_t DayMask(const date::year &y, unsigned m) const {
+		auto firstDay = date::year_month_day(y, date::month(m), date::day(1));
+		auto length = static_cast<unsigned>(date::year_month_day_last(y, date::month_day_last(date::month(m))).day());
+		auto lengthMask = static_cast<std::uint32_t>(((std::uint64_t(1) << (length + 1)) - 1) & ~std::uint64_t(1));
+		auto byWeekday = _weekdayDays[date::weekday(firstDay).c_encoding()];
+		std::uint32_t days;
+		if (_anyDayOfMonth && _anyDayOfWeek)
+			days = lengthMask;
+		else if (_anyDayOfMonth)
+			days = byWeekday;
+		else if (_anyDayOfWeek)
+			days = _daysOfMonth;
+		else
+			days = _daysOfMonth | byWeekday;
+		return days & lengthMask;
+	}
+
+	/// The first local time at or after from matching every field, jumping a whole field at a time.
+	std::optional<date::local_seconds> NextLocal(date::local_seconds from) const {
+		auto day = date::floor<date::days>(from);
+		date::year_month_day ymd{day};
+		auto tod = date::make_time(from - day);
+		auto y = static_cast<int>(ymd.year());
+		auto mo = static_cast<int>(static_cast<unsigned>(ymd.month()));
+		auto d = static_cast<int>(static_cast<unsigned>(ymd.day()));
+		auto h = static_cast<int>(tod.hours().count());
+		auto mi = static_cast<int>(tod.minutes().count());
+		auto s = static_cast<int>(tod.seconds().count());
+		// Day of month and weekday patterns repeat every 400 years.
+		auto lastYear = y + 400;
+
+		for (;;) {
+			if (y > lastYear)
+				return {};
+			auto nextMonth = NextBit(_months, mo);
+			if (nextMonth == -1) {
+				++y;
+				mo = 1;
+				d = 1, h = 0, mi = 0, s = 0;
+				continue;
+			}
+			if (nextMonth != mo) {
+				mo = nextMonth;
+				d = 1, h = 0, mi = 0, s = 0;
+			}
+			auto nextDay = NextBit(DayMask(date::year(y), static_cast<unsigned>(mo)), d);
+			if (nextDay == -1) {
+				++mo;
+				d = 1, h = 0, mi = 0, s = 0;
+				continue;
+			}
+			if (nextDay != d) {
+				d = nextDay;
+				h = 0, mi = 0, s = 0;
+			}
+			auto nextHour = NextBit(_hours, h);
+			if (nextHour == -1) {
+				++d;
+				h = 0, mi = 0, s = 0;
+				continue;
+			}
+			if (nextHour != h) {
+				h = nextHour;
+				mi = 0, s = 0;
+			}
+			auto nextMinute = NextBit(_minutes, mi);
+			if (nextMinute == -1) {
+				++h;
+				mi = 0, s = 0;
+				continue;
+			}
+			if (nextMinute != mi) {
+				mi = nextMinute;
+				s = 0;
+			}
+			auto nextSecond = NextBit(_seconds, s);
+			if (nextSecond == -1) {
+				++mi;
+				s = 0;
+				continue;
+			}
+			s = nextSecond;
+			break;
+		}
+		return date::local_days(date::year(y) / date::month(static_cast<unsigned>(mo)) / date::day(static_cast<unsigned>(d))) +
+			std::chrono::hours(h) + std::chrono::minutes(mi) + std::chrono::seconds(s);
+	}
+
+	std::uint64_t _seconds = 0;
+	std::uint64_t _minutes = 0;
+	std::uint32_t _hours = 0;
+	std::uint32_t _daysOfMonth = 0;
+	std::uint16_t _months = 0;
+	std::uint8_t _daysOfWeek = 0;
+	bool _anyDayOfMonth = true;
+	bool _anyDayOfWeek = true;
+	std::uint32_t _weekdayDays[7] = {};
+};
+}
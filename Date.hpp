@@ -1,10 +1,60 @@
 #pragma once
 
+#include <cstddef>
+
 #include <date/date.h>
 
 #include "TimeDelta.hpp"
 
 namespace datetime {
+namespace detail {
+/// Divisible by 4, and by 16 when divisible by 25, the same as by 400 when by 100.
+constexpr bool IsLeapYear(int y) {
+	return ((y & 3) == 0) & ((y % 25 != 0) | ((y & 15) == 0));
+}
+
+/// 1 for 1 January. 275m/9 steps through the month lengths as if February had 30 days, the
+/// days it lacks are taken off from March on.
+constexpr unsigned DayOfYear(int y, unsigned m, unsigned d) {
+	return 275 * m / 9 - (m + 9) / 12 * (2 - IsLeapYear(y)) + d - 30;
+}
+
+constexpr unsigned Quarter(unsigned m) {
+	return (m + 2) / 3;
+}
+
+/// 0 for Monday, of the day that many days after 1970-01-01, a Thursday. A multiple of 7
+/// larger than the days to year -32767 makes the count positive for a single unsigned %.
+constexpr unsigned Weekday(int days) {
+	return static_cast<unsigned>(days + 7 * (1 << 21) + 3) % 7;
+}
+
+/// 0 for Sunday, the encoding of date::weekday::c_encoding() and of weekday bit masks.
+constexpr unsigned CWeekday(int days) {
+	return (Weekday(days) + 1) % 7;
+}
+
+constexpr unsigned CWeekday(date::sys_days d) {
+	return CWeekday(d.time_since_epoch().count());
+}
+
+struct IsoWeekDate {
+	int year;
+	unsigned week;
+};
+
+/// The ISO week of day doy of year y, a weekday wd counted from Monday, is the week of its
+/// Thursday, which can fall in the year before or after. Comparisons turned into 0 or 1 move
+/// it there, the days of the year it crosses added or taken off.
+constexpr IsoWeekDate IsoWeek(int y, unsigned doy, unsigned wd) {
+	int thursday = static_cast<int>(doy) - static_cast<int>(wd) + 3;
+	int before = thursday < 1;
+	int after = thursday > 365 + IsLeapYear(y);
+	thursday += before * (365 + IsLeapYear(y - 1)) - after * (365 + IsLeapYear(y));
+	return {y - before + after, static_cast<unsigned>(thursday + 6) / 7};
+}
+}
+
 class Date {
 public:
 	static Date Today() {
@@ -21,28 +71,47 @@ public:
 	}
 
 	Date() = default;
-	Date(const date::year_month_day &ymd) :
+	constexpr Date(const date::year_month_day &ymd) :
 		_ymd(ymd) {
 	}
-	Date(const date::year &y, const date::month &m, const date::day &d) :
+	constexpr Date(const date::year &y, const date::month &m, const date::day &d) :
 		_ymd(y, m, d) {
 	}
 
-	const date::year_month_day &YearMonthDay() const { return _ymd; }
+	constexpr const date::year_month_day &YearMonthDay() const { return _ymd; }
 	
-	date::year Year() const { return _ymd.year(); }
-	date::month Month() const { return _ymd.month(); }
-	date::day Day() const { return _ymd.day(); }
+	constexpr date::year Year() const { return _ymd.year(); }
+	constexpr date::month Month() const { return _ymd.month(); }
+	constexpr date::day Day() const { return _ymd.day(); }
 
-	date::weekday ObjWeekday() const {
+	constexpr date::weekday ObjWeekday() const {
 		return date::weekday(_ymd);
 	}
-	unsigned Weekday() const {
-		return (ObjWeekday().c_encoding() - 1) % 7; // can do better
+	/// 0 for Monday to 6 for Sunday.
+	constexpr unsigned Weekday() const {
+		return detail::Weekday(date::sys_days(_ymd).time_since_epoch().count());
 	}
-	unsigned IsoWeekday() const {
+	/// 1 for Monday to 7 for Sunday.
+	constexpr unsigned IsoWeekday() const {
 		return 1 + Weekday();
 	}
+
+	/// 1 to 366.
+	constexpr unsigned DayOfYear() const {
+		return detail::DayOfYear(static_cast<int>(Year()), static_cast<unsigned>(Month()), static_cast<unsigned>(Day()));
+	}
+	/// 1 to 4.
+	constexpr unsigned Quarter() const {
+		return detail::Quarter(static_cast<unsigned>(Month()));
+	}
+	/// 1 to 53, the week of ISO 8601 that begins on a Monday and belongs to the year holding
+	/// its Thursday, IsoWeekYear, which differs from Year in the first and last days of a year.
+	constexpr unsigned IsoWeek() const {
+		return detail::IsoWeek(static_cast<int>(Year()), DayOfYear(), Weekday()).week;
+	}
+	constexpr date::year IsoWeekYear() const {
+		return date::year(detail::IsoWeek(static_cast<int>(Year()), DayOfYear(), Weekday()).year);
+	}
 	
 	std::string Format(std::string_view format) const {
 		return date::format(format.data(), _ymd);
@@ -75,4 +144,36 @@ template<class CharT, class Traits>
 std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os, const Date &date) {
 	return os << date.YearMonthDay();
 }
+
+/// The calendar fields of a column of dates at once, for grouping: out[i] is the field of
+/// values[i]. T is Date, SerialDate or DateTime and Out an integer type the field fits in.
+template<class T, class Out>
+void Weekdays(const T *values, std::size_t count, Out *out) {
+	for (std::size_t i = 0; i < count; ++i)
+		out[i] = static_cast<Out>(values[i].Weekday());
+}
+
+template<class T, class Out>
+void DaysOfYear(const T *values, std::size_t count, Out *out) {
+	for (std::size_t i = 0; i < count; ++i)
+		out[i] = static_cast<Out>(values[i].DayOfYear());
+}
+
+template<class T, class Out>
+void Quarters(const T *values, std::size_t count, Out *out) {
+	for (std::size_t i = 0; i < count; ++i)
+		out[i] = static_cast<Out>(values[i].Quarter());
+}
+
+template<class T, class Out>
+void IsoWeeks(const T *values, std::size_t count, Out *out) {
+	for (std::size_t i = 0; i < count; ++i)
+		out[i] = static_cast<Out>(values[i].IsoWeek());
+}
+
+template<class T, class Out>
+void IsoWeekYears(const T *values, std::size_t count, Out *out) {
+	for (std::size_t i = 0; i < count; ++i)
+		out[i] = static_cast<Out>(static_cast<int>(values[i].IsoWeekYear()));
+}
 }
@@ -6,15 +6,15 @@ namespace datetime {
 /// The date/time format defined in the ISO 8601 standard.
 ///
 /// Examples: 
-///   2005-01-01T12:00:00+01:00
+///   2005-01-01T12:00:00+0100
 ///   2005-01-01T11:00:00Z
 static constexpr std::string_view ISO8601_FORMAT = "%Y-%m-%dT%H:%M:%S%z";
 
 /// The date/time format defined in the ISO 8601 standard,
-/// with fractional seconds.
+/// with fractional seconds at the precision of the DateTime Duration.
 ///
 /// Examples: 
-///   2005-01-01T12:00:00.000000+01:00
+///   2005-01-01T12:00:00.000000+0100
 ///   2005-01-01T11:00:00.000000Z
 static constexpr std::string_view ISO8601_FRAC_FORMAT = "%Y-%m-%dT%H:%M:%s%z";
 
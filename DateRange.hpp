@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#if __has_include(<version>)
+#include <version>
+#endif
+#ifdef __cpp_lib_ranges
+#include <ranges>
+#endif
+
+#include "DateTime.hpp"
+
+namespace datetime {
+namespace detail {
+/// Selects days by weekday and/or by being the last day of their month, working on
+/// serial days so that skipping to the next match never probes individual days.
+class DayFilter {
+public:
+	DayFilter() = default;
+
+	bool Empty() const { return _weekdays == 0x7F && !_monthEnds; }
+
+	void SetWeekdays(std::initializer_list<date::weekday> weekdays) {
+		_weekdays = 0;
+		for (auto wd : weekdays)
+			_weekdays |= 1u << wd.c_encoding();
+		if (_weekdays == 0)
+			throw std::invalid_argument("weekday filter selects no days");
+		for (unsigned w = 0; w < 7; ++w) {
+			unsigned j = 0;
+			while ((_weekdays & (1u << ((w + j) % 7))) == 0)
+				++j;
+			_skip[w] = static_cast<unsigned char>(j);
+		}
+	}
+	void SetMonthEnds() { _monthEnds = true; }
+
+	/// The first matching day on or after d.
+	date::sys_days Next(date::sys_days d) const {
+		if (!_monthEnds)
+			return d + date::days(_skip[CWeekday(d)]);
+		date::year_month_day ymd{d};
+		auto ym = ymd.year() / ymd.month();
+		for (;;) {
+			date::sys_days last{ym / date::last};
+			if (_weekdays & (1u << CWeekday(last)))
+				return last;
+			ym += date::months(1);
+		}
+	}
+
+private:
+	unsigned _weekdays = 0x7F;
+	bool _monthEnds = false;
+	std::array<unsigned char, 7> _skip{};
+};
+}
+
+/// A lazy sequence of dates in [start, stop) separated by a whole number of days.
+/// Iteration advances a serial day count, a year_month_day is only built on dereference.
+class DateRange {
+public:
+	class Iterator {
+	public:
+		using iterator_concept = std::forward_iterator_tag;
+		using iterator_category = std::input_iterator_tag;
+		using value_type = Date;
+		using difference_type = std::ptrdiff_t;
+		using reference = Date;
+		using pointer = void;
+
+		Iterator() = default;
+
+		Date operator*() const { return {_current}; }
+
+		Iterator &operator++() {
+			_current += _step;
+			Settle();
+			return *this;
+		}
+		Iterator operator++(int) {
+			auto it = *this;
+			++*this;
+			return it;
+		}
+
+		friend bool operator==(const Iterator &x, const Iterator &y) { return x._current == y._current; }
+		friend bool operator!=(const Iterator &x, const Iterator &y) { return !(x == y); }
+
+	private:
+		friend class DateRange;
+
+		Iterator(date::sys_days start, date::sys_days current, date::sys_days last, date::days step, const detail::DayFilter &filter) :
+			_start(start), _current(current), _last(last), _step(step), _filter(filter) {
+			Settle();
+		}
+
+		/// Moves onto the first step at or after the current one that passes the filter.
+		void Settle() {
+			while (_current < _last) {
+				if (_filter.Empty())
+					return;
+				auto next = _filter.Next(_current);
+				if (next == _current)
+					return;
+				_current = _start + (next - _start + _step - date::days(1)) / _step * _step;
+			}
+			_current = _last;
+		}
+
+		date::sys_days _start;
+		date::sys_days _current;
+		date::sys_days _last;
+		date::days _step{1};
+		detail::DayFilter _filter;
+	};
+
+	DateRange(const Date &start, const Date &stop, const TimeDelta &step = TimeDelta(date::days(1))) :
+		_start(start.YearMonthDay()),
+		_last(std::max(_start, date::sys_days(stop.YearMonthDay()))),
+		_step(step.Days()) {
+		if (_step <= date::days(0))
+			throw std::invalid_argument("DateRange step must be at least one day");
+	}
+
+	/// Only yields the dates falling on one of the given weekdays.
+	DateRange OnWeekdays(std::initializer_list<date::weekday> weekdays) const {
+		auto range = *this;
+		range._filter.SetWeekdays(weekdays);
+		return range;
+	}
+
+	/// Only yields the dates that are the last day of their month.
+	DateRange OnMonthEnds() const {
+		auto range = *this;
+		range._filter.SetMonthEnds();
+		return range;
+	}
+
+	Iterator begin() const { return {_start, _start, _last, _step, _filter}; }
+	Iterator end() const { return {_start, _last, _last, _step, _filter}; }
+
+	bool empty() const { return begin() == end(); }
+
+private:
+	date::sys_days _start;
+	date::sys_days _last;
+	date::days _step;
+	detail::DayFilter _filter;
+};
+
+/// A lazy sequence of instants in [start, stop) separated by a fixed step, presented in the
+/// time zone of start. Iteration advances the UTC tick count, DateTime fields are only
+/// computed when the caller reads them. Weekday filters use the local calendar day.
+template<class Duration = std::chrono::system_clock::duration>
+class DateTimeRange {
+	using CommonDuration = typename std::common_type<Duration, std::chrono::seconds>::type;
+	using SysTime = date::sys_time<CommonDuration>;
+public:
+	class Iterator {
+	public:
+		using iterator_concept = std::forward_iterator_tag;
+		using iterator_category = std::input_iterator_tag;
+		using value_type = DateTime<CommonDuration>;
+		using difference_type = std::ptrdiff_t;
+		using reference = DateTime<CommonDuration>;
+		using pointer = void;
+
+		Iterator() = default;
+
+		DateTime<CommonDuration> operator*() const { return {date::make_zoned(_zone, _current)}; }
+
+		Iterator &operator++() {
+			_current += _step;
+			Settle();
+			return *this;
+		}
+		Iterator operator++(int) {
+			auto it = *this;
+			++*this;
+			return it;
+		}
+
+		friend bool operator==(const Iterator &x, const Iterator &y) { return x._current == y._current; }
+		friend bool operator!=(const Iterator &x, const Iterator &y) { return !(x == y); }
+
+	private:
+		friend class DateTimeRange;
+
+		Iterator(const date::time_zone *zone, SysTime start, SysTime current, SysTime last, CommonDuration step, const detail::DayFilter &filter) :
+			_zone(zone), _start(start), _current(current), _last(last), _step(step), _filter(filter) {
+			Settle();
+		}
+
+		/// The local calendar day of tp, the zone offset is cached until the next transition.
+		/// The cached period stays in seconds: the first and last periods of a zone reach
+		/// years that overflow finer durations.
+		date::sys_days LocalDay(SysTime tp) {
+			auto seconds = date::floor<std::chrono::seconds>(tp);
+			if (seconds < _infoBegin || seconds >= _infoEnd) {
+				auto info = _zone->get_info_view(tp);
+				_infoBegin = info.begin;
+				_infoEnd = info.end;
+				_offset = info.offset;
+			}
+			return date::floor<date::days>(tp + _offset);
+		}
+
+		void Settle() {
+			while (_current < _last) {
+				if (_filter.Empty())
+					return;
+				auto day = LocalDay(_current);
+				auto next = _filter.Next(day);
+				if (next == day)
+					return;
+				auto midnight = _zone->to_sys(date::local_days(next.time_since_epoch()), date::choose::earliest);
+				_current = _start + (midnight - _start + _step - CommonDuration(1)) / _step * _step;
+			}
+			_current = _last;
+		}
+
+		const date::time_zone *_zone = nullptr;
+		SysTime _start;
+		SysTime _current;
+		SysTime _last;
+		CommonDuration _step{1};
+		detail::DayFilter _filter;
+		date::sys_seconds _infoBegin = date::sys_seconds::max();
+		date::sys_seconds _infoEnd = date::sys_seconds::min();
+		std::chrono::seconds _offset{0};
+	};
+
+	DateTimeRange(const DateTime<Duration> &start, const DateTime<Duration> &stop, const TimeDelta &step) :
+		_zone(start.Timezone()),
+		_start(start.ZonedTime().get_sys_time()),
+		_last(std::max(_start, SysTime(stop.ZonedTime().get_sys_time()))),
+		_step(std::chrono::duration_cast<CommonDuration>(date::days(step.Days()) + std::chrono::seconds(step.Seconds()) + std::chrono::microseconds(step.Microseconds()))) {
+		if (_step <= CommonDuration(0))
+			throw std::invalid_argument("DateTimeRange step must be positive");
+	}
+
+	/// Only yields the instants whose local date falls on one of the given weekdays.
+	DateTimeRange OnWeekdays(std::initializer_list<date::weekday> weekdays) const {
+		auto range = *this;
+		range._filter.SetWeekdays(weekdays);
+		return range;
+	}
+
+	/// Only yields the instants whose local date is the last day of its month.
+	DateTimeRange OnMonthEnds() const {
+		auto range = *this;
+		range._filter.SetMonthEnds();
+		return range;
+	}
+
+	Iterator begin() const { return {_zone, _start, _start, _last, _step, _filter}; }
+	Iterator end() const { return {_zone, _start, _last, _last, _step, _filter}; }
+
+	bool empty() const { return begin() == end(); }
+
+private:
+	const date::time_zone *_zone;
+	SysTime _start;
+	SysTime _last;
+	CommonDuration _step;
+	detail::DayFilter _filter;
+};
+}
+
+#ifdef __cpp_lib_ranges
+template<>
+inline constexpr bool std::ranges::enable_borrowed_range<datetime::DateRange> = true;
+template<>
+inline constexpr bool std::ranges::enable_view<datetime::DateRange> = true;
+template<class Duration>
+inline constexpr bool std::ranges::enable_borrowed_range<datetime::DateTimeRange<Duration>> = true;
+template<class Duration>
+inline constexpr bool std::ranges::enable_view<datetime::DateTimeRange<Duration>> = true;
+#endif
@@ -6,9 +6,13 @@
 #include "Date.hpp"
 #include "TimeDelta.hpp"
 #include "DateFormats.hpp"
+#include "FixedOffsetZone.hpp"
+#include "Stats.hpp"
 
 namespace datetime {
-template<class Duration = std::chrono::system_clock::duration>
+/// An instant in a time zone. TimeZonePtr is a tz database zone by default, FixedOffsetZone
+/// keeps instants that carry a UTC offset without one.
+template<class Duration = std::chrono::system_clock::duration, class TimeZonePtr = const date::time_zone *>
 class DateTime {
 	using CommonDuration = typename std::common_type<Duration, std::chrono::seconds>::type;
 public:
@@ -29,20 +33,35 @@ public:
 	static bool TryParse(const std::string &dateString, const std::string &format, DateTime<CommonDuration> &dateTime);
 	static std::optional<DateTime<CommonDuration>> TryParse(const std::string &dateString, const std::string &format);
 
+	/// Parses text carrying its UTC offset, a %z such as +0530, an %Ez such as +05:30, a Z in
+	/// the ISO 8601 formats or a %Z of UTC, GMT or +hhmm, into the FixedOffsetZone of that
+	/// offset without the tz database. Text without an offset or with text left over fails,
+	/// ParseOffset throws std::invalid_argument.
+	static DateTime<CommonDuration, FixedOffsetZone> ParseOffset(const std::string &dateString, const std::string &format = std::string(ISO8601_FORMAT));
+	static bool TryParseOffset(const std::string &dateString, const std::string &format, DateTime<CommonDuration, FixedOffsetZone> &dateTime);
+
 	DateTime() = default;
-	DateTime(const date::zoned_time<CommonDuration> &zt) :
+	DateTime(const date::zoned_time<CommonDuration, TimeZonePtr> &zt) :
 		_zt(zt) {
 	}
 
-	const date::zoned_time<CommonDuration> &ZonedTime() const { return _zt; }
+	const date::zoned_time<CommonDuration, TimeZonePtr> &ZonedTime() const { return _zt; }
 
-	Date Date() const;
+	datetime::Date Date() const;
 	date::year Year() const;
 	date::month Month() const;
 	date::day Day() const;
+	/// The calendar fields of Date, in local time.
+	unsigned Weekday() const;
+	unsigned IsoWeekday() const;
+	unsigned DayOfYear() const;
+	unsigned Quarter() const;
+	unsigned IsoWeek() const;
+	date::year IsoWeekYear() const;
 
-	const date::time_zone *Timezone() const;
-	const std::string &TzInfo() const;
+	TimeZonePtr Timezone() const;
+	/// The zone name, a reference for tz database zones.
+	decltype(auto) TzInfo() const;
 
 	TimeDelta UtcOffset() const;
 
@@ -50,10 +69,20 @@ public:
 
 	std::string Format(std::string_view format = ISO8601_FORMAT) const;
 
+	/// Writes Format(format) to out. Formats of numeric commands and %Z, such as ISO8601_FORMAT,
+	/// are written in a single pass without allocating.
+	template<class OutputIt>
+	OutputIt FormatTo(OutputIt out, std::string_view format = ISO8601_FORMAT) const;
+
 private:
+	static bool ParseLocal(const std::string &dateString, const std::string &format, date::local_time<CommonDuration> &tp);
+
 	date::fields<CommonDuration> FieldsYmdTime() const;
 
-	date::zoned_time<CommonDuration> _zt;
+	/// The single pass formatting of format into [out, end), nullptr when it does not apply.
+	char *FastFormat(std::string_view format, char *out, char *end) const;
+
+	date::zoned_time<CommonDuration, TimeZonePtr> _zt;
 };
 }
 
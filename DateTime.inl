@@ -1,32 +1,35 @@
 #pragma once
 
+#include <algorithm>
 #include <iomanip>
 #include <cmath>
+#include <stdexcept>
 
 #include "DateTime.hpp"
+#include "DateTimeParse.hpp"
 
 namespace datetime {
-template<class Duration>
-DateTime<typename DateTime<Duration>::CommonDuration> DateTime<Duration>::Today() {
+template<class Duration, class TimeZonePtr>
+DateTime<typename DateTime<Duration, TimeZonePtr>::CommonDuration> DateTime<Duration, TimeZonePtr>::Today() {
 	return date::make_zoned(date::current_zone(), date::floor<Duration>(std::chrono::system_clock::now()));
 }
 
-template<class Duration>
-DateTime<typename DateTime<Duration>::CommonDuration> DateTime<Duration>::Now(const std::string &timezoneName) {
+template<class Duration, class TimeZonePtr>
+DateTime<typename DateTime<Duration, TimeZonePtr>::CommonDuration> DateTime<Duration, TimeZonePtr>::Now(const std::string &timezoneName) {
 	if (timezoneName.empty()) {
 		return Today();
 	}
 	return date::make_zoned(timezoneName, date::floor<Duration>(std::chrono::system_clock::now()));
 }
 
-template<class Duration>
-DateTime<typename DateTime<Duration>::CommonDuration> DateTime<Duration>::UtcNow() {
+template<class Duration, class TimeZonePtr>
+DateTime<typename DateTime<Duration, TimeZonePtr>::CommonDuration> DateTime<Duration, TimeZonePtr>::UtcNow() {
 	return {date::floor<Duration>(std::chrono::system_clock::now())};
 }
 
-template<class Duration>
+template<class Duration, class TimeZonePtr>
 template<class Rep>
-DateTime<typename DateTime<Duration>::CommonDuration> DateTime<Duration>::FromTimestamp(Rep timestamp, const std::string &timezoneName) {
+DateTime<typename DateTime<Duration, TimeZonePtr>::CommonDuration> DateTime<Duration, TimeZonePtr>::FromTimestamp(Rep timestamp, const std::string &timezoneName) {
 	auto nanos = static_cast<unsigned>(1e9 * std::fmod(timestamp, 1)); // might loose precision here
 	auto tp = std::chrono::system_clock::from_time_t(timestamp) + std::chrono::nanoseconds(nanos);
 	if (timezoneName.empty()) {
@@ -36,153 +39,261 @@ DateTime<typename DateTime<Duration>::CommonDuration> DateTime<Duration>::FromTi
 	}
 }
 
-template<class Duration>
+template<class Duration, class TimeZonePtr>
 template<class Rep>
-DateTime<typename DateTime<Duration>::CommonDuration> DateTime<Duration>::UtcFromTimestamp(Rep timestamp) {
+DateTime<typename DateTime<Duration, TimeZonePtr>::CommonDuration> DateTime<Duration, TimeZonePtr>::UtcFromTimestamp(Rep timestamp) {
 	auto nanos = static_cast<unsigned>(1e9 * std::fmod(timestamp, 1)); // might loose precision here
 	auto tp = std::chrono::system_clock::from_time_t(timestamp) + std::chrono::nanoseconds(nanos);
 	return {tp};
 }
 
-template<class Duration>
-DateTime<typename DateTime<Duration>::CommonDuration> DateTime<Duration>::Parse(const std::string &dateString, const std::string &format) {
-	date::local_seconds tp;
-	std::istringstream ss(dateString);
-	ss >> date::parse(format, tp);
+template<class Duration, class TimeZonePtr>
+DateTime<typename DateTime<Duration, TimeZonePtr>::CommonDuration> DateTime<Duration, TimeZonePtr>::Parse(const std::string &dateString, const std::string &format) {
+	date::local_time<CommonDuration> tp;
+	ParseLocal(dateString, format, tp);
 	auto zt = date::make_zoned(date::current_zone(), tp);
 	return {zt};
 }
 
-template<class Duration>
-bool DateTime<Duration>::TryParse(const std::string &dateString, const std::string &format, DateTime<CommonDuration> &dateTime) {
-	date::local_seconds tp;
-	std::istringstream ss(dateString);
-	ss >> date::parse(format, tp);
-	if (ss.fail()) return false;
+template<class Duration, class TimeZonePtr>
+bool DateTime<Duration, TimeZonePtr>::TryParse(const std::string &dateString, const std::string &format, DateTime<CommonDuration> &dateTime) {
+	date::local_time<CommonDuration> tp;
+	if (!ParseLocal(dateString, format, tp)) return false;
 	auto zt = date::make_zoned(date::current_zone(), tp);
 	dateTime = {zt};
 	return true;
 }
 
-template<class Duration>
-std::optional<DateTime<typename DateTime<Duration>::CommonDuration>> DateTime<Duration>::TryParse(const std::string &dateString, const std::string &format) {
+template<class Duration, class TimeZonePtr>
+std::optional<DateTime<typename DateTime<Duration, TimeZonePtr>::CommonDuration>> DateTime<Duration, TimeZonePtr>::TryParse(const std::string &dateString, const std::string &format) {
 	DateTime<CommonDuration> dt;
 	if (TryParse(dateString, format, dt))
 		return dt;
 	return {};
 }
 
-template<class Duration>
-Date DateTime<Duration>::Date() const {
+template<class Duration, class TimeZonePtr>
+DateTime<typename DateTime<Duration, TimeZonePtr>::CommonDuration, FixedOffsetZone> DateTime<Duration, TimeZonePtr>::ParseOffset(const std::string &dateString, const std::string &format) {
+	DateTime<CommonDuration, FixedOffsetZone> dt;
+	if (!TryParseOffset(dateString, format, dt))
+		throw std::invalid_argument("unable to parse " + dateString + " with a UTC offset");
+	return dt;
+}
+
+template<class Duration, class TimeZonePtr>
+bool DateTime<Duration, TimeZonePtr>::TryParseOffset(const std::string &dateString, const std::string &format, DateTime<CommonDuration, FixedOffsetZone> &dateTime) {
+	date::detail::add_stat(date::detail::stat_id::parse_calls);
+	date::detail::add_stat(date::detail::stat_id::parse_bytes, dateString.size());
+	constexpr auto none = std::chrono::minutes::min();
+	// FixedOffsetZone throws for offsets of a day or more, which are parse failures here
+	auto fits = [](std::chrono::minutes offset) { return offset > -date::days(1) && offset < date::days(1); };
+	date::local_time<CommonDuration> tp;
+	auto offset = none;
+	std::optional<FixedOffsetZone> zone;
+	if (detail::FastParse(dateString, format, tp, &offset)) {
+		if (fits(offset))
+			zone = FixedOffsetZone(offset);
+	} else {
+		std::istringstream ss(dateString);
+		std::string abbrev;
+		ss >> date::parse(detail::ExpandFormat(format), tp, abbrev, offset);
+		// Text left over, such as the :30 of +05:30 under %z, would change the instant
+		if (ss.fail() || ss.peek() != std::char_traits<char>::eof())
+			return false;
+		if (fits(offset))
+			zone = FixedOffsetZone(offset);
+		else if (offset == none && !abbrev.empty())
+			zone = FixedOffsetZone::FromName(abbrev);
+	}
+	if (!zone)
+		return false;
+	dateTime = DateTime<CommonDuration, FixedOffsetZone>(date::zoned_time<CommonDuration, FixedOffsetZone>(*zone, tp));
+	return true;
+}
+
+template<class Duration, class TimeZonePtr>
+bool DateTime<Duration, TimeZonePtr>::ParseLocal(const std::string &dateString, const std::string &format, date::local_time<CommonDuration> &tp) {
+	date::detail::add_stat(date::detail::stat_id::parse_calls);
+	date::detail::add_stat(date::detail::stat_id::parse_bytes, dateString.size());
+	if (detail::FastParse(dateString, format, tp))
+		return true;
+	std::istringstream ss(dateString);
+	ss >> date::parse(detail::ExpandFormat(format), tp);
+	return !ss.fail();
+}
+
+template<class Duration, class TimeZonePtr>
+Date DateTime<Duration, TimeZonePtr>::Date() const {
 	return FieldsYmdTime().ymd;
 }
 
-template<class Duration>
-date::year DateTime<Duration>::Year() const {
+template<class Duration, class TimeZonePtr>
+date::year DateTime<Duration, TimeZonePtr>::Year() const {
 	return Date().Year();
 }
 
-template<class Duration>
-date::month DateTime<Duration>::Month() const {
+template<class Duration, class TimeZonePtr>
+date::month DateTime<Duration, TimeZonePtr>::Month() const {
 	return Date().Month();
 }
 
-template<class Duration>
-date::day DateTime<Duration>::Day() const {
+template<class Duration, class TimeZonePtr>
+date::day DateTime<Duration, TimeZonePtr>::Day() const {
 	return Date().Day();
 }
 
-template<class Duration>
-const date::time_zone *DateTime<Duration>::Timezone() const {
+template<class Duration, class TimeZonePtr>
+unsigned DateTime<Duration, TimeZonePtr>::Weekday() const {
+	return Date().Weekday();
+}
+
+template<class Duration, class TimeZonePtr>
+unsigned DateTime<Duration, TimeZonePtr>::IsoWeekday() const {
+	return Date().IsoWeekday();
+}
+
+template<class Duration, class TimeZonePtr>
+unsigned DateTime<Duration, TimeZonePtr>::DayOfYear() const {
+	return Date().DayOfYear();
+}
+
+template<class Duration, class TimeZonePtr>
+unsigned DateTime<Duration, TimeZonePtr>::Quarter() const {
+	return Date().Quarter();
+}
+
+template<class Duration, class TimeZonePtr>
+unsigned DateTime<Duration, TimeZonePtr>::IsoWeek() const {
+	return Date().IsoWeek();
+}
+
+template<class Duration, class TimeZonePtr>
+date::year DateTime<Duration, TimeZonePtr>::IsoWeekYear() const {
+	return Date().IsoWeekYear();
+}
+
+template<class Duration, class TimeZonePtr>
+TimeZonePtr DateTime<Duration, TimeZonePtr>::Timezone() const {
 	return _zt.get_time_zone();
 }
 
-template<class Duration>
-const std::string &DateTime<Duration>::TzInfo() const {
+template<class Duration, class TimeZonePtr>
+decltype(auto) DateTime<Duration, TimeZonePtr>::TzInfo() const {
 	return _zt.get_time_zone()->name();
 }
 
-template<class Duration>
-TimeDelta DateTime<Duration>::UtcOffset() const {
-	auto offset = ZonedTime().get_info().offset;
+template<class Duration, class TimeZonePtr>
+TimeDelta DateTime<Duration, TimeZonePtr>::UtcOffset() const {
+	auto offset = Timezone()->get_info_view(_zt.get_sys_time()).offset;
 	return {std::chrono::seconds{offset}};
 }
 
-template<class Duration>
-std::string DateTime<Duration>::Timestamp() const {
+template<class Duration, class TimeZonePtr>
+std::string DateTime<Duration, TimeZonePtr>::Timestamp() const {
 	std::stringstream ss;
 	ss << std::fixed << ZonedTime().get_sys_time().time_since_epoch().count() / 1000000000.0;
 	return ss.str();
 }
 
-template<class Duration>
-std::string DateTime<Duration>::Format(std::string_view format) const {
-	return date::format(format.data(), _zt);
+template<class Duration, class TimeZonePtr>
+std::string DateTime<Duration, TimeZonePtr>::Format(std::string_view format) const {
+	char buffer[128];
+	date::detail::add_stat(date::detail::stat_id::format_calls);
+	if (auto end = FastFormat(format, buffer, buffer + sizeof(buffer))) {
+		date::detail::add_stat(date::detail::stat_id::format_bytes, static_cast<std::uint64_t>(end - buffer));
+		return std::string(buffer, end);
+	}
+	auto formatted = date::format(detail::ExpandFormat(format), _zt);
+	date::detail::add_stat(date::detail::stat_id::format_bytes, formatted.size());
+	return formatted;
+}
+
+template<class Duration, class TimeZonePtr>
+template<class OutputIt>
+OutputIt DateTime<Duration, TimeZonePtr>::FormatTo(OutputIt out, std::string_view format) const {
+	char buffer[128];
+	date::detail::add_stat(date::detail::stat_id::format_calls);
+	if (auto end = FastFormat(format, buffer, buffer + sizeof(buffer))) {
+		date::detail::add_stat(date::detail::stat_id::format_bytes, static_cast<std::uint64_t>(end - buffer));
+		return std::copy(buffer, end, out);
+	}
+	auto formatted = date::format(detail::ExpandFormat(format), _zt);
+	date::detail::add_stat(date::detail::stat_id::format_bytes, formatted.size());
+	return std::copy(formatted.begin(), formatted.end(), out);
+}
+
+template<class Duration, class TimeZonePtr>
+char *DateTime<Duration, TimeZonePtr>::FastFormat(std::string_view format, char *out, char *end) const {
+	auto tp = _zt.get_sys_time();
+	// A FixedOffsetZone holds the abbreviation of the view, keep it until formatting is done.
+	auto zone = Timezone();
+	auto info = zone->get_info_view(tp);
+	return detail::FastFormat(format, date::local_time<CommonDuration>((tp + info.offset).time_since_epoch()), info.offset, info.abbrev, out, end);
 }
 
-template<class Duration>
-date::fields<typename DateTime<Duration>::CommonDuration> DateTime<Duration>::FieldsYmdTime() const {
+template<class Duration, class TimeZonePtr>
+date::fields<typename DateTime<Duration, TimeZonePtr>::CommonDuration> DateTime<Duration, TimeZonePtr>::FieldsYmdTime() const {
 	auto tp = ZonedTime().get_local_time();
 	auto ld = date::floor<date::days>(tp);
 	date::fields<CommonDuration> fds{date::year_month_day{ld}, date::time_of_day<CommonDuration>{tp - ld}};
 	return fds;
 }
 
-template<class Duration>
-DateTime<Duration> operator+(const DateTime<Duration> &x, const TimeDelta &y) {
+template<class Duration, class TimeZonePtr>
+DateTime<Duration, TimeZonePtr> operator+(const DateTime<Duration, TimeZonePtr> &x, const TimeDelta &y) {
 	// TODO make this work for non default Duration
 	auto add = x.ZonedTime().get_sys_time() + std::chrono::seconds(y.TotalSeconds()) + std::chrono::microseconds(y.Microseconds());
 	return {date::make_zoned(x.ZonedTime().get_time_zone(), add)};
 }
 
-template<class Duration>
-DateTime<Duration> operator+(const TimeDelta &y, const DateTime<Duration> &x) {
+template<class Duration, class TimeZonePtr>
+DateTime<Duration, TimeZonePtr> operator+(const TimeDelta &y, const DateTime<Duration, TimeZonePtr> &x) {
 	return x + y;
 }
 
-template<class Duration>
-DateTime<Duration> operator-(const DateTime<Duration> &x, const TimeDelta &y) {
+template<class Duration, class TimeZonePtr>
+DateTime<Duration, TimeZonePtr> operator-(const DateTime<Duration, TimeZonePtr> &x, const TimeDelta &y) {
 	auto diff = x.ZonedTime().get_sys_time() - std::chrono::seconds(y.TotalSeconds()) - std::chrono::microseconds(y.Microseconds());
 	return {date::make_zoned(x.ZonedTime().get_time_zone(), diff)};
 }
 
-template<class Duration>
-TimeDelta operator-(const DateTime<Duration> &x, const DateTime<Duration> &y) {
+template<class Duration, class TimeZonePtr1, class TimeZonePtr2>
+TimeDelta operator-(const DateTime<Duration, TimeZonePtr1> &x, const DateTime<Duration, TimeZonePtr2> &y) {
 	return {x.ZonedTime().get_sys_time() - y.ZonedTime().get_sys_time()};
 }
 
-template<class Duration1, class Duration2>
-bool operator==(const DateTime<Duration1> &x, const DateTime<Duration2> &y) {
+template<class Duration1, class TimeZonePtr1, class Duration2, class TimeZonePtr2>
+bool operator==(const DateTime<Duration1, TimeZonePtr1> &x, const DateTime<Duration2, TimeZonePtr2> &y) {
 	return x.ZonedTime().get_sys_time() == y.ZonedTime().get_sys_time();
 }
 
-template<class Duration1, class Duration2>
-bool operator!=(const DateTime<Duration1> &x, const DateTime<Duration2> &y) {
+template<class Duration1, class TimeZonePtr1, class Duration2, class TimeZonePtr2>
+bool operator!=(const DateTime<Duration1, TimeZonePtr1> &x, const DateTime<Duration2, TimeZonePtr2> &y) {
 	return x.ZonedTime().get_sys_time() != y.ZonedTime().get_sys_time();
 }
 
-template<class Duration1, class Duration2>
-bool operator<(const DateTime<Duration1> &x, const DateTime<Duration2> &y) {
+template<class Duration1, class TimeZonePtr1, class Duration2, class TimeZonePtr2>
+bool operator<(const DateTime<Duration1, TimeZonePtr1> &x, const DateTime<Duration2, TimeZonePtr2> &y) {
 	return x.ZonedTime().get_sys_time() < y.ZonedTime().get_sys_time();
 }
 
-template<class Duration1, class Duration2>
-bool operator<=(const DateTime<Duration1> &x, const DateTime<Duration2> &y) {
+template<class Duration1, class TimeZonePtr1, class Duration2, class TimeZonePtr2>
+bool operator<=(const DateTime<Duration1, TimeZonePtr1> &x, const DateTime<Duration2, TimeZonePtr2> &y) {
 	return x.ZonedTime().get_sys_time() <= y.ZonedTime().get_sys_time();
 }
 
-template<class Duration1, class Duration2>
-bool operator>(const DateTime<Duration1> &x, const DateTime<Duration2> &y) {
+template<class Duration1, class TimeZonePtr1, class Duration2, class TimeZonePtr2>
+bool operator>(const DateTime<Duration1, TimeZonePtr1> &x, const DateTime<Duration2, TimeZonePtr2> &y) {
 	return x.ZonedTime().get_sys_time() > y.ZonedTime().get_sys_time();
 }
 
-template<class Duration1, class Duration2>
-bool operator>=(const DateTime<Duration1> &x, const DateTime<Duration2> &y) {
+template<class Duration1, class TimeZonePtr1, class Duration2, class TimeZonePtr2>
+bool operator>=(const DateTime<Duration1, TimeZonePtr1> &x, const DateTime<Duration2, TimeZonePtr2> &y) {
 	return x.ZonedTime().get_sys_time() >= y.ZonedTime().get_sys_time();
 }
 
-template<class CharT, class Traits, class Duration>
-std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os, const DateTime<Duration> &date) {
+template<class CharT, class Traits, class Duration, class TimeZonePtr>
+std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os, const DateTime<Duration, TimeZonePtr> &date) {
 	return os << date.ZonedTime();
 }
 }
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <date/date.h>
+
+#include "DateFormats.hpp"
+
+namespace datetime::detail {
+/// Rewrites the "%s" fractional seconds command into "%S", date::format and date::parse
+/// already print and read the fraction for any sub-second Duration.
+inline std::string ExpandFormat(std::string_view format) {
+	std::string result(format);
+	for (std::size_t i = 0; i + 1 < result.size(); ++i) {
+		if (result[i] != '%')
+			continue;
+		if (result[i + 1] == 's')
+			result[i + 1] = 'S';
+		++i; // skip the command character so "%%s" stays literal
+	}
+	return result;
+}
+
+inline bool ParseDigits(const char *&it, const char *end, int count, int &value) {
+	if (end - it < count)
+		return false;
+	int v = 0;
+	for (int i = 0; i < count; ++i) {
+		auto d = static_cast<unsigned>(it[i] - '0');
+		if (d > 9)
+			return false;
+		v = 10 * v + static_cast<int>(d);
+	}
+	it += count;
+	value = v;
+	return true;
+}
+
+/// Reads a UTC offset in minutes east of UTC the way date::parse reads %z, +hh or +hhmm,
+/// stopping before anything else. With colon set +hh:mm is read as well, the form of %Ez,
+/// and with zulu set Z.
+inline bool ParseOffset(const char *&it, const char *end, std::chrono::minutes &offset, bool zulu, bool colon) {
+	if (zulu && it != end && *it == 'Z') {
+		++it;
+		offset = std::chrono::minutes(0);
+		return true;
+	}
+	if (it == end || (*it != '+' && *it != '-'))
+		return false;
+	auto sign = *it++ == '-' ? -1 : 1;
+	int hh, mm = 0;
+	if (!ParseDigits(it, end, 2, hh))
+		return false;
+	if (colon && it != end && *it == ':') {
+		if (!ParseDigits(++it, end, 2, mm))
+			return false;
+	} else if (it != end && static_cast<unsigned>(*it - '0') <= 9 && !ParseDigits(it, end, 2, mm)) {
+		return false;
+	}
+	if (mm > 59)
+		return false;
+	offset = std::chrono::minutes(sign * (hh * 60 + mm));
+	return true;
+}
+
+/// The digits have already been validated, a constant N lets the compiler unroll this.
+template<int N>
+std::int64_t FixedDigits(const char *it) {
+	std::int64_t v = 0;
+	for (int i = 0; i < N; ++i)
+		v = 10 * v + (it[i] - '0');
+	return v;
+}
+
+/// The fraction digits date::format prints for Duration, -1 when it is not a power of ten.
+template<class Duration>
+constexpr int FractionDigits() {
+	std::intmax_t den = Duration::period::den;
+	int digits = 0;
+	for (; den % 10 == 0; den /= 10)
+		++digits;
+	return den == 1 ? digits : -1;
+}
+
+/// Converts a fraction of up to 9 digits. Callers pass no more digits than Duration holds,
+/// so truncating to Duration is exact.
+template<class Duration>
+Duration ParseFraction(const char *it, int digits) {
+	switch (digits) {
+	case 3:
+		return date::floor<Duration>(std::chrono::milliseconds(FixedDigits<3>(it)));
+	case 6:
+		return date::floor<Duration>(std::chrono::microseconds(FixedDigits<6>(it)));
+	case 9:
+		return date::floor<Duration>(std::chrono::nanoseconds(FixedDigits<9>(it)));
+	default: {
+		std::int64_t v = 0;
+		for (int i = 0; i < 9; ++i)
+			v = 10 * v + (i < digits ? it[i] - '0' : 0);
+		return date::floor<Duration>(std::chrono::nanoseconds(v));
+	}
+	}
+}
+
+/// Single pass parser for ISO8601_FORMAT, ISO8601_FRAC_FORMAT and SORTABLE_FORMAT.
+/// Returns false for any input it does not fully recognise, the caller then falls back
+/// to date::parse which decides how to handle it. The UTC offset of ISO 8601 text is
+/// stored in offset when it is given, other formats leave it alone. The offset follows %z,
+/// +hh:mm is left to date::parse, and only when offset is given is Z read as well.
+template<class Duration>
+bool FastParse(std::string_view str, std::string_view format, date::local_time<Duration> &tp, std::chrono::minutes *offset = nullptr) {
+	bool iso = format == ISO8601_FORMAT || format == ISO8601_FRAC_FORMAT;
+	if (!iso && format != SORTABLE_FORMAT)
+		return false;
+
+	auto it = str.data();
+	auto end = it + str.size();
+	int y, m, d, hh, mm, ss;
+	if (!ParseDigits(it, end, 4, y) || it == end || *it++ != '-' ||
+		!ParseDigits(it, end, 2, m) || it == end || *it++ != '-' ||
+		!ParseDigits(it, end, 2, d) || it == end || *it++ != (iso ? 'T' : ' ') ||
+		!ParseDigits(it, end, 2, hh) || it == end || *it++ != ':' ||
+		!ParseDigits(it, end, 2, mm) || it == end || *it++ != ':' ||
+		!ParseDigits(it, end, 2, ss))
+		return false;
+
+	date::year_month_day ymd{date::year(y), date::month(static_cast<unsigned>(m)), date::day(static_cast<unsigned>(d))};
+	if (!ymd.ok() || hh > 23 || mm > 59 || ss > 59)
+		return false;
+
+	Duration frac{};
+	if (it != end && *it == '.') {
+		if constexpr (Duration::period::den == 1) {
+			return false;
+		} else {
+			auto first = ++it;
+			while (it != end && static_cast<unsigned>(*it - '0') <= 9)
+				++it;
+			// date::parse reads no more digits than Duration prints and leaves the rest, which
+			// a following command then rejects, so longer fractions are left to it.
+			auto digits = static_cast<int>(it - first);
+			if (digits == 0 || digits > std::min(FractionDigits<Duration>(), 9))
+				return false;
+			frac = ParseFraction<Duration>(first, digits);
+		}
+	}
+
+	if (iso) {
+		// The offset is not applied, matching date::parse into a local_time.
+		std::chrono::minutes parsed;
+		if (!ParseOffset(it, end, parsed, offset != nullptr, false))
+			return false;
+		if (offset != nullptr)
+			*offset = parsed;
+	}
+	if (it != end)
+		return false;
+
+	tp = date::local_days(ymd) + std::chrono::hours(hh) + std::chrono::minutes(mm) + std::chrono::seconds(ss) + frac;
+	return true;
+}
+
+/// Writes value as exactly width digits, value is below 10^width.
+inline char *FormatDigits(char *out, std::uint64_t value, int width) {
+	for (int i = width - 1; i >= 0; --i) {
+		out[i] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	}
+	return out + width;
+}
+
+/// Single pass formatter for the numeric commands %Y %y %m %d %e %H %M %S %s %F %T %z, the
+/// zone abbreviation %Z and %%, which covers ISO8601_FORMAT, ISO8601_FRAC_FORMAT and
+/// SORTABLE_FORMAT. Writes the text date::format produces into [out, end) without allocating
+/// and returns its end, or nullptr for any other command, a year outside [0, 9999] or a buffer
+/// that is too small, the caller then falls back to date::format.
+template<class Duration>
+char *FastFormat(std::string_view format, date::local_time<Duration> tp, std::chrono::seconds offset, std::string_view abbrev, char *out, char *end) {
+	constexpr int fractionDigits = FractionDigits<Duration>();
+	if constexpr (!std::is_integral<typename Duration::rep>::value || fractionDigits < 0 || fractionDigits > 18) {
+		return nullptr;
+	} else {
+		auto day = date::floor<date::days>(tp);
+		date::year_month_day ymd{day};
+		auto y = static_cast<int>(ymd.year());
+		if (y < 0 || y > 9999)
+			return nullptr;
+		auto tod = tp - day;
+		auto seconds = date::floor<std::chrono::seconds>(tod);
+		auto hh = static_cast<std::uint64_t>(seconds.count() / 3600);
+		auto mm = static_cast<std::uint64_t>(seconds.count() / 60 % 60);
+		auto ss = static_cast<std::uint64_t>(seconds.count() % 60);
+		auto fraction = static_cast<std::uint64_t>((tod - seconds).count());
+		// date::format truncates an offset with seconds, such as local mean time, towards zero.
+		auto offsetMinutes = std::chrono::duration_cast<std::chrono::minutes>(offset).count();
+		if (offsetMinutes <= -6000 || offsetMinutes >= 6000)
+			return nullptr;
+
+		// Longest expansion of a command, %T with a fraction or %Z.
+		const std::size_t widest = std::max<std::size_t>(9 + 18, abbrev.size());
+		for (std::size_t i = 0; i < format.size(); ++i) {
+			if (static_cast<std::size_t>(end - out) < widest + 1)
+				return nullptr;
+			if (format[i] != '%') {
+				*out++ = format[i];
+				continue;
+			}
+			if (++i == format.size())
+				return nullptr;
+			switch (format[i]) {
+			case 'Y':
+				out = FormatDigits(out, static_cast<std::uint64_t>(y), 4);
+				break;
+			case 'y':
+				out = FormatDigits(out, static_cast<std::uint64_t>(y % 100), 2);
+				break;
+			case 'm':
+				out = FormatDigits(out, static_cast<unsigned>(ymd.month()), 2);
+				break;
+			case 'd':
+				out = FormatDigits(out, static_cast<unsigned>(ymd.day()), 2);
+				break;
+			case 'e':
+				out = FormatDigits(out, static_cast<unsigned>(ymd.day()), 2);
+				if (out[-2] == '0')
+					out[-2] = ' ';
+				break;
+			case 'F':
+				out = FormatDigits(out, static_cast<std::uint64_t>(y), 4);
+				*out++ = '-';
+				out = FormatDigits(out, static_cast<unsigned>(ymd.month()), 2);
+				*out++ = '-';
+				out = FormatDigits(out, static_cast<unsigned>(ymd.day()), 2);
+				break;
+			case 'H':
+				out = FormatDigits(out, hh, 2);
+				break;
+			case 'M':
+				out = FormatDigits(out, mm, 2);
+				break;
+			case 'T':
+				out = FormatDigits(out, hh, 2);
+				*out++ = ':';
+				out = FormatDigits(out, mm, 2);
+				*out++ = ':';
+				[[fallthrough]];
+			case 'S':
+			case 's':
+				out = FormatDigits(out, ss, 2);
+				if constexpr (fractionDigits > 0) {
+					*out++ = '.';
+					out = FormatDigits(out, fraction, fractionDigits);
+				}
+				break;
+			case 'z': {
+				*out++ = offsetMinutes < 0 ? '-' : '+';
+				auto minutes = static_cast<std::uint64_t>(offsetMinutes < 0 ? -offsetMinutes : offsetMinutes);
+				out = FormatDigits(out, minutes / 60, 2);
+				out = FormatDigits(out, minutes % 60, 2);
+				break;
+			}
+			case 'Z':
+				for (auto c : abbrev)
+					*out++ = c;
+				break;
+			case '%':
+				*out++ = '%';
+				break;
+			default:
+				return nullptr;
+			}
+		}
+		return out;
+	}
+}
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <date/tz.h>
+
+#include "DateTimeParse.hpp"
+
+namespace datetime {
+/// A zone at a constant offset from UTC, the +05:30 of 2005-01-01T12:00:00+05:30. It is its own
+/// TimeZonePtr for date::zoned_time and DateTime: a small value holding the offset and its
+/// abbreviation, rendered once, so conversions are an addition or a subtraction and nothing
+/// touches the tz database.
+///
+/// The abbreviation printed for %Z is "UTC" for a zero offset and +hhmm otherwise. The name is
+/// "UTC" or +hh:mm, zoned_traits locates zones by any name FromName reads.
+class FixedOffsetZone {
+	template<class Duration>
+	using Common = typename std::common_type<Duration, std::chrono::seconds>::type;
+public:
+	/// UTC.
+	FixedOffsetZone() :
+		FixedOffsetZone(std::chrono::minutes(0)) {
+	}
+
+	/// Offsets of a day or more throw std::out_of_range.
+	explicit FixedOffsetZone(std::chrono::minutes offset) :
+		_offset(static_cast<std::int32_t>(offset.count())) {
+		if (offset <= -date::days(1) || offset >= date::days(1))
+			throw std::out_of_range("UTC offset must be less than a day");
+		if (_offset == 0) {
+			_abbrev = {'U', 'T', 'C'};
+			_length = 3;
+			return;
+		}
+		auto minutes = static_cast<unsigned>(std::abs(_offset));
+		_abbrev = {_offset < 0 ? '-' : '+', Digit(minutes / 600), Digit(minutes / 60 % 10), Digit(minutes % 60 / 10), Digit(minutes % 10)};
+		_length = 5;
+	}
+
+	std::chrono::minutes Offset() const { return std::chrono::minutes(_offset); }
+
+	std::string_view Abbreviation() const { return {_abbrev.data(), _length}; }
+
+	std::string name() const {
+		if (_offset == 0)
+			return "UTC";
+		return {_abbrev[0], _abbrev[1], _abbrev[2], ':', _abbrev[3], _abbrev[4]};
+	}
+
+	template<class Duration>
+	date::local_time<Common<Duration>> to_local(date::sys_time<Duration> tp) const {
+		return date::local_time<Common<Duration>>(tp.time_since_epoch() + Offset());
+	}
+
+	template<class Duration>
+	date::sys_time<Common<Duration>> to_sys(date::local_time<Duration> tp) const {
+		return date::sys_time<Common<Duration>>(tp.time_since_epoch() - Offset());
+	}
+
+	/// Every local time exists exactly once, whatever the choice.
+	template<class Duration>
+	date::sys_time<Common<Duration>> to_sys(date::local_time<Duration> tp, date::choose) const { return to_sys(tp); }
+
+	template<class Duration>
+	date::sys_info get_info(date::sys_time<Duration>) const {
+		return {Begin(), End(), Offset(), std::chrono::minutes(0), std::string(Abbreviation())};
+	}
+
+	template<class Duration>
+	date::local_info get_info(date::local_time<Duration>) const {
+		return {date::local_info::unique, get_info(date::sys_seconds()), {}};
+	}
+
+	/// The info without copying the abbreviation, which lives in this object.
+	template<class Duration>
+	date::sys_info_view get_info_view(date::sys_time<Duration>) const {
+		return {Begin(), End(), Offset(), std::chrono::minutes(0), Abbreviation()};
+	}
+
+	const FixedOffsetZone *operator->() const { return this; }
+	const FixedOffsetZone &operator*() const { return *this; }
+
+	friend bool operator==(const FixedOffsetZone &x, const FixedOffsetZone &y) { return x._offset == y._offset; }
+	friend bool operator!=(const FixedOffsetZone &x, const FixedOffsetZone &y) { return x._offset != y._offset; }
+
+	/// Reads "UTC", "GMT", Z, +hh, +hhmm or +hh:mm, nullopt for anything else.
+	static std::optional<FixedOffsetZone> FromName(std::string_view name) {
+		if (name == "UTC" || name == "GMT")
+			return FixedOffsetZone();
+		auto it = name.data();
+		auto end = it + name.size();
+		std::chrono::minutes offset;
+		if (!detail::ParseOffset(it, end, offset, true, true) || it != end || offset <= -date::days(1) || offset >= date::days(1))
+			return std::nullopt;
+		return FixedOffsetZone(offset);
+	}
+
+private:
+	static char Digit(unsigned value) { return static_cast<char>('0' + value); }
+
+	static date::sys_seconds Begin() { return date::sys_days(date::year::min() / date::January / 1); }
+	static date::sys_seconds End() { return date::sys_days(date::year::max() / date::December / 31); }
+
+	std::int32_t _offset;
+	std::array<char, 5> _abbrev{};
+	std::uint8_t _length;
+};
+}
+
+namespace date {
+template<>
+struct zoned_traits<datetime::FixedOffsetZone> {
+	static datetime::FixedOffsetZone default_zone() { return {}; }
+
+	/// Names FromName reads, others throw std::invalid_argument.
+	static datetime::FixedOffsetZone locate_zone(std::string_view name) {
+		if (auto zone = datetime::FixedOffsetZone::FromName(name))
+			return *zone;
+		throw std::invalid_argument(std::string(name) + " is not a UTC offset");
+	}
+};
+}
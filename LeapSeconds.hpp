@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "DateTime.hpp"
+
+namespace datetime {
+/// Converts between sys, utc, tai and gps time without searching the tzdb leap second list
+/// on every call. The insertion dates are copied into flat arrays of seconds, in sys time
+/// and in utc time, where the position of an instant is its cumulative leap second count.
+///
+/// Instants after the last leap second, nearly every one in practice, are recognised with a
+/// single comparison. Spans are converted with a cursor that starts from the entry of the
+/// previous element, so sorted or clustered input costs a comparison or two per element.
+/// Results match utc_clock, tai_clock and gps_clock, including instants during a leap second.
+class LeapSeconds {
+	template<class Duration>
+	using Common = typename std::common_type<Duration, std::chrono::seconds>::type;
+public:
+	/// Uses the leap seconds of the current tzdb.
+	LeapSeconds() :
+		LeapSeconds(date::get_tzdb().leap_seconds) {
+	}
+
+	explicit LeapSeconds(const std::vector<date::leap_second> &leaps) {
+		_sysDates.reserve(leaps.size());
+		_utcStarts.reserve(leaps.size());
+		for (const auto &leap : leaps) {
+			auto date = leap.date().time_since_epoch().count();
+			// Leap second k is inserted at utc D + k, after the k earlier ones.
+			_utcStarts.push_back(date + static_cast<std::int64_t>(_sysDates.size()));
+			_sysDates.push_back(date);
+		}
+	}
+
+	std::size_t Size() const { return _sysDates.size(); }
+
+	/// Leap seconds inserted up to t.
+	template<class Duration>
+	std::chrono::seconds Elapsed(date::sys_time<Duration> t) const {
+		std::size_t hint = Size();
+		return std::chrono::seconds(Count(_sysDates, t.time_since_epoch(), hint));
+	}
+
+	template<class Duration>
+	date::utc_time<Common<Duration>> ToUtc(date::sys_time<Duration> t) const {
+		std::size_t hint = Size();
+		return ToUtc(t, hint);
+	}
+
+	template<class Duration>
+	date::tai_time<Common<Duration>> ToTai(date::sys_time<Duration> t) const { return date::tai_clock::from_utc(ToUtc(t)); }
+
+	template<class Duration>
+	date::gps_time<Common<Duration>> ToGps(date::sys_time<Duration> t) const { return date::gps_clock::from_utc(ToUtc(t)); }
+
+	template<class Duration>
+	date::sys_time<Common<Duration>> ToSys(date::utc_time<Duration> t) const {
+		std::size_t hint = Size();
+		return ToSys(t, hint);
+	}
+
+	template<class Duration>
+	date::sys_time<Common<Duration>> ToSys(date::tai_time<Duration> t) const { return ToSys(date::tai_clock::to_utc(t)); }
+
+	template<class Duration>
+	date::sys_time<Common<Duration>> ToSys(date::gps_time<Duration> t) const { return ToSys(date::gps_clock::to_utc(t)); }
+
+	/// Converts the sys times of [first, last) into out.
+	template<class InputIt, class OutputIt>
+	OutputIt ToUtc(InputIt first, InputIt last, OutputIt out) const {
+		std::size_t hint = Size();
+		for (; first != last; ++first)
+			*out++ = ToUtc(*first, hint);
+		return out;
+	}
+
+	template<class InputIt, class OutputIt>
+	OutputIt ToTai(InputIt first, InputIt last, OutputIt out) const {
+		std::size_t hint = Size();
+		for (; first != last; ++first)
+			*out++ = date::tai_clock::from_utc(ToUtc(*first, hint));
+		return out;
+	}
+
+	template<class InputIt, class OutputIt>
+	OutputIt ToGps(InputIt first, InputIt last, OutputIt out) const {
+		std::size_t hint = Size();
+		for (; first != last; ++first)
+			*out++ = date::gps_clock::from_utc(ToUtc(*first, hint));
+		return out;
+	}
+
+	/// Converts the utc, tai or gps times of [first, last) into sys times in out.
+	template<class InputIt, class OutputIt>
+	OutputIt ToSys(InputIt first, InputIt last, OutputIt out) const {
+		std::size_t hint = Size();
+		for (; first != last; ++first)
+			*out++ = ToSys(AsUtc(*first), hint);
+		return out;
+	}
+
+private:
+	template<class Duration>
+	static date::utc_time<Duration> AsUtc(date::utc_time<Duration> t) { return t; }
+	template<class Duration>
+	static date::utc_time<Common<Duration>> AsUtc(date::tai_time<Duration> t) { return date::tai_clock::to_utc(t); }
+	template<class Duration>
+	static date::utc_time<Common<Duration>> AsUtc(date::gps_time<Duration> t) { return date::gps_clock::to_utc(t); }
+
+	/// The number of entries of table at or before t, moving hint to it. Entries are whole seconds.
+	template<class Duration>
+	static std::size_t Count(const std::vector<std::int64_t> &table, Duration t, std::size_t &hint) {
+		using Ticks = Common<Duration>;
+		constexpr auto perSecond = std::chrono::duration_cast<Ticks>(std::chrono::seconds(1)).count();
+		auto ticks = Ticks(t).count();
+		if ((hint == 0 || table[hint - 1] * perSecond <= ticks) && (hint == table.size() || ticks < table[hint] * perSecond))
+			return hint;
+		hint = static_cast<std::size_t>(std::upper_bound(table.begin(), table.end(), ticks,
+			[](decltype(ticks) x, std::int64_t entry) { return x < entry * perSecond; }) - table.begin());
+		return hint;
+	}
+
+	template<class Duration>
+	date::utc_time<Common<Duration>> ToUtc(date::sys_time<Duration> t, std::size_t &hint) const {
+		auto count = Count(_sysDates, t.time_since_epoch(), hint);
+		return date::utc_time<Common<Duration>>(t.time_since_epoch() + std::chrono::seconds(count));
+	}
+
+	template<class Duration>
+	date::sys_time<Common<Duration>> ToSys(date::utc_time<Duration> t, std::size_t &hint) const {
+		using Ticks = Common<Duration>;
+		auto count = Count(_utcStarts, t.time_since_epoch(), hint);
+		// During an inserted second the result stays on the last tick before the leap date.
+		if (count > 0 && t.time_since_epoch() < std::chrono::seconds(_utcStarts[count - 1] + 1))
+			return date::sys_time<Ticks>(std::chrono::seconds(_sysDates[count - 1])) - Ticks(1);
+		return date::sys_time<Ticks>(t.time_since_epoch() - std::chrono::seconds(count));
+	}
+
+	std::vector<std::int64_t> _sysDates;
+	std::vector<std::int64_t> _utcStarts;
+};
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Bits.hpp"
+#include "DateRange.hpp"
+
+namespace datetime {
+/// Evaluates local time predicates of a zone over columns of UTC instants, writing one bit per
+/// row. The conditions set on the filter are combined with AND, a filter without conditions
+/// matches every row.
+///
+/// Rows are processed in blocks of 64. When a block lies within one constant offset period of
+/// the zone, its local time of day and weekday are computed in straight line loops over 32 bit
+/// ticks that the compiler vectorizes. Columns finer than milliseconds cannot hold a day in 32
+/// bit ticks and are floored to seconds first, which loses nothing as every bound is a whole
+/// second. Blocks that straddle a transition or are too spread out for 32 bits take a per row path.
+class LocalTimeFilter {
+public:
+	explicit LocalTimeFilter(const date::time_zone *zone) :
+		_zone(zone) {
+		if (_zone == nullptr)
+			throw std::invalid_argument("LocalTimeFilter needs a time zone");
+	}
+
+	/// Local time of day in [from, to), wrapping past midnight when from is after to.
+	LocalTimeFilter &TimeOfDay(std::chrono::seconds from, std::chrono::seconds to) {
+		if (from < std::chrono::seconds(0) || from > date::days(1) || to < std::chrono::seconds(0) || to > date::days(1))
+			throw std::invalid_argument("time of day must be within a day");
+		_fromTime = from;
+		_toTime = to;
+		_timeOfDay = true;
+		return *this;
+	}
+
+	LocalTimeFilter &OnWeekdays(std::initializer_list<date::weekday> weekdays) {
+		_weekdays = 0;
+		for (auto wd : weekdays)
+			_weekdays |= 1u << wd.c_encoding();
+		return *this;
+	}
+
+	/// Local dates in [first, last).
+	LocalTimeFilter &Between(const Date &first, const Date &last) {
+		_firstDay = date::sys_days(first.YearMonthDay()).time_since_epoch().count();
+		_lastDay = date::sys_days(last.YearMonthDay()).time_since_epoch().count();
+		_dateRange = true;
+		return *this;
+	}
+
+	/// Only rows where daylight saving time is, or is not, in effect.
+	LocalTimeFilter &InDst(bool dst) {
+		_dst = dst ? Dst::Yes : Dst::No;
+		return *this;
+	}
+
+	/// Sets bit i % 64 of mask[i / 64] for every matching row of [first, last), clearing the
+	/// others including the padding of the last word, and returns how many rows matched.
+	template<class Duration>
+	std::size_t Evaluate(const date::sys_time<Duration> *first, const date::sys_time<Duration> *last, std::uint64_t *mask) const {
+		static_assert(std::is_integral<typename Duration::rep>::value, "columns must use integral ticks");
+		using Ticks = typename Kernel<Duration>::Ticks;
+		static_assert(Kernel<Duration>::ticksPerDay > 0, "columns must be at least as fine as days");
+
+		TimeBounds bounds{std::chrono::duration_cast<Ticks>(_fromTime).count(), std::chrono::duration_cast<Ticks>(_toTime).count()};
+
+		std::size_t rows = static_cast<std::size_t>(last - first);
+		std::size_t matches = 0;
+		date::sys_info_view info{};
+		for (std::size_t block = 0; block * 64 < rows; ++block) {
+			auto data = first + block * 64;
+			auto count = std::min<std::size_t>(64, rows - block * 64);
+			if (!Within(data[0], info))
+				info = _zone->get_info_view(date::floor<std::chrono::seconds>(data[0]));
+			auto word = EvaluateRun(data, count, info, bounds);
+			mask[block] = word;
+			matches += static_cast<std::size_t>(detail::Popcount(word));
+		}
+		return matches;
+	}
+
+	template<class Duration>
+	std::vector<std::uint64_t> Evaluate(const std::vector<date::sys_time<Duration>> &column) const {
+		std::vector<std::uint64_t> mask((column.size() + 63) / 64);
+		Evaluate(column.data(), column.data() + column.size(), mask.data());
+		return mask;
+	}
+
+private:
+	enum class Dst {
+		Any, Yes, No
+	};
+
+	/// The ticks the kernels work in, those of the column unless a day of them overflows 32
+	/// bits, then seconds.
+	template<class Duration>
+	struct Kernel {
+		using Column = std::chrono::duration<std::int64_t, typename Duration::period>;
+		static constexpr bool fine = std::chrono::duration_cast<Column>(date::days(1)).count() > std::numeric_limits<std::int32_t>::max() / 4;
+		using Ticks = typename std::conditional<fine, std::chrono::duration<std::int64_t>, Column>::type;
+		static constexpr std::int64_t ticksPerDay = std::chrono::duration_cast<Ticks>(date::days(1)).count();
+
+		static std::int64_t ToTicks(date::sys_time<Duration> t) {
+			return date::floor<Ticks>(t.time_since_epoch()).count();
+		}
+	};
+
+	/// The time of day bounds in kernel ticks.
+	struct TimeBounds {
+		std::int64_t from;
+		std::int64_t to;
+	};
+
+	template<class Duration>
+	static bool Within(date::sys_time<Duration> t, const date::sys_info_view &info) {
+		// Whole seconds, the first and last periods reach years a fine column cannot hold
+		auto seconds = date::floor<std::chrono::seconds>(t);
+		return seconds >= info.begin && seconds < info.end;
+	}
+
+	static std::int64_t FloorDiv(std::int64_t x, std::int64_t y) { return x / y - ((x % y != 0) && ((x < 0) != (y < 0))); }
+
+	bool DstMatches(const date::sys_info_view &info) const {
+		return _dst == Dst::Any || (_dst == Dst::Yes) == (info.save != std::chrono::minutes(0));
+	}
+
+	/// A block whose first row lies in the offset period info. Ticks are taken relative to the
+	/// local midnight before the first row so every per row quantity fits 32 bits, rows before
+	/// that midnight or outside the period send the block to the per row path.
+	template<class Duration>
+	std::uint64_t EvaluateRun(const date::sys_time<Duration> *data, std::size_t count, const date::sys_info_view &info, const TimeBounds &bounds) const {
+		using K = Kernel<Duration>;
+		using Ticks = typename K::Ticks;
+		constexpr auto ticksPerDay = K::ticksPerDay;
+		auto offset = std::chrono::duration_cast<Ticks>(info.offset).count();
+		auto baseDay = FloorDiv(K::ToTicks(data[0]) + offset, ticksPerDay);
+		auto base = baseDay * ticksPerDay - offset;
+		auto lowest = std::max(base, std::chrono::duration_cast<Ticks>(info.begin.time_since_epoch()).count());
+		auto highest = std::min(base + std::numeric_limits<std::int32_t>::max(), std::chrono::duration_cast<Ticks>(info.end.time_since_epoch()).count());
+
+		std::int32_t relative[64];
+		std::int32_t inside = 1;
+		for (std::size_t k = 0; k < count; ++k) {
+			auto t = K::ToTicks(data[k]);
+			inside &= (t >= lowest) & (t < highest);
+			relative[k] = static_cast<std::int32_t>(t - base);
+		}
+		if (!inside)
+			return EvaluateRows(data, count, info, bounds);
+		if (!DstMatches(info))
+			return 0;
+
+		// Everything the loop reads is a local 32 bit integer, comparisons are combined with
+		// bitwise operators, so the loop has no branches and GCC and Clang vectorize it.
+		const auto baseWeekday = static_cast<std::int32_t>(detail::CWeekday(static_cast<int>(baseDay)));
+		const auto day = static_cast<std::int32_t>(ticksPerDay);
+		const auto inverseDay = 1.0 / static_cast<double>(ticksPerDay);
+		// A wrapping time of day range is the complement of [to, from), no range is [0, 2 days).
+		const std::int32_t wraps = _timeOfDay && bounds.from > bounds.to;
+		const auto from = _timeOfDay ? static_cast<std::int32_t>(wraps ? bounds.to : bounds.from) : 0;
+		const auto to = _timeOfDay ? static_cast<std::int32_t>(wraps ? bounds.from : bounds.to) : 2 * day;
+		const std::int32_t w0 = _weekdays & 1, w1 = (_weekdays >> 1) & 1, w2 = (_weekdays >> 2) & 1, w3 = (_weekdays >> 3) & 1, w4 = (_weekdays >> 4) & 1,
+			w5 = (_weekdays >> 5) & 1, w6 = (_weekdays >> 6) & 1;
+		// The date range becomes a range of relative ticks, clamped to what a block can hold.
+		std::int64_t firstTick = 0, lastTick = std::numeric_limits<std::int32_t>::max();
+		if (_dateRange) {
+			firstTick = std::clamp<std::int64_t>((_firstDay - baseDay) * ticksPerDay, 0, std::numeric_limits<std::int32_t>::max());
+			lastTick = std::clamp<std::int64_t>((_lastDay - baseDay) * ticksPerDay, 0, std::numeric_limits<std::int32_t>::max());
+		}
+		const auto rangeFirst = static_cast<std::int32_t>(firstTick), rangeLast = static_cast<std::int32_t>(lastTick);
+
+		std::uint8_t keep[64];
+		for (std::size_t k = 0; k < count; ++k) {
+			auto rel = relative[k];
+			// Vector units have no integer division. The estimate from a double multiply is
+			// never above the true day and at most one below it.
+			auto days = static_cast<std::int32_t>(static_cast<double>(rel) * inverseDay);
+			auto time = rel - days * day;
+			std::int32_t carry = time >= day;
+			days += carry;
+			time -= carry * day;
+			auto weekday = baseWeekday + days;
+			weekday -= static_cast<std::int32_t>(static_cast<double>(weekday) * (1.0 / 7)) * 7;
+			weekday -= (weekday >= 7) * 7;
+			std::int32_t inTime = ((time >= from) & (time < to)) ^ wraps;
+			std::int32_t inWeekdays = ((weekday == 0) & w0) | ((weekday == 1) & w1) | ((weekday == 2) & w2) | ((weekday == 3) & w3) | ((weekday == 4) & w4)
+				| ((weekday == 5) & w5) | ((weekday == 6) & w6);
+			std::int32_t inRange = (rel >= rangeFirst) & (rel < rangeLast);
+			keep[k] = static_cast<std::uint8_t>(inTime & inWeekdays & inRange);
+		}
+		std::uint64_t word = 0;
+		for (std::size_t k = 0; k < count; ++k)
+			word |= std::uint64_t(keep[k]) << k;
+		return word;
+	}
+
+	/// The per row path, caching the offset period of the previous row, starting with info.
+	template<class Duration>
+	std::uint64_t EvaluateRows(const date::sys_time<Duration> *data, std::size_t count, date::sys_info_view info, const TimeBounds &bounds) const {
+		using K = Kernel<Duration>;
+		using Ticks = typename K::Ticks;
+		constexpr auto ticksPerDay = K::ticksPerDay;
+		std::uint64_t word = 0;
+		for (std::size_t k = 0; k < count; ++k) {
+			if (!Within(data[k], info))
+				info = _zone->get_info_view(date::floor<std::chrono::seconds>(data[k]));
+			if (!DstMatches(info))
+				continue;
+			auto local = K::ToTicks(data[k]) + std::chrono::duration_cast<Ticks>(info.offset).count();
+			auto day = FloorDiv(local, ticksPerDay);
+			auto time = local - day * ticksPerDay;
+			bool inTime = !_timeOfDay || (bounds.from > bounds.to ? time >= bounds.from || time < bounds.to : time >= bounds.from && time < bounds.to);
+			bool onWeekday = (_weekdays >> detail::CWeekday(static_cast<int>(day))) & 1;
+			bool inRange = !_dateRange || (day >= _firstDay && day < _lastDay);
+			if (inTime && onWeekday && inRange)
+				word |= std::uint64_t(1) << k;
+		}
+		return word;
+	}
+
+	const date::time_zone *_zone;
+	bool _timeOfDay = false;
+	std::chrono::seconds _fromTime{0};
+	std::chrono::seconds _toTime{0};
+	unsigned _weekdays = 0x7F;
+	bool _dateRange = false;
+	std::int64_t _firstDay = 0;
+	std::int64_t _lastDay = 0;
+	Dst _dst = Dst::Any;
+};
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "DateTime.hpp"
+
+namespace datetime {
+/// How a local time that a DST transition skips or repeats maps to UTC. Earliest and Latest
+/// pick one of the two instants of a repeated time and, like date::choose, map a skipped time
+/// to the instant of the transition. Throw raises date::nonexistent_local_time or
+/// date::ambiguous_local_time as date::make_zoned does.
+enum class DstPolicy {
+	Throw, Earliest, Latest
+};
+
+/// Converts local times of a zone to UTC without asking the zone for each of them. The local
+/// time line of a year range is cut into segments at every transition, a segment maps all its
+/// local times with one offset or is a gap or an overlap of a transition, so a conversion is
+/// a search over local seconds and a subtraction.
+///
+/// Single conversions start the search from the segment of the previous one, spans start it
+/// from the segment of the previous element, so sorted or clustered input costs a comparison
+/// or two. Local times outside the range are converted through the zone.
+class LocalTimeIndex {
+	template<class Duration>
+	using Common = typename std::common_type<Duration, std::chrono::seconds>::type;
+public:
+	/// Indexes the local years first through last.
+	LocalTimeIndex(const date::time_zone *zone, date::year first, date::year last) :
+		_zone(zone) {
+		if (_zone == nullptr)
+			throw std::invalid_argument("LocalTimeIndex needs a time zone");
+		if (!first.ok() || !last.ok() || last < first)
+			throw std::invalid_argument("invalid year range");
+		// A day either side covers any UTC offset of the local range.
+		auto from = date::sys_seconds(date::sys_days(first / date::January / 1) - date::days(1));
+		auto to = date::sys_seconds(date::sys_days((last + date::years(1)) / date::January / 1) + date::days(1));
+		auto info = _zone->get_info_view(from);
+		_starts.push_back((from + info.offset).time_since_epoch().count());
+		_segments.push_back({Offset(info.offset), Offset(info.offset), Kind::Unique});
+		while (info.end < to) {
+			auto next = _zone->get_info_view(info.end);
+			if (next.offset != info.offset) {
+				// Local clocks before and after the transition.
+				auto before = (info.end + info.offset).time_since_epoch().count();
+				auto after = (info.end + next.offset).time_since_epoch().count();
+				auto gap = after > before;
+				Add(std::min(before, after), {Offset(info.offset), Offset(next.offset), gap ? Kind::Gap : Kind::Overlap});
+				Add(std::max(before, after), {Offset(next.offset), Offset(next.offset), Kind::Unique});
+			}
+			info = next;
+		}
+		_starts.push_back((to + info.offset).time_since_epoch().count());
+		if (!std::is_sorted(_starts.begin(), _starts.end(), std::less_equal<>())) {
+			// Transitions closer together than their offset changes, leave them to the zone.
+			_starts.clear();
+			_segments.clear();
+		}
+	}
+
+	LocalTimeIndex(const LocalTimeIndex &other) :
+		_zone(other._zone), _starts(other._starts), _segments(other._segments) {
+	}
+
+	LocalTimeIndex &operator=(const LocalTimeIndex &other) {
+		_zone = other._zone;
+		_starts = other._starts;
+		_segments = other._segments;
+		_last.store(0, std::memory_order_relaxed);
+		return *this;
+	}
+
+	const date::time_zone *Zone() const { return _zone; }
+
+	template<class Duration>
+	date::sys_time<Common<Duration>> ToSys(date::local_time<Duration> t, DstPolicy policy = DstPolicy::Throw) const {
+		auto hint = _last.load(std::memory_order_relaxed);
+		auto result = ToSys(t, policy, hint);
+		_last.store(hint, std::memory_order_relaxed);
+		return result;
+	}
+
+	template<class Duration>
+	DateTime<Common<Duration>> ToDateTime(date::local_time<Duration> t, DstPolicy policy = DstPolicy::Throw) const {
+		return {date::make_zoned(_zone, ToSys(t, policy))};
+	}
+
+	/// Converts the local times of [first, last) into sys times in out.
+	template<class InputIt, class OutputIt>
+	OutputIt ToSys(InputIt first, InputIt last, OutputIt out, DstPolicy policy = DstPolicy::Throw) const {
+		auto hint = _last.load(std::memory_order_relaxed);
+		for (; first != last; ++first)
+			*out++ = ToSys(*first, policy, hint);
+		_last.store(hint, std::memory_order_relaxed);
+		return out;
+	}
+
+private:
+	enum class Kind : std::uint8_t {
+		Unique, Gap, Overlap
+	};
+
+	/// The offsets before and after a transition, or the offset of a whole segment twice.
+	struct Segment {
+		std::int32_t first;
+		std::int32_t second;
+		Kind kind;
+	};
+
+	static std::int32_t Offset(std::chrono::seconds offset) { return static_cast<std::int32_t>(offset.count()); }
+
+	void Add(std::int64_t start, Segment segment) {
+		if (start == _starts.back())
+			_segments.back() = segment;
+		else {
+			_starts.push_back(start);
+			_segments.push_back(segment);
+		}
+	}
+
+	/// Moves hint onto the segment holding local second s, false when s is outside the index.
+	bool Locate(std::int64_t s, std::size_t &hint) const {
+		if (_starts.size() < 2 || s < _starts.front() || s >= _starts.back())
+			return false;
+		if (hint + 1 >= _starts.size() || s < _starts[hint] || s >= _starts[hint + 1]) {
+			// Sorted input usually moves on to the next segment.
+			if (hint + 2 < _starts.size() && s >= _starts[hint + 1] && s < _starts[hint + 2])
+				++hint;
+			else
+				hint = static_cast<std::size_t>(std::upper_bound(_starts.begin(), _starts.end(), s) - _starts.begin()) - 1;
+		}
+		return true;
+	}
+
+	template<class Duration>
+	date::sys_time<Common<Duration>> ToSys(date::local_time<Duration> t, DstPolicy policy, std::size_t &hint) const {
+		using Result = date::sys_time<Common<Duration>>;
+		auto s = date::floor<std::chrono::seconds>(t).time_since_epoch().count();
+		if (!Locate(s, hint)) {
+			if (policy == DstPolicy::Throw)
+				return _zone->to_sys(t);
+			return _zone->to_sys(t, policy == DstPolicy::Earliest ? date::choose::earliest : date::choose::latest);
+		}
+		const auto &segment = _segments[hint];
+		if (segment.kind == Kind::Unique)
+			return Result(t.time_since_epoch() - std::chrono::seconds(segment.first));
+		if (policy == DstPolicy::Throw)
+			return _zone->to_sys(t);
+		if (segment.kind == Kind::Gap)
+			return Result(std::chrono::seconds(_starts[hint] - segment.first));
+		auto offset = policy == DstPolicy::Earliest ? segment.first : segment.second;
+		return Result(t.time_since_epoch() - std::chrono::seconds(offset));
+	}
+
+	const date::time_zone *_zone;
+	// Local seconds where each segment starts, then the end of the last one.
+	std::vector<std::int64_t> _starts;
+	std::vector<Segment> _segments;
+	mutable std::atomic<std::size_t> _last{0};
+};
+}
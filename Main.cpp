@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include "DateTime.hpp"
+#include "DateRange.hpp"
 
 using namespace std::chrono_literals;
 using namespace date::literals;
@@ -36,6 +37,16 @@ int main() {
 	if (x4 > x3 && x4 < x6)
 		std::cout << "Newer date is newer" << std::endl;
 
+	// Fractional seconds survive a round trip at the precision of the DateTime
+	auto x7 = DateTime<std::chrono::microseconds>::Now();
+	auto x8 = DateTime<std::chrono::microseconds>::Parse(x7.Format(ISO8601_FRAC_FORMAT), std::string(ISO8601_FRAC_FORMAT));
+	std::cout << "Round tripped " << x7.Format(ISO8601_FRAC_FORMAT) << " as " << x8.Format(ISO8601_FRAC_FORMAT) << std::endl;
+
+	std::cout << "Fridays at the end of a month this year:";
+	for (auto d : DateRange(Date(x1.Year(), date::January, 1_d), Date(x1.Year() + date::years(1), date::January, 1_d)).OnMonthEnds().OnWeekdays({date::Friday}))
+		std::cout << ' ' << d;
+	std::cout << std::endl;
+
 	//auto x5 = DateTime<>::UtcFromTimestamp(1497252490.0282006);
 	//std::cout << "UTC datetime from timestamp is " << x5 << ". Check timestamp back: " << x5.Timestamp() << std::endl;
 
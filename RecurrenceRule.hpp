@@ -0,0 +1,526 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "DateTime.hpp"
+
+namespace datetime {
+template<class Duration>
+class OccurrenceRange;
+
+/// An RFC 5545 recurrence rule compiled once from its text form, for example
+/// "FREQ=MONTHLY;BYDAY=-1FR;COUNT=12". Supports FREQ (YEARLY, MONTHLY, WEEKLY, DAILY),
+/// INTERVAL, COUNT, UNTIL, BYMONTH, BYMONTHDAY, BYDAY, BYSETPOS and WKST.
+///
+/// Occurrences are generated one period (day, week, month or year) at a time, and expansion
+/// starts at the period containing the start of the query window instead of at DTSTART.
+/// With COUNT the occurrences before the window still have to be counted. That is one
+/// multiplication when every period holds the same number of days (DAILY without BY parts,
+/// WEEKLY without BYMONTH); other rules expand the days of each earlier period, stopping once
+/// COUNT is reached, but never convert them to instants.
+/// Every occurrence keeps the local wall clock time of DTSTART, times falling in a DST gap
+/// or overlap are resolved with the offset in effect before the transition.
+class RecurrenceRule {
+public:
+	enum class Frequency {
+		Yearly, Monthly, Weekly, Daily
+	};
+
+	static RecurrenceRule Parse(std::string_view text) {
+		RecurrenceRule rule;
+		std::string upper;
+		for (auto c : text)
+			upper.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+		std::string_view rest(upper);
+		if (rest.substr(0, 6) == "RRULE:")
+			rest.remove_prefix(6);
+
+		bool hasFrequency = false;
+		while (!rest.empty()) {
+			auto semicolon = rest.find(';');
+			auto part = rest.substr(0, semicolon);
+			rest = semicolon == std::string_view::npos ? std::string_view() : rest.substr(semicolon + 1);
+			if (part.empty())
+				continue;
+			auto equals = part.find('=');
+			if (equals == std::string_view::npos)
+				throw std::invalid_argument("invalid recurrence rule part " + std::string(part));
+			auto name = part.substr(0, equals);
+			auto value = part.substr(equals + 1);
+
+			if (name == "FREQ") {
+				if (value == "YEARLY") rule._frequency = Frequency::Yearly;
+				else if (value == "MONTHLY") rule._frequency = Frequency::Monthly;
+				else if (value == "WEEKLY") rule._frequency = Frequency::Weekly;
+				else if (value == "DAILY") rule._frequency = Frequency::Daily;
+				else throw std::invalid_argument("unsupported recurrence frequency " + std::string(value));
+				hasFrequency = true;
+			} else if (name == "INTERVAL") {
+				rule._interval = ParseInteger(value, 1, 1 << 20);
+			} else if (name == "COUNT") {
+				rule._count = ParseInteger(value, 1, 1 << 30);
+			} else if (name == "UNTIL") {
+				rule.ParseUntil(value);
+			} else if (name == "BYMONTH") {
+				ForEach(value, [&](std::string_view v) { rule._byMonth |= 1u << ParseInteger(v, 1, 12); });
+			} else if (name == "BYMONTHDAY") {
+				ForEach(value, [&](std::string_view v) {
+					auto day = ParseInteger(v, -31, 31);
+					if (day == 0)
+						throw std::invalid_argument("BYMONTHDAY can not be 0");
+					rule._byMonthDay.push_back(day);
+				});
+			} else if (name == "BYDAY") {
+				ForEach(value, [&](std::string_view v) {
+					if (v.size() < 2)
+						throw std::invalid_argument("invalid BYDAY value " + std::string(v));
+					auto weekday = ParseWeekday(v.substr(v.size() - 2));
+					auto ordinal = v.size() > 2 ? ParseInteger(v.substr(0, v.size() - 2), -53, 53) : 0;
+					rule._byDay.emplace_back(ordinal, weekday);
+					rule._byWeekday |= 1u << weekday;
+				});
+			} else if (name == "BYSETPOS") {
+				ForEach(value, [&](std::string_view v) {
+					auto position = ParseInteger(v, -366, 366);
+					if (position == 0)
+						throw std::invalid_argument("BYSETPOS can not be 0");
+					rule._bySetPos.push_back(position);
+				});
+			} else if (name == "WKST") {
+				rule._weekStart = ParseWeekday(value);
+			} else {
+				throw std::invalid_argument("unsupported recurrence rule part " + std::string(name));
+			}
+		}
+		if (!hasFrequency)
+			throw std::invalid_argument("recurrence rule without FREQ");
+		if (rule._count && (rule._untilSys || rule._untilLocal))
+			throw std::invalid_argument("recurrence rule with both COUNT and UNTIL");
+		return rule;
+	}
+
+	Frequency GetFrequency() const { return _frequency; }
+
+	/// The occurrences of the rule started at dtstart that fall in [from, to), presented in
+	/// the zone of dtstart. The range keeps its own copy of the rule.
+	template<class Duration>
+	OccurrenceRange<typename std::common_type<Duration, std::chrono::seconds>::type> Between(
+		const DateTime<Duration> &dtstart, const DateTime<Duration> &from, const DateTime<Duration> &to) const;
+
+private:
+	template<class Duration>
+	friend class OccurrenceRange;
+
+	using Days = std::vector<date::sys_days>;
+
+	RecurrenceRule() = default;
+
+	static int ParseInteger(std::string_view text, int min, int max) {
+		int sign = 1;
+		if (!text.empty() && (text[0] == '+' || text[0] == '-')) {
+			sign = text[0] == '-' ? -1 : 1;
+			text.remove_prefix(1);
+		}
+		if (text.empty() || text.size() > 9)
+			throw std::invalid_argument("invalid number in recurrence rule");
+		int value = 0;
+		for (auto c : text) {
+			if (c < '0' || c > '9')
+				throw std::invalid_argument("invalid number in recurrence rule");
+			value = 10 * value + (c - '0');
+		}
+		value *= sign;
+		if (value < min || value > max)
+			throw std::invalid_argument("number out of range in recurrence rule");
+		return value;
+	}
+
+	/// Sunday is 0, the same encoding as date::weekday::c_encoding().
+	static unsigned ParseWeekday(std::string_view text) {
+		static constexpr std::string_view names[] = {"SU", "MO", "TU", "WE", "TH", "FR", "SA"};
+		for (unsigned i = 0; i < 7; ++i) {
+			if (text == names[i])
+				return i;
+		}
+		throw std::invalid_argument("invalid weekday " + std::string(text) + " in recurrence rule");
+	}
+
+	template<class Function>
+	static void ForEach(std::string_view list, Function &&function) {
+		while (!list.empty()) {
+			auto comma = list.find(',');
+			function(list.substr(0, comma));
+			list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+		}
+	}
+
+	void ParseUntil(std::string_view value) {
+		date::local_seconds tp;
+		std::istringstream ss{std::string(value)};
+		if (value.size() == 8) {
+			date::local_days day;
+			ss >> date::parse("%Y%m%d", day);
+			// A date UNTIL is inclusive of the whole day.
+			tp = date::local_seconds(day + date::days(1)) - std::chrono::seconds(1);
+		} else {
+			ss >> date::parse("%Y%m%dT%H%M%S", tp);
+		}
+		if (ss.fail())
+			throw std::invalid_argument("invalid UNTIL " + std::string(value));
+		if (value.back() == 'Z')
+			_untilSys = date::sys_seconds(tp.time_since_epoch());
+		else
+			_untilLocal = tp;
+	}
+
+	static unsigned LastDay(const date::year &y, const date::month &m) {
+		return static_cast<unsigned>((y / m / date::last).day());
+	}
+
+	bool InMonths(const date::month &m) const {
+		return _byMonth == 0 || (_byMonth & (1u << static_cast<unsigned>(m))) != 0;
+	}
+
+	/// The n-th (negative from the end) weekday in [first, first + length).
+	static std::optional<date::sys_days> NthWeekday(date::sys_days first, int length, unsigned weekday, int n) {
+		if (n > 0) {
+			auto day = first + date::days((weekday + 7 - detail::CWeekday(first)) % 7 + 7 * (n - 1));
+			if (day < first + date::days(length))
+				return day;
+		} else {
+			auto last = first + date::days(length - 1);
+			auto day = last - date::days((detail::CWeekday(last) + 7 - weekday) % 7 + 7 * (-n - 1));
+			if (day >= first)
+				return day;
+		}
+		return {};
+	}
+
+	/// Expands BYDAY over [first, first + length), with ordinals counted within that span.
+	void ExpandByDay(date::sys_days first, int length, Days &days) const {
+		for (const auto &[ordinal, weekday] : _byDay) {
+			if (ordinal == 0) {
+				for (auto day = first + date::days((weekday + 7 - detail::CWeekday(first)) % 7); day < first + date::days(length); day += date::days(7))
+					days.push_back(day);
+			} else if (auto day = NthWeekday(first, length, weekday, ordinal)) {
+				days.push_back(*day);
+			}
+		}
+	}
+
+	/// The days of a month. With both BYMONTHDAY and BYDAY the month days must also be BYDAY
+	/// days, counted within the month or, when given, among yearByDay.
+	void ExpandMonth(const date::year &y, const date::month &m, Days &days, const Days *yearByDay = nullptr) const {
+		date::sys_days first = y / m / 1;
+		auto length = static_cast<int>(LastDay(y, m));
+		if (!_byMonthDay.empty()) {
+			Days byDay;
+			if (!_byDay.empty() && yearByDay == nullptr) {
+				ExpandByDay(first, length, byDay);
+				std::sort(byDay.begin(), byDay.end());
+				yearByDay = &byDay;
+			}
+			for (auto monthDay : _byMonthDay) {
+				auto d = monthDay > 0 ? monthDay : length + 1 + monthDay;
+				if (d < 1 || d > length)
+					continue;
+				auto day = first + date::days(d - 1);
+				if (_byDay.empty() || std::binary_search(yearByDay->begin(), yearByDay->end(), day))
+					days.push_back(day);
+			}
+		} else if (!_byDay.empty()) {
+			ExpandByDay(first, length, days);
+		} else if (static_cast<int>(static_cast<unsigned>(_startDay.day())) <= length) {
+			days.push_back(first + date::days(static_cast<unsigned>(_startDay.day()) - 1));
+		}
+	}
+
+	/// The days of period k, sorted and reduced by BYSETPOS.
+	void ExpandPeriod(std::int64_t k, Days &days) const {
+		days.clear();
+		auto step = k * _interval;
+		switch (_frequency) {
+		case Frequency::Daily: {
+			auto day = date::sys_days(_startDay) + date::days(step);
+			date::year_month_day ymd{day};
+			if (!InMonths(ymd.month()))
+				break;
+			if (!_byDay.empty() && (_byWeekday & (1u << detail::CWeekday(day))) == 0)
+				break;
+			if (!_byMonthDay.empty()) {
+				auto length = static_cast<int>(LastDay(ymd.year(), ymd.month()));
+				auto d = static_cast<int>(static_cast<unsigned>(ymd.day()));
+				if (std::none_of(_byMonthDay.begin(), _byMonthDay.end(), [&](int v) { return v == d || length + 1 + v == d; }))
+					break;
+			}
+			days.push_back(day);
+			break;
+		}
+		case Frequency::Weekly: {
+			auto weekStart = date::sys_days(_startDay) - date::days((detail::CWeekday(date::sys_days(_startDay)) + 7 - _weekStart) % 7) + date::days(7 * step);
+			if (_byDay.empty()) {
+				days.push_back(weekStart + date::days((detail::CWeekday(date::sys_days(_startDay)) + 7 - _weekStart) % 7));
+			} else {
+				for (unsigned w = 0; w < 7; ++w) {
+					if (_byWeekday & (1u << w))
+						days.push_back(weekStart + date::days((w + 7 - _weekStart) % 7));
+				}
+			}
+			if (_byMonth != 0) {
+				days.erase(std::remove_if(days.begin(), days.end(), [&](date::sys_days d) { return !InMonths(date::year_month_day(d).month()); }), days.end());
+			}
+			break;
+		}
+		case Frequency::Monthly: {
+			auto ym = _startDay.year() / _startDay.month() + date::months(step);
+			if (InMonths(ym.month()))
+				ExpandMonth(ym.year(), ym.month(), days);
+			break;
+		}
+		case Frequency::Yearly: {
+			auto y = _startDay.year() + date::years(step);
+			if (_byMonth != 0 || !_byMonthDay.empty()) {
+				// Without BYMONTH, BYDAY ordinals count within the year
+				Days yearByDay;
+				if (_byMonth == 0 && !_byDay.empty()) {
+					date::sys_days first = y / date::January / 1;
+					ExpandByDay(first, (date::sys_days(y / date::December / 31) - first).count() + 1, yearByDay);
+					std::sort(yearByDay.begin(), yearByDay.end());
+				}
+				for (unsigned m = 1; m <= 12; ++m) {
+					if (_byMonth == 0 || (_byMonth & (1u << m)))
+						ExpandMonth(y, date::month(m), days, _byMonth == 0 && !_byDay.empty() ? &yearByDay : nullptr);
+				}
+			} else if (!_byDay.empty()) {
+				date::sys_days first = y / date::January / 1;
+				ExpandByDay(first, (date::sys_days(y / date::December / 31) - first).count() + 1, days);
+			} else {
+				date::year_month_day ymd{y, _startDay.month(), _startDay.day()};
+				if (ymd.ok())
+					days.push_back(ymd);
+			}
+			break;
+		}
+		}
+
+		std::sort(days.begin(), days.end());
+		days.erase(std::unique(days.begin(), days.end()), days.end());
+		if (!_bySetPos.empty() && !days.empty()) {
+			Days selected;
+			auto size = static_cast<int>(days.size());
+			for (auto position : _bySetPos) {
+				auto i = position > 0 ? position - 1 : size + position;
+				if (i >= 0 && i < size)
+					selected.push_back(days[i]);
+			}
+			std::sort(selected.begin(), selected.end());
+			selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+			days.swap(selected);
+		}
+	}
+
+	/// The period containing the local day, which may be negative before DTSTART.
+	std::int64_t PeriodOf(date::sys_days day) const {
+		auto floorDiv = [](std::int64_t a, std::int64_t b) { return a >= 0 ? a / b : -((-a + b - 1) / b); };
+		switch (_frequency) {
+		case Frequency::Daily:
+			return floorDiv((day - date::sys_days(_startDay)).count(), _interval);
+		case Frequency::Weekly: {
+			auto startWeek = date::sys_days(_startDay) - date::days((detail::CWeekday(date::sys_days(_startDay)) + 7 - _weekStart) % 7);
+			return floorDiv(floorDiv((day - startWeek).count(), 7), _interval);
+		}
+		case Frequency::Monthly: {
+			date::year_month_day ymd{day};
+			auto months = (ymd.year() / ymd.month() - _startDay.year() / _startDay.month()).count();
+			return floorDiv(months, _interval);
+		}
+		case Frequency::Yearly:
+			return floorDiv((date::year_month_day(day).year() - _startDay.year()).count(), _interval);
+		}
+		return 0;
+	}
+
+	/// Whether every full period yields the same number of days, so skipped periods
+	/// can be counted against COUNT without expanding them.
+	bool FixedPeriodSize() const {
+		if (_frequency == Frequency::Daily)
+			return _byMonth == 0 && _byMonthDay.empty() && _byDay.empty();
+		if (_frequency == Frequency::Weekly)
+			return _byMonth == 0;
+		return false;
+	}
+
+	Frequency _frequency = Frequency::Daily;
+	int _interval = 1;
+	std::optional<std::int64_t> _count;
+	std::optional<date::sys_seconds> _untilSys;
+	std::optional<date::local_seconds> _untilLocal;
+	std::uint16_t _byMonth = 0;
+	std::vector<int> _byMonthDay;
+	std::vector<std::pair<int, unsigned>> _byDay;
+	unsigned _byWeekday = 0;
+	std::vector<int> _bySetPos;
+	unsigned _weekStart = 1;
+	/// Set by Between, period arithmetic is relative to the local date of DTSTART.
+	date::year_month_day _startDay;
+};
+
+/// A lazy stream over the occurrences of a RecurrenceRule in a window.
+template<class Duration>
+class OccurrenceRange {
+	using SysTime = date::sys_time<Duration>;
+	using LocalTime = date::local_time<Duration>;
+public:
+	class Iterator {
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = DateTime<Duration>;
+		using difference_type = std::ptrdiff_t;
+		using reference = DateTime<Duration>;
+		using pointer = void;
+
+		Iterator() = default;
+
+		DateTime<Duration> operator*() const { return {date::zoned_time<Duration>(_range->_zone, _current)}; }
+
+		Iterator &operator++() {
+			Advance();
+			return *this;
+		}
+		Iterator operator++(int) {
+			auto it = *this;
+			Advance();
+			return it;
+		}
+
+		friend bool operator==(const Iterator &x, const Iterator &y) { return x._done == y._done && (x._done || x._current == y._current); }
+		friend bool operator!=(const Iterator &x, const Iterator &y) { return !(x == y); }
+
+	private:
+		friend class OccurrenceRange;
+
+		explicit Iterator(const OccurrenceRange *range) :
+			_range(range),
+			_done(false) {
+			const auto &rule = *_range->_rule;
+			auto fromDay = date::floor<date::days>(_range->_zone->to_local(_range->_from));
+			auto fromPeriod = rule.PeriodOf(date::sys_days(fromDay.time_since_epoch()));
+			// One period of slack covers offsets moving the window start across a local midnight.
+			_period = std::max<std::int64_t>(0, fromPeriod - 1);
+			if (rule._count && _period > 0)
+				_emitted = CountBefore(_period);
+			_index = 0;
+			_range->_rule->ExpandPeriod(_period, _days);
+			Advance();
+		}
+
+		/// The number of occurrences in periods before k, capped near COUNT. Multiplied out for
+		/// rules with a fixed period size, otherwise each period before k is expanded.
+		std::int64_t CountBefore(std::int64_t k) {
+			const auto &rule = *_range->_rule;
+			std::int64_t count = 0;
+			rule.ExpandPeriod(0, _days);
+			for (auto day : _days)
+				count += LocalOf(day) >= _range->_startLocal;
+			if (rule.FixedPeriodSize()) {
+				rule.ExpandPeriod(1, _days);
+				return count + (k - 1) * static_cast<std::int64_t>(_days.size());
+			}
+			for (std::int64_t period = 1; period < k && count < *rule._count; ++period) {
+				rule.ExpandPeriod(period, _days);
+				count += static_cast<std::int64_t>(_days.size());
+			}
+			return count;
+		}
+
+		LocalTime LocalOf(date::sys_days day) const {
+			return LocalTime(day.time_since_epoch()) + _range->_timeOfDay;
+		}
+
+		void Advance() {
+			const auto &rule = *_range->_rule;
+			for (;;) {
+				if (_index == _days.size()) {
+					// Periods only move forward, none after the one holding the window end can match.
+					if (_period >= _range->_lastPeriod)
+						break;
+					rule.ExpandPeriod(++_period, _days);
+					_index = 0;
+					continue;
+				}
+				auto local = LocalOf(_days[_index++]);
+				if (local < _range->_startLocal)
+					continue;
+				if (rule._count && _emitted >= *rule._count)
+					break;
+				++_emitted;
+				if (rule._untilLocal && local > *rule._untilLocal)
+					break;
+				auto info = _range->_zone->get_info_view(local);
+				auto tp = SysTime(local.time_since_epoch()) - info.first.offset;
+				if (rule._untilSys && tp > *rule._untilSys)
+					break;
+				if (tp >= _range->_to)
+					break;
+				if (tp < _range->_from)
+					continue;
+				_current = tp;
+				return;
+			}
+			_done = true;
+		}
+
+		const OccurrenceRange *_range = nullptr;
+		std::int64_t _period = 0;
+		std::int64_t _emitted = 0;
+		std::vector<date::sys_days> _days;
+		std::size_t _index = 0;
+		SysTime _current;
+		bool _done = true;
+	};
+
+	Iterator begin() const { return Iterator(this); }
+	Iterator end() const { return {}; }
+
+private:
+	friend class RecurrenceRule;
+
+	OccurrenceRange(RecurrenceRule rule, const date::time_zone *zone, LocalTime startLocal, SysTime from, SysTime to) :
+		_rule(std::make_shared<RecurrenceRule>(std::move(rule))),
+		_zone(zone),
+		_startLocal(startLocal),
+		_timeOfDay(startLocal - date::floor<date::days>(startLocal)),
+		_from(from),
+		_to(to),
+		_toLocal(zone->to_local(to)) {
+		_rule->_startDay = date::year_month_day(date::sys_days(date::floor<date::days>(startLocal).time_since_epoch()));
+		_lastPeriod = _rule->PeriodOf(date::sys_days(date::floor<date::days>(_toLocal).time_since_epoch())) + 1;
+	}
+
+	std::shared_ptr<RecurrenceRule> _rule;
+	const date::time_zone *_zone;
+	LocalTime _startLocal;
+	Duration _timeOfDay;
+	SysTime _from;
+	SysTime _to;
+	LocalTime _toLocal;
+	std::int64_t _lastPeriod = 0;
+};
+
+template<class Duration>
+OccurrenceRange<typename std::common_type<Duration, std::chrono::seconds>::type> RecurrenceRule::Between(
+	const DateTime<Duration> &dtstart, const DateTime<Duration> &from, const DateTime<Duration> &to) const {
+	return {*this, dtstart.Timezone(), dtstart.ZonedTime().get_local_time(), from.ZonedTime().get_sys_time(), to.ZonedTime().get_sys_time()};
+}
+}
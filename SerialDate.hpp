@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <date/date.h>
+
+#include "Date.hpp"
+#include "TimeDelta.hpp"
+
+namespace datetime {
+/// A date held as its count of days since 1970-01-01, for code that adds, subtracts, compares
+/// and hashes dates far more often than it reads their fields. Those are single integer
+/// operations here, while the year, month and day are computed from the count each time they
+/// are read; Date is the better fit the other way around.
+///
+/// Converts to and from Date implicitly, one calendar computation each way. An expression
+/// mixing the two, such as a Date compared with a SerialDate, is ambiguous: convert one side.
+class SerialDate {
+public:
+	static SerialDate Today() {
+		return {date::floor<date::days>(std::chrono::system_clock::now())};
+	}
+
+	SerialDate() = default;
+	constexpr SerialDate(date::sys_days days) :
+		_days(static_cast<std::int32_t>(days.time_since_epoch().count())) {
+	}
+	constexpr SerialDate(const date::year_month_day &ymd) :
+		SerialDate(date::sys_days(ymd)) {
+	}
+	constexpr SerialDate(const date::year &y, const date::month &m, const date::day &d) :
+		SerialDate(date::year_month_day(y, m, d)) {
+	}
+	SerialDate(const Date &d) :
+		SerialDate(d.YearMonthDay()) {
+	}
+
+	/// The date that is days after 1970-01-01, or before it when negative.
+	static constexpr SerialDate FromSerial(std::int32_t days) { return {date::sys_days(date::days(days))}; }
+
+	constexpr std::int32_t Serial() const { return _days; }
+	constexpr date::sys_days SysDays() const { return date::sys_days(date::days(_days)); }
+
+	operator Date() const { return {YearMonthDay()}; }
+
+	constexpr date::year_month_day YearMonthDay() const { return {SysDays()}; }
+
+	constexpr date::year Year() const { return YearMonthDay().year(); }
+	constexpr date::month Month() const { return YearMonthDay().month(); }
+	constexpr date::day Day() const { return YearMonthDay().day(); }
+
+	constexpr date::weekday ObjWeekday() const {
+		return date::weekday(SysDays());
+	}
+	/// 0 for Monday to 6 for Sunday.
+	constexpr unsigned Weekday() const {
+		return detail::Weekday(_days);
+	}
+	/// 1 for Monday to 7 for Sunday.
+	constexpr unsigned IsoWeekday() const {
+		return 1 + Weekday();
+	}
+
+	/// The fields of Date, each from a single calendar computation.
+	constexpr unsigned DayOfYear() const {
+		auto ymd = YearMonthDay();
+		return detail::DayOfYear(static_cast<int>(ymd.year()), static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()));
+	}
+	constexpr unsigned Quarter() const {
+		return detail::Quarter(static_cast<unsigned>(Month()));
+	}
+	constexpr unsigned IsoWeek() const {
+		return IsoWeekDate().week;
+	}
+	constexpr date::year IsoWeekYear() const {
+		return date::year(IsoWeekDate().year);
+	}
+
+	std::string Format(std::string_view format) const {
+		return date::format(format.data(), YearMonthDay());
+	}
+
+private:
+	constexpr detail::IsoWeekDate IsoWeekDate() const {
+		auto ymd = YearMonthDay();
+		auto y = static_cast<int>(ymd.year());
+		return detail::IsoWeek(y, detail::DayOfYear(y, static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day())), Weekday());
+	}
+
+	std::int32_t _days = 0;
+};
+
+inline SerialDate operator+(const SerialDate &d, const TimeDelta &td) {
+	return SerialDate::FromSerial(d.Serial() + static_cast<std::int32_t>(td.Days()));
+}
+
+inline SerialDate operator+(const TimeDelta &td, const SerialDate &d) {
+	return d + td;
+}
+
+inline SerialDate operator-(const SerialDate &d, const TimeDelta &td) {
+	return SerialDate::FromSerial(d.Serial() - static_cast<std::int32_t>(td.Days()));
+}
+
+inline TimeDelta operator-(const SerialDate &x, const SerialDate &y) {
+	return {date::days(x.Serial() - y.Serial())};
+}
+
+inline constexpr bool operator==(const SerialDate &x, const SerialDate &y) { return x.Serial() == y.Serial(); }
+inline constexpr bool operator!=(const SerialDate &x, const SerialDate &y) { return x.Serial() != y.Serial(); }
+inline constexpr bool operator<(const SerialDate &x, const SerialDate &y) { return x.Serial() < y.Serial(); }
+inline constexpr bool operator<=(const SerialDate &x, const SerialDate &y) { return x.Serial() <= y.Serial(); }
+inline constexpr bool operator>(const SerialDate &x, const SerialDate &y) { return x.Serial() > y.Serial(); }
+inline constexpr bool operator>=(const SerialDate &x, const SerialDate &y) { return x.Serial() >= y.Serial(); }
+
+template<class CharT, class Traits>
+std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os, const SerialDate &date) {
+	return os << date.YearMonthDay();
+}
+}
+
+namespace std {
+template<>
+struct hash<datetime::SerialDate> {
+	std::size_t operator()(const datetime::SerialDate &d) const noexcept { return std::hash<std::int32_t>()(d.Serial()); }
+};
+}
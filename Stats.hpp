@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include <date/tz.h>
+
+namespace datetime {
+/// Whether the library counts its work, set by building with DATETIMECPP_STATS, which defines
+/// TZ_STATS. Without it nothing is counted and Stats() returns zeros.
+constexpr bool StatsEnabled = TZ_STATS != 0;
+
+#if !TZ_STATS
+// Without DATETIMECPP_STATS the hooks in the tz code must cost nothing: the timer holds no
+// state and counting is evaluated at compile time.
+static_assert(std::is_empty_v<date::detail::stat_timer> && std::is_trivially_destructible_v<date::detail::stat_timer>,
+	"a disabled stat_timer must be an empty type");
+static_assert((date::detail::add_stat(date::detail::stat_id::exceptions),
+	date::detail::stat_timer(date::detail::stat_id::tzdb_loads, date::detail::stat_id::tzdb_load_ns), true),
+	"disabled stats hooks must be no-ops usable in constant expressions");
+#endif
+
+/// Work done by the library in all threads since the process started. Counters are kept per
+/// thread and only summed here, so counting never contends between threads; the difference of
+/// two snapshots is the work done in between.
+struct StatsSnapshot {
+	/// Loads of the tz database, the first one and every reload, and the time they took.
+	std::uint64_t tzdbLoads = 0;
+	std::uint64_t tzdbLoadNanoseconds = 0;
+	/// First uses of a zone, which read its zoneinfo file or expand its rules.
+	std::uint64_t zoneLoads = 0;
+	std::uint64_t zoneLoadNanoseconds = 0;
+	std::uint64_t locateZoneHits = 0;
+	std::uint64_t locateZoneMisses = 0;
+	/// Offset lookups by UTC and by local time, get_info and get_info_view alike.
+	std::uint64_t sysInfoCalls = 0;
+	std::uint64_t localInfoCalls = 0;
+	/// Zones not found and local times that do not exist or are ambiguous.
+	std::uint64_t exceptions = 0;
+	std::uint64_t parseCalls = 0;
+	std::uint64_t parseBytes = 0;
+	std::uint64_t formatCalls = 0;
+	std::uint64_t formatBytes = 0;
+};
+
+inline StatsSnapshot operator-(const StatsSnapshot &x, const StatsSnapshot &y) {
+	return {
+		x.tzdbLoads - y.tzdbLoads, x.tzdbLoadNanoseconds - y.tzdbLoadNanoseconds,
+		x.zoneLoads - y.zoneLoads, x.zoneLoadNanoseconds - y.zoneLoadNanoseconds,
+		x.locateZoneHits - y.locateZoneHits, x.locateZoneMisses - y.locateZoneMisses,
+		x.sysInfoCalls - y.sysInfoCalls, x.localInfoCalls - y.localInfoCalls,
+		x.exceptions - y.exceptions,
+		x.parseCalls - y.parseCalls, x.parseBytes - y.parseBytes,
+		x.formatCalls - y.formatCalls, x.formatBytes - y.formatBytes
+	};
+}
+
+inline StatsSnapshot Stats() {
+	StatsSnapshot snapshot;
+#if TZ_STATS
+	using date::detail::stat_id;
+	std::uint64_t values[static_cast<unsigned>(stat_id::count)];
+	date::detail::read_stats(values);
+	auto value = [&values](stat_id s) { return values[static_cast<unsigned>(s)]; };
+	snapshot.tzdbLoads = value(stat_id::tzdb_loads);
+	snapshot.tzdbLoadNanoseconds = value(stat_id::tzdb_load_ns);
+	snapshot.zoneLoads = value(stat_id::zone_loads);
+	snapshot.zoneLoadNanoseconds = value(stat_id::zone_load_ns);
+	snapshot.locateZoneHits = value(stat_id::locate_zone_hits);
+	snapshot.locateZoneMisses = value(stat_id::locate_zone_misses);
+	snapshot.sysInfoCalls = value(stat_id::sys_info_calls);
+	snapshot.localInfoCalls = value(stat_id::local_info_calls);
+	snapshot.exceptions = value(stat_id::exceptions);
+	snapshot.parseCalls = value(stat_id::parse_calls);
+	snapshot.parseBytes = value(stat_id::parse_bytes);
+	snapshot.formatCalls = value(stat_id::format_calls);
+	snapshot.formatBytes = value(stat_id::format_bytes);
+#endif
+	return snapshot;
+}
+}
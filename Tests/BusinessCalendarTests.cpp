@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BusinessCalendar.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+
+namespace {
+/// Business days of [first, last] checked one day at a time.
+struct Naive {
+	date::sys_days first, last;
+	std::set<date::sys_days> holidays;
+	unsigned weekend;
+
+	bool IsBusinessDay(date::sys_days d) const {
+		return (weekend & (1u << date::weekday(d).c_encoding())) == 0 && holidays.count(d) == 0;
+	}
+
+	std::int64_t Between(date::sys_days from, date::sys_days to) const {
+		std::int64_t count = 0;
+		for (auto d = std::min(from, to); d < std::max(from, to); d += date::days(1))
+			count += IsBusinessDay(d);
+		return to < from ? -count : count;
+	}
+
+	/// Empty when the result leaves the calendar.
+	std::vector<date::sys_days> Add(date::sys_days d, std::int64_t n) const {
+		auto step = date::days(n > 0 ? 1 : -1);
+		for (auto left = n < 0 ? -n : n; left > 0;) {
+			d += step;
+			if (d < first || d > last)
+				return {};
+			left -= IsBusinessDay(d);
+		}
+		return {d};
+	}
+};
+
+/// Compares a calendar of 2019 to 2021 with the naive one for every day, across the ends of
+/// 64 day words and of the 64 business day samples.
+void CheckAgainstNaive(const BusinessCalendar &calendar, const Naive &naive) {
+	DATETIME_CHECK(date::sys_days(calendar.First().YearMonthDay()) == naive.first);
+	DATETIME_CHECK(date::sys_days(calendar.Last().YearMonthDay()) == naive.last);
+	auto anchor = naive.first + date::days(200);
+	for (auto d = naive.first; d <= naive.last; d += date::days(1)) {
+		Date date(d);
+		DATETIME_CHECK_EQUAL(calendar.IsBusinessDay(date), naive.IsBusinessDay(d));
+		DATETIME_CHECK_EQUAL(calendar.BusinessDaysBetween(Date(anchor), date), naive.Between(anchor, d));
+		for (std::int64_t n : {-130, -65, -64, -63, -2, -1, 0, 1, 2, 63, 64, 65, 130}) {
+			auto expected = naive.Add(d, n);
+			if (expected.empty()) {
+				bool outside = false;
+				try {
+					calendar.AddBusinessDays(date, n);
+				} catch (const std::out_of_range &) {
+					outside = true;
+				}
+				DATETIME_CHECK(outside);
+				continue;
+			}
+			DATETIME_CHECK(date::sys_days(calendar.AddBusinessDays(date, n).YearMonthDay()) == expected[0]);
+			if (n == 1)
+				DATETIME_CHECK(date::sys_days(calendar.NextBusinessDay(date).YearMonthDay()) == expected[0]);
+			if (n == -1)
+				DATETIME_CHECK(date::sys_days(calendar.PreviousBusinessDay(date).YearMonthDay()) == expected[0]);
+		}
+	}
+}
+
+std::vector<Date> Holidays() {
+	std::vector<Date> holidays;
+	for (int y = 2019; y <= 2021; ++y) {
+		for (auto md : {date::January / 1, date::March / 5, date::March / 6, date::July / 4, date::December / 24, date::December / 25, date::December / 26})
+			holidays.emplace_back(date::year(y) / md);
+	}
+	// Outside the calendar, ignored
+	holidays.emplace_back(date::year(2022) / date::January / 3);
+	return holidays;
+}
+}
+
+DATETIME_TEST("BusinessCalendar/AgainstNaive", [] {
+	Naive naive{date::year(2019) / date::January / 1, date::year(2021) / date::December / 31, {}, 0};
+	naive.weekend = (1u << date::Saturday.c_encoding()) | (1u << date::Sunday.c_encoding());
+	CheckAgainstNaive(BusinessCalendar(date::year(2019), date::year(2021)), naive);
+	auto holidays = Holidays();
+	for (auto &holiday : holidays)
+		naive.holidays.insert(holiday.YearMonthDay());
+	CheckAgainstNaive(BusinessCalendar(date::year(2019), date::year(2021), {date::Saturday, date::Sunday}, holidays), naive);
+	// A Friday and Saturday weekend
+	naive.weekend = (1u << date::Friday.c_encoding()) | (1u << date::Saturday.c_encoding());
+	CheckAgainstNaive(BusinessCalendar(date::year(2019), date::year(2021), {date::Friday, date::Saturday}, holidays), naive);
+});
+
+DATETIME_TEST("BusinessCalendar/FromFile", [] {
+	auto filename = (std::filesystem::temp_directory_path() / "DateTimeCPP_holidays.txt").string();
+	auto write = [&](const char *text) {
+		std::ofstream(filename) << text;
+	};
+	write("# holidays\n2020-01-01\n\n  2020-12-25 \r\n\t# indented comment\n2020-07-03\n");
+	auto calendar = BusinessCalendar::FromFile(filename, date::year(2020), date::year(2020));
+	DATETIME_CHECK(!calendar.IsBusinessDay(date::year(2020) / date::January / 1));
+	DATETIME_CHECK(!calendar.IsBusinessDay(date::year(2020) / date::December / 25));
+	DATETIME_CHECK(!calendar.IsBusinessDay(date::year(2020) / date::July / 3));
+	DATETIME_CHECK(calendar.IsBusinessDay(date::year(2020) / date::January / 2));
+	DATETIME_CHECK_EQUAL(calendar.BusinessDaysBetween(date::year(2020) / date::January / 1, date::year(2020) / date::December / 31), std::int64_t(258));
+
+	for (auto text : {"2020-01-01x\n", "2020-01-01 2020-01-02\n", "2020-01-01 # comment\n", "2020-13-01\n", "01/01/2020\n"}) {
+		write(text);
+		bool rejected = false;
+		try {
+			BusinessCalendar::FromFile(filename, date::year(2020), date::year(2020));
+		} catch (const std::runtime_error &) {
+			rejected = true;
+		}
+		DATETIME_CHECK(rejected);
+	}
+	std::filesystem::remove(filename);
+});
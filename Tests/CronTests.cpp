@@ -0,0 +1,67 @@
+#include <chrono>
+#include <vector>
+
+#include "CronSchedule.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+
+namespace {
+/// The local dates of the next count fire times of expression after 2024-01-01 00:00 UTC.
+std::vector<date::sys_days> FireDays(const char *expression, std::size_t count) {
+	auto schedule = CronSchedule::Parse(expression);
+	auto zone = date::locate_zone("UTC");
+	std::vector<date::sys_days> days;
+	auto tp = date::sys_seconds(date::sys_days(date::year(2024) / date::January / 1));
+	for (std::size_t i = 0; i < count; ++i) {
+		auto fire = schedule.NextAfter(tp, zone);
+		DATETIME_CHECK(fire.has_value());
+		if (!fire)
+			break;
+		days.push_back(date::floor<date::days>(*fire));
+		tp = *fire;
+	}
+	return days;
+}
+}
+
+DATETIME_TEST("Cron/SteppedDayOfMonth", [] {
+	auto days = FireDays("0 0 */2 * *", 20);
+	for (auto day : days)
+		DATETIME_CHECK(static_cast<unsigned>(date::year_month_day(day).day()) % 2 == 1);
+	// Jan 3 to Jan 31 in steps of two, then Feb 1
+	DATETIME_CHECK(days[0] == date::sys_days(date::year(2024) / date::January / 3));
+	DATETIME_CHECK(days[15] == date::sys_days(date::year(2024) / date::February / 1));
+	DATETIME_CHECK(FireDays("0 0 1-31/2 * *", 20) == days);
+});
+
+DATETIME_TEST("Cron/SteppedDayOfWeek", [] {
+	auto days = FireDays("0 0 * * */2", 20);
+	for (auto day : days) {
+		auto weekday = date::weekday(day);
+		DATETIME_CHECK(weekday == date::Sunday || weekday == date::Tuesday || weekday == date::Thursday || weekday == date::Saturday);
+	}
+	// Tuesday Jan 2, Thursday Jan 4, Saturday Jan 6, Sunday Jan 7
+	DATETIME_CHECK(days[0] == date::sys_days(date::year(2024) / date::January / 2));
+	DATETIME_CHECK(days[3] == date::sys_days(date::year(2024) / date::January / 7));
+	DATETIME_CHECK(FireDays("0 0 * * 0-6/2", 20) == days);
+});
+
+DATETIME_TEST("Cron/BothDayFieldsRestricted", [] {
+	// The 15th or any Monday
+	auto days = FireDays("0 0 15 * MON", 6);
+	const date::sys_days expected[] = {
+		date::year(2024) / date::January / 8, date::year(2024) / date::January / 15,
+		date::year(2024) / date::January / 22, date::year(2024) / date::January / 29,
+		date::year(2024) / date::February / 5, date::year(2024) / date::February / 12,
+	};
+	DATETIME_CHECK(days == std::vector<date::sys_days>(std::begin(expected), std::end(expected)));
+	// A stepped star is restricted too, so days matching either field fire
+	days = FireDays("0 0 */10 * MON", 6);
+	const date::sys_days stepped[] = {
+		date::year(2024) / date::January / 8, date::year(2024) / date::January / 11,
+		date::year(2024) / date::January / 15, date::year(2024) / date::January / 21,
+		date::year(2024) / date::January / 22, date::year(2024) / date::January / 29,
+	};
+	DATETIME_CHECK(days == std::vector<date::sys_days>(std::begin(stepped), std::end(stepped)));
+});
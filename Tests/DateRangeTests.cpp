@@ -0,0 +1,33 @@
+#include <chrono>
+#include <cstddef>
+
+#include "DateRange.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+
+namespace {
+/// Counts the hourly instants of a fortnight from 2024-03-25, a Monday, that fall on a Monday
+/// in zone, whose first and last offset periods reach years a nanosecond count cannot hold.
+std::size_t MondayHours(const char *zone) {
+	using namespace std::chrono;
+	auto start = date::local_days(date::year(2024) / date::March / 25);
+	DateTime<nanoseconds> first = date::make_zoned(zone, date::local_time<nanoseconds>(start), date::choose::earliest);
+	DateTime<nanoseconds> last = date::make_zoned(zone, date::local_time<nanoseconds>(start + date::days(14)), date::choose::earliest);
+	std::size_t count = 0;
+	for (auto dt : DateTimeRange<nanoseconds>(first, last, TimeDelta(hours(1))).OnWeekdays({date::Monday})) {
+		DATETIME_CHECK(dt.Date().ObjWeekday() == date::Monday);
+		++count;
+	}
+	return count;
+}
+}
+
+DATETIME_TEST("DateRange/NanosecondsInSinglePeriodZone", [] {
+	DATETIME_CHECK_EQUAL(MondayHours("UTC"), std::size_t(48));
+	DATETIME_CHECK_EQUAL(MondayHours("Etc/GMT-14"), std::size_t(48));
+});
+
+DATETIME_TEST("DateRange/NanosecondsAcrossTransitions", [] {
+	DATETIME_CHECK_EQUAL(MondayHours("Europe/Berlin"), std::size_t(48));
+});
@@ -0,0 +1,133 @@
+#include <chrono>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "SerialDate.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+
+namespace {
+struct IsoCase {
+	date::year_month_day date;
+	int isoYear;
+	unsigned isoWeek;
+	unsigned weekday;
+};
+
+/// Around the turn of the year, where the ISO year differs from the calendar year, and the
+/// weeks 53 of long years.
+const IsoCase isoCases[] = {
+	{date::year(2004) / 12 / 31, 2004, 53, 4},
+	{date::year(2005) / 1 / 1, 2004, 53, 5},
+	{date::year(2005) / 1 / 2, 2004, 53, 6},
+	{date::year(2005) / 1 / 3, 2005, 1, 0},
+	{date::year(2007) / 12 / 31, 2008, 1, 0},
+	{date::year(2008) / 1 / 1, 2008, 1, 1},
+	{date::year(2008) / 12 / 28, 2008, 52, 6},
+	{date::year(2008) / 12 / 29, 2009, 1, 0},
+	{date::year(2008) / 12 / 31, 2009, 1, 2},
+	{date::year(2009) / 12 / 31, 2009, 53, 3},
+	{date::year(2010) / 1 / 1, 2009, 53, 4},
+	{date::year(2010) / 1 / 3, 2009, 53, 6},
+	{date::year(2010) / 1 / 4, 2010, 1, 0},
+	{date::year(2014) / 12 / 29, 2015, 1, 0},
+	{date::year(2015) / 12 / 31, 2015, 53, 3},
+	{date::year(2016) / 1 / 3, 2015, 53, 6},
+	{date::year(2019) / 12 / 30, 2020, 1, 0},
+	{date::year(2020) / 12 / 31, 2020, 53, 3},
+	{date::year(2021) / 1 / 1, 2020, 53, 4},
+	{date::year(2021) / 1 / 3, 2020, 53, 6},
+	{date::year(2021) / 1 / 4, 2021, 1, 0},
+	{date::year(2026) / 12 / 31, 2026, 53, 3},
+	{date::year(2027) / 1 / 3, 2026, 53, 6},
+	{date::year(2000) / 1 / 1, 1999, 52, 5},
+	{date::year(2000) / 12 / 31, 2000, 52, 6},
+	{date::year(1970) / 1 / 1, 1970, 1, 3},
+	{date::year(1969) / 12 / 28, 1969, 52, 6},
+	{date::year(1969) / 12 / 29, 1970, 1, 0},
+	{date::year(1900) / 1 / 1, 1900, 1, 0},
+	{date::year(1600) / 12 / 31, 1600, 52, 6},
+};
+
+/// The ISO week date the long way round: the week of the Thursday of the same Monday week.
+IsoCase Reference(date::sys_days day) {
+	auto weekday = date::weekday(day).iso_encoding() - 1;
+	auto thursday = day - date::days(weekday) + date::days(3);
+	auto year = date::year_month_day(thursday).year();
+	auto week = (thursday - date::sys_days(year / 1 / 1)).count() / 7 + 1;
+	return {date::year_month_day(day), static_cast<int>(year), static_cast<unsigned>(week), weekday};
+}
+
+DateTime<std::chrono::seconds> Noon(const date::year_month_day &ymd) {
+	static const auto utc = date::locate_zone("UTC");
+	return date::make_zoned(utc, date::sys_days(ymd) + std::chrono::hours(12));
+}
+}
+
+DATETIME_TEST("Date/IsoWeekEdges", [] {
+	for (auto &c : isoCases) {
+		Date d(c.date);
+		SerialDate s(c.date);
+		auto dt = Noon(c.date);
+		DATETIME_CHECK_EQUAL(static_cast<int>(d.IsoWeekYear()), c.isoYear);
+		DATETIME_CHECK_EQUAL(d.IsoWeek(), c.isoWeek);
+		DATETIME_CHECK_EQUAL(d.Weekday(), c.weekday);
+		DATETIME_CHECK_EQUAL(static_cast<int>(s.IsoWeekYear()), c.isoYear);
+		DATETIME_CHECK_EQUAL(s.IsoWeek(), c.isoWeek);
+		DATETIME_CHECK_EQUAL(s.Weekday(), c.weekday);
+		DATETIME_CHECK_EQUAL(static_cast<int>(dt.IsoWeekYear()), c.isoYear);
+		DATETIME_CHECK_EQUAL(dt.IsoWeek(), c.isoWeek);
+		DATETIME_CHECK_EQUAL(dt.Weekday(), c.weekday);
+	}
+});
+
+DATETIME_TEST("Date/FieldsMatchReference", [] {
+	// Every day of 1599-2401, so every kind of year and both ends of the leap year rules
+	std::size_t wrong = 0;
+	for (auto day = date::sys_days(date::year(1599) / 1 / 1); day < date::sys_days(date::year(2402) / 1 / 1); day += date::days(1)) {
+		auto expected = Reference(day);
+		auto ymd = expected.date;
+		auto doy = static_cast<unsigned>((day - date::sys_days(ymd.year() / 1 / 1)).count() + 1);
+		auto quarter = (static_cast<unsigned>(ymd.month()) - 1) / 3 + 1;
+		Date d(ymd);
+		SerialDate s(day);
+		auto dt = Noon(ymd);
+		wrong += d.Weekday() != expected.weekday || d.IsoWeekday() != expected.weekday + 1 || d.DayOfYear() != doy || d.Quarter() != quarter
+			|| d.IsoWeek() != expected.isoWeek || static_cast<int>(d.IsoWeekYear()) != expected.isoYear;
+		wrong += s.Weekday() != expected.weekday || s.IsoWeekday() != expected.weekday + 1 || s.DayOfYear() != doy || s.Quarter() != quarter
+			|| s.IsoWeek() != expected.isoWeek || static_cast<int>(s.IsoWeekYear()) != expected.isoYear;
+		wrong += dt.Weekday() != expected.weekday || dt.IsoWeekday() != expected.weekday + 1 || dt.DayOfYear() != doy || dt.Quarter() != quarter
+			|| dt.IsoWeek() != expected.isoWeek || static_cast<int>(dt.IsoWeekYear()) != expected.isoYear;
+	}
+	DATETIME_CHECK_EQUAL(wrong, std::size_t(0));
+});
+
+DATETIME_TEST("Date/WeekdayFarFromEpoch", [] {
+	// The unsigned % in detail::Weekday has to hold for negative day counts too
+	const date::year_month_day days[] = {
+		date::year(-32767) / 1 / 1, date::year(-1) / 12 / 31, date::year(0) / 1 / 1, date::year(1) / 1 / 1,
+		date::year(1969) / 12 / 31, date::year(1970) / 1 / 4, date::year(1970) / 1 / 5, date::year(32767) / 12 / 31,
+	};
+	for (auto &ymd : days) {
+		auto expected = date::weekday(ymd).iso_encoding() - 1;
+		DATETIME_CHECK_EQUAL(Date(ymd).Weekday(), expected);
+		DATETIME_CHECK_EQUAL(SerialDate(ymd).Weekday(), expected);
+		DATETIME_CHECK(Date(ymd).ObjWeekday() == date::weekday(ymd));
+	}
+});
+
+DATETIME_TEST("Date/ColumnFields", [] {
+	std::vector<Date> dates;
+	for (auto &c : isoCases)
+		dates.emplace_back(c.date);
+	std::vector<int> weekdays(dates.size()), weeks(dates.size()), years(dates.size());
+	Weekdays(dates.data(), dates.size(), weekdays.data());
+	IsoWeeks(dates.data(), dates.size(), weeks.data());
+	IsoWeekYears(dates.data(), dates.size(), years.data());
+	for (std::size_t i = 0; i < dates.size(); ++i) {
+		DATETIME_CHECK_EQUAL(weekdays[i], static_cast<int>(isoCases[i].weekday));
+		DATETIME_CHECK_EQUAL(weeks[i], static_cast<int>(isoCases[i].isoWeek));
+		DATETIME_CHECK_EQUAL(years[i], isoCases[i].isoYear);
+	}
+});
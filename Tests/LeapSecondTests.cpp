@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LeapSeconds.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+using namespace std::chrono;
+
+namespace {
+/// Instants from two seconds before to two seconds after every leap second. In utc time
+/// leap second k starts k seconds after its sys date, so a quarter of them fall during it.
+template<class Duration>
+std::vector<Duration> AroundLeaps(Duration step, bool utc = false) {
+	std::vector<Duration> times;
+	seconds earlier(0);
+	for (const auto &leap : date::get_tzdb().leap_seconds) {
+		auto at = leap.date().time_since_epoch() + (utc ? earlier : seconds(0));
+		for (auto t = Duration(at - seconds(2)); t <= at + seconds(2); t += step)
+			times.push_back(t);
+		earlier += seconds(1);
+	}
+	return times;
+}
+
+template<class Duration>
+void CheckAgainstClocks(Duration step) {
+	LeapSeconds leaps;
+	std::size_t mismatches = 0, during = 0;
+	for (auto t : AroundLeaps(step)) {
+		auto sys = date::sys_time<Duration>(t);
+		mismatches += leaps.ToUtc(sys) != date::clock_cast<date::utc_clock>(sys);
+		mismatches += leaps.ToTai(sys) != date::clock_cast<date::tai_clock>(sys);
+		mismatches += leaps.ToGps(sys) != date::clock_cast<date::gps_clock>(sys);
+		mismatches += leaps.Elapsed(sys) != date::get_leap_second_info(date::utc_clock::from_sys(sys)).elapsed;
+	}
+	for (auto t : AroundLeaps(step, true)) {
+		// Utc instants during a leap second map to the last tick before it
+		auto utc = date::utc_time<Duration>(t);
+		during += date::get_leap_second_info(utc).is_leap_second;
+		mismatches += leaps.ToSys(utc) != date::utc_clock::to_sys(utc);
+		mismatches += leaps.ToSys(date::clock_cast<date::tai_clock>(utc)) != date::clock_cast<std::chrono::system_clock>(date::clock_cast<date::tai_clock>(utc));
+		mismatches += leaps.ToSys(date::clock_cast<date::gps_clock>(utc)) != date::clock_cast<std::chrono::system_clock>(date::clock_cast<date::gps_clock>(utc));
+	}
+	if (mismatches != 0)
+		test::Fail(__FILE__, __LINE__, std::to_string(mismatches) + " conversions differ from the date clocks");
+}
+}
+
+DATETIME_TEST("LeapSeconds/Seconds", [] {
+	CheckAgainstClocks(seconds(1));
+});
+
+DATETIME_TEST("LeapSeconds/Milliseconds", [] {
+	CheckAgainstClocks(milliseconds(250));
+});
+
+DATETIME_TEST("LeapSeconds/Nanoseconds", [] {
+	CheckAgainstClocks(nanoseconds(333333333));
+});
+
+DATETIME_TEST("LeapSeconds/DuringLeapSecond", [] {
+	// 2016-12-31 23:59:60 UTC
+	LeapSeconds leaps;
+	auto leap = date::clock_cast<date::utc_clock>(date::sys_seconds(date::sys_days(date::year(2017) / date::January / 1))) - seconds(1);
+	DATETIME_CHECK(date::get_leap_second_info(leap).is_leap_second);
+	auto last = date::sys_days(date::year(2017) / date::January / 1) - milliseconds(1);
+	DATETIME_CHECK(leaps.ToSys(leap + milliseconds(0)) == last);
+	DATETIME_CHECK(leaps.ToSys(leap + milliseconds(999)) == last);
+	DATETIME_CHECK(leaps.ToSys(leap + milliseconds(1000)) == last + milliseconds(1));
+	DATETIME_CHECK(leaps.ToUtc(last + milliseconds(1)) == leap + seconds(1));
+	DATETIME_CHECK_EQUAL(leaps.Elapsed(last).count(), 26);
+	DATETIME_CHECK_EQUAL(leaps.Elapsed(last + milliseconds(1)).count(), 27);
+});
+
+DATETIME_TEST("LeapSeconds/Spans", [] {
+	// Shuffled, so the cursor misses, and sorted, so it moves on
+	LeapSeconds leaps;
+	std::vector<date::sys_seconds> sys;
+	std::mt19937_64 random(11);
+	std::uniform_int_distribution<std::int64_t> seconds1960To2040(-315619200, 2208988800);
+	for (int i = 0; i < 20000; ++i)
+		sys.push_back(date::sys_seconds(seconds(seconds1960To2040(random))));
+	for (auto t : AroundLeaps(seconds(1)))
+		sys.push_back(date::sys_seconds(t));
+	for (int pass = 0; pass < 2; ++pass) {
+		std::vector<date::utc_seconds> utc(sys.size());
+		std::vector<date::sys_seconds> back(sys.size());
+		leaps.ToUtc(sys.begin(), sys.end(), utc.begin());
+		leaps.ToSys(utc.begin(), utc.end(), back.begin());
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < sys.size(); ++i)
+			mismatches += utc[i] != date::utc_clock::from_sys(sys[i]) || back[i] != sys[i];
+		if (mismatches != 0)
+			test::Fail(__FILE__, __LINE__, std::to_string(mismatches) + " span conversions differ from utc_clock");
+		std::sort(sys.begin(), sys.end());
+	}
+});
@@ -0,0 +1,102 @@
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "LocalTimeFilter.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+using namespace std::chrono;
+
+namespace {
+struct Conditions {
+	bool timeOfDay;
+	seconds from, to;
+	bool weekdays;
+	bool dateRange;
+	Date first, last;
+	int dst; // -1 any, 0 not in DST, 1 in DST
+};
+
+LocalTimeFilter MakeFilter(const date::time_zone *zone, const Conditions &c) {
+	LocalTimeFilter filter(zone);
+	if (c.timeOfDay)
+		filter.TimeOfDay(c.from, c.to);
+	if (c.weekdays)
+		filter.OnWeekdays({date::Monday, date::Tuesday, date::Wednesday, date::Thursday, date::Friday});
+	if (c.dateRange)
+		filter.Between(c.first, c.last);
+	if (c.dst >= 0)
+		filter.InDst(c.dst == 1);
+	return filter;
+}
+
+/// The conditions checked one row at a time through DateTime.
+template<class Duration>
+bool Reference(const date::time_zone *zone, const Conditions &c, date::sys_time<Duration> t) {
+	DateTime<Duration> dt{date::make_zoned(zone, t)};
+	auto local = dt.ZonedTime().get_local_time();
+	auto day = date::floor<date::days>(local);
+	auto time = local - day;
+	if (c.timeOfDay && !(c.from > c.to ? time >= c.from || time < c.to : time >= c.from && time < c.to))
+		return false;
+	auto weekday = date::weekday(day);
+	if (c.weekdays && (weekday == date::Saturday || weekday == date::Sunday))
+		return false;
+	if (c.dateRange && (day < date::local_days(c.first.YearMonthDay()) || day >= date::local_days(c.last.YearMonthDay())))
+		return false;
+	if (c.dst >= 0 && (dt.ZonedTime().get_info().save != minutes(0)) != (c.dst == 1))
+		return false;
+	return true;
+}
+
+template<class Duration>
+void CheckColumn(const date::time_zone *zone, const std::vector<date::sys_time<Duration>> &column) {
+	const Conditions conditions[] = {
+		{true, hours(9), hours(17), true, false, {}, {}, -1},
+		{true, hours(22), hours(6) + seconds(1), false, false, {}, {}, 1},
+		{true, hours(1) + minutes(30), hours(3), false, true, Date(date::year(2024) / date::March / 30), Date(date::year(2024) / date::April / 1), -1},
+		{false, {}, {}, false, false, {}, {}, 0},
+		{false, {}, {}, false, false, {}, {}, -1},
+	};
+	for (auto &c : conditions) {
+		auto mask = MakeFilter(zone, c).Evaluate(column);
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < column.size(); ++i)
+			mismatches += bool((mask[i / 64] >> (i % 64)) & 1) != Reference(zone, c, column[i]);
+		DATETIME_CHECK_EQUAL(mismatches, std::size_t(0));
+		if (column.size() % 64 != 0)
+			DATETIME_CHECK_EQUAL(mask.back() >> (column.size() % 64), std::uint64_t(0));
+	}
+}
+
+/// Rows a few minutes and a fraction of a second apart across the Berlin spring forward of
+/// 2024, sorted, then the same rows in blocks spread over years.
+template<class Duration>
+void CheckAroundTransition() {
+	auto zone = date::locate_zone("Europe/Berlin");
+	auto transition = date::sys_days(date::year(2024) / date::March / 31) + hours(1);
+	std::vector<date::sys_time<Duration>> column;
+	for (auto t = date::sys_time<Duration>(transition - hours(80)); t < transition + hours(80); t += date::floor<Duration>(minutes(7) + nanoseconds(13370001)))
+		column.push_back(t);
+	CheckColumn(zone, column);
+	std::vector<date::sys_time<Duration>> spread;
+	for (std::size_t i = 0; i < column.size(); ++i)
+		spread.push_back(column[i] + date::days(397) * static_cast<int>(i % 5) - date::days(3000));
+	CheckColumn(zone, spread);
+}
+}
+
+DATETIME_TEST("LocalTimeFilter/AroundTransition/Seconds", [] { CheckAroundTransition<seconds>(); });
+DATETIME_TEST("LocalTimeFilter/AroundTransition/Milliseconds", [] { CheckAroundTransition<milliseconds>(); });
+DATETIME_TEST("LocalTimeFilter/AroundTransition/Microseconds", [] { CheckAroundTransition<microseconds>(); });
+DATETIME_TEST("LocalTimeFilter/AroundTransition/Nanoseconds", [] { CheckAroundTransition<nanoseconds>(); });
+
+DATETIME_TEST("LocalTimeFilter/UtcNanoseconds", [] {
+	// UTC has a single period reaching far past what nanoseconds can hold
+	auto zone = date::locate_zone("UTC");
+	std::vector<date::sys_time<nanoseconds>> column;
+	for (auto t = date::sys_time<nanoseconds>(date::sys_days(date::year(2024) / date::January / 1)); column.size() < 640; t += minutes(97) + nanoseconds(1))
+		column.push_back(t);
+	CheckColumn(zone, column);
+});
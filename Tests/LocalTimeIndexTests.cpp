@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LocalTimeIndex.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+using namespace std::chrono;
+
+namespace {
+/// Local times a minute apart, plus a few milliseconds, from two hours before to two hours
+/// after every transition of the zone between first and last.
+std::vector<date::local_time<milliseconds>> AroundTransitions(const date::time_zone *zone, date::year first, date::year last) {
+	std::vector<date::local_time<milliseconds>> times;
+	auto to = date::sys_seconds(date::sys_days(last / date::December / 31));
+	auto info = zone->get_info(date::sys_seconds(date::sys_days(first / date::January / 1)));
+	while (info.end < to) {
+		auto next = zone->get_info(info.end);
+		auto local = date::local_seconds((info.end + info.offset).time_since_epoch());
+		for (auto t = local - hours(2); t <= local + hours(2); t += minutes(1))
+			times.push_back(t + milliseconds(t.time_since_epoch().count() % 3 * 250));
+		info = next;
+	}
+	return times;
+}
+
+/// What zone->to_sys gives, or the exception it throws as a negative marker.
+template<class Convert>
+std::string Outcome(Convert &&convert) {
+	try {
+		return std::to_string(convert().time_since_epoch().count());
+	} catch (const date::nonexistent_local_time &) {
+		return "nonexistent";
+	} catch (const date::ambiguous_local_time &) {
+		return "ambiguous";
+	}
+}
+
+void CheckAgainstZone(const char *name, const std::vector<date::local_time<milliseconds>> &times, const LocalTimeIndex &index) {
+	auto zone = date::locate_zone(name);
+	std::size_t mismatches = 0;
+	for (auto t : times) {
+		mismatches += Outcome([&] { return index.ToSys(t, DstPolicy::Earliest); }) != Outcome([&] { return zone->to_sys(t, date::choose::earliest); });
+		mismatches += Outcome([&] { return index.ToSys(t, DstPolicy::Latest); }) != Outcome([&] { return zone->to_sys(t, date::choose::latest); });
+		mismatches += Outcome([&] { return index.ToSys(t); }) != Outcome([&] { return zone->to_sys(t); });
+	}
+	if (mismatches != 0)
+		test::Fail(__FILE__, __LINE__, std::string(name) + ": " + std::to_string(mismatches) + " conversions differ from to_sys");
+}
+
+const char *const Zones[] = {"Europe/Berlin", "America/New_York", "Australia/Sydney", "Australia/Lord_Howe", "Asia/Tokyo"};
+}
+
+DATETIME_TEST("LocalTimeIndex/GapsAndOverlaps", [] {
+	for (auto name : Zones) {
+		auto zone = date::locate_zone(name);
+		LocalTimeIndex index(zone, date::year(2020), date::year(2030));
+		auto times = AroundTransitions(zone, date::year(2020), date::year(2030));
+		CheckAgainstZone(name, times, index);
+		// Out of order, so the segment hint misses
+		std::shuffle(times.begin(), times.end(), std::mt19937(7));
+		CheckAgainstZone(name, times, index);
+	}
+});
+
+DATETIME_TEST("LocalTimeIndex/OutsideRange", [] {
+	// Converted through the zone
+	auto zone = date::locate_zone("Europe/Berlin");
+	LocalTimeIndex index(zone, date::year(2020), date::year(2021));
+	std::vector<date::local_time<milliseconds>> times;
+	for (auto year : {1996, 2019, 2022, 2040}) {
+		for (auto t : AroundTransitions(zone, date::year(year), date::year(year)))
+			times.push_back(t);
+	}
+	CheckAgainstZone("Europe/Berlin", times, index);
+});
+
+DATETIME_TEST("LocalTimeIndex/Spans", [] {
+	for (auto name : Zones) {
+		auto zone = date::locate_zone(name);
+		LocalTimeIndex index(zone, date::year(2024), date::year(2025));
+		std::vector<date::local_seconds> times;
+		for (date::local_seconds t = date::local_days(date::year(2024) / date::January / 1); t < date::local_days(date::year(2026) / date::January / 1); t += minutes(37))
+			times.push_back(t);
+		for (auto policy : {DstPolicy::Earliest, DstPolicy::Latest}) {
+			std::vector<date::sys_seconds> out(times.size());
+			index.ToSys(times.begin(), times.end(), out.begin(), policy);
+			auto choose = policy == DstPolicy::Earliest ? date::choose::earliest : date::choose::latest;
+			std::size_t mismatches = 0;
+			for (std::size_t i = 0; i < times.size(); ++i)
+				mismatches += out[i] != zone->to_sys(times[i], choose);
+			if (mismatches != 0)
+				test::Fail(__FILE__, __LINE__, std::string(name) + ": " + std::to_string(mismatches) + " span conversions differ from to_sys");
+		}
+	}
+});
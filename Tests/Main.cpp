@@ -0,0 +1,52 @@
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "Test.hpp"
+
+using namespace datetime::test;
+
+namespace {
+std::size_t failures = 0;
+}
+
+void datetime::test::Fail(const char *file, int line, const std::string &message) {
+	++failures;
+	std::cerr << file << ':' << line << ": " << message << std::endl;
+}
+
+/// Runs every registered test whose name starts with the filter, in name order, and returns
+/// non-zero when one of them fails.
+///
+/// Usage:
+///   DateTimeCPP_tests [filter]
+///
+/// Tests that reload the tz database, under ZoneDatabase/, sort last so that they run after
+/// the others when no filter is given.
+int main(int argc, char **argv) {
+	std::string filter = argc > 1 ? argv[1] : "";
+	auto tests = Registry();
+	std::stable_sort(tests.begin(), tests.end(), [](const Test &x, const Test &y) { return x.name < y.name; });
+	std::size_t run = 0, failed = 0;
+	for (auto &test : tests) {
+		if (test.name.compare(0, filter.size(), filter) != 0)
+			continue;
+		++run;
+		auto before = failures;
+		try {
+			test.run();
+		} catch (const std::exception &e) {
+			Fail(__FILE__, __LINE__, test.name + " threw " + e.what());
+		}
+		if (failures != before) {
+			++failed;
+			std::cout << "FAIL " << test.name << std::endl;
+		} else {
+			std::cout << "ok   " << test.name << std::endl;
+		}
+	}
+	std::cout << run - failed << " of " << run << " tests passed" << std::endl;
+	return failed == 0 && run > 0 ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+#include <chrono>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "DateTime.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+
+namespace {
+/// Instants with a fraction of 3, 6 and 9 significant digits and none, around the epoch.
+template<class Duration>
+void CheckRoundTrip() {
+	using namespace std::chrono;
+	const nanoseconds instants[] = {
+		seconds(1700000000) + milliseconds(123),
+		seconds(1700000000) + microseconds(123456),
+		seconds(1700000000) + nanoseconds(123456789),
+		seconds(1700000000),
+		-seconds(86400) + nanoseconds(999999999),
+	};
+	for (auto ns : instants) {
+		auto tp = date::floor<Duration>(date::sys_time<nanoseconds>(ns));
+		DateTime<Duration> dt = date::make_zoned(date::current_zone(), tp);
+		auto text = dt.Format(ISO8601_FRAC_FORMAT);
+		auto parsed = DateTime<Duration>::Parse(text, std::string(ISO8601_FRAC_FORMAT));
+		DATETIME_CHECK_EQUAL(parsed.Format(ISO8601_FRAC_FORMAT), text);
+		DATETIME_CHECK(parsed.ZonedTime().get_sys_time() == tp);
+	}
+}
+}
+
+DATETIME_TEST("Parse/FracRoundTrip/Milliseconds", [] { CheckRoundTrip<std::chrono::milliseconds>(); });
+DATETIME_TEST("Parse/FracRoundTrip/Microseconds", [] { CheckRoundTrip<std::chrono::microseconds>(); });
+DATETIME_TEST("Parse/FracRoundTrip/Nanoseconds", [] { CheckRoundTrip<std::chrono::nanoseconds>(); });
+
+DATETIME_TEST("Parse/FracRoundTrip/Now", [] {
+	auto now = DateTime<std::chrono::microseconds>::Now();
+	auto parsed = DateTime<std::chrono::microseconds>::Parse(now.Format(ISO8601_FRAC_FORMAT), std::string(ISO8601_FRAC_FORMAT));
+	DATETIME_CHECK(parsed.ZonedTime().get_sys_time() == now.ZonedTime().get_sys_time());
+});
+
+DATETIME_TEST("Parse/FracDigits", [] {
+	using namespace std::chrono;
+	auto base = date::local_days(date::year(2024) / date::March / 5) + hours(10) + minutes(20) + seconds(30);
+	const struct {
+		const char *text;
+		nanoseconds fraction;
+	} cases[] = {
+		{"2024-03-05T10:20:30.123", milliseconds(123)},
+		{"2024-03-05T10:20:30.123456", microseconds(123456)},
+		{"2024-03-05T10:20:30.123456789", nanoseconds(123456789)},
+		{"2024-03-05T10:20:30.5", milliseconds(500)},
+	};
+	for (auto &c : cases) {
+		auto parsed = DateTime<nanoseconds>::Parse(c.text, "%Y-%m-%dT%H:%M:%S");
+		DATETIME_CHECK(parsed.ZonedTime().get_local_time() == base + c.fraction);
+	}
+	auto truncated = DateTime<microseconds>::Parse("2024-03-05T10:20:30.123456789", "%Y-%m-%dT%H:%M:%S");
+	DATETIME_CHECK(truncated.ZonedTime().get_local_time() == base + microseconds(123456));
+	// The same through the single pass parser of ISO8601_FRAC_FORMAT and SORTABLE_FORMAT
+	for (auto &c : cases) {
+		auto parsed = DateTime<nanoseconds>::Parse(std::string(c.text) + "+0000", std::string(ISO8601_FRAC_FORMAT));
+		DATETIME_CHECK(parsed.ZonedTime().get_local_time() == base + c.fraction);
+	}
+	auto sortable = DateTime<microseconds>::Parse("2024-03-05 10:20:30.123456789", std::string(SORTABLE_FORMAT));
+	DATETIME_CHECK(sortable.ZonedTime().get_local_time() == base + microseconds(123456));
+});
+
+namespace {
+/// Text parses the same whether or not the format has a single pass parser: date::parse with the
+/// equivalent format that has none decides.
+template<class Duration>
+void CheckLikeDateParse(const std::string &text, const std::string &format, const std::string &slowFormat) {
+	date::local_time<Duration> expected;
+	std::istringstream ss(text);
+	ss >> date::parse(slowFormat, expected);
+	auto parsed = DateTime<Duration>::TryParse(text, format);
+	DATETIME_CHECK_EQUAL(parsed.has_value(), !ss.fail());
+	if (parsed && !ss.fail())
+		DATETIME_CHECK(parsed->ZonedTime().get_local_time() == expected);
+}
+
+template<class Duration>
+void CheckFractionsLikeDateParse() {
+	for (auto fraction : {"", ".1", ".123", ".1234", ".123456", ".1234567", ".123456789", ".1234567891"}) {
+		auto text = std::string("2024-03-05T10:20:30") + fraction;
+		CheckLikeDateParse<Duration>(text + "+0000", std::string(ISO8601_FRAC_FORMAT), "%Y-%m-%dT%H:%M:%S%z");
+		CheckLikeDateParse<Duration>(text + "-05:30", std::string(ISO8601_FORMAT), "%Y-%m-%dT%H:%M:%S%z");
+		text[10] = ' ';
+		CheckLikeDateParse<Duration>(text, std::string(SORTABLE_FORMAT), "%Y-%m-%d %H:%M:%S");
+	}
+}
+}
+
+DATETIME_TEST("Parse/FracLikeDateParse", [] {
+	CheckFractionsLikeDateParse<std::chrono::seconds>();
+	CheckFractionsLikeDateParse<std::chrono::milliseconds>();
+	CheckFractionsLikeDateParse<std::chrono::microseconds>();
+	CheckFractionsLikeDateParse<std::chrono::nanoseconds>();
+});
+
+DATETIME_TEST("Parse/OffsetOutOfRange", [] {
+	using Parsed = DateTime<std::chrono::seconds, FixedOffsetZone>;
+	const std::string iso(ISO8601_FORMAT);
+	Parsed parsed;
+	for (auto text : {"2024-03-05T10:20:30+25:00", "2024-03-05T10:20:30-24:00", "2024-03-05T10:20:30+2400"}) {
+		DATETIME_CHECK(!DateTime<std::chrono::seconds>::TryParseOffset(text, iso, parsed));
+		bool invalid = false;
+		try {
+			DateTime<std::chrono::seconds>::ParseOffset(text, iso);
+		} catch (const std::invalid_argument &) {
+			invalid = true;
+		}
+		DATETIME_CHECK(invalid);
+	}
+	DATETIME_CHECK(DateTime<std::chrono::seconds>::TryParseOffset("2024-03-05T10:20:30+2359", iso, parsed));
+	DATETIME_CHECK(parsed.ZonedTime().get_time_zone().Offset() == std::chrono::hours(23) + std::chrono::minutes(59));
+	DATETIME_CHECK(DateTime<std::chrono::seconds>::TryParseOffset("2024-03-05T10:20:30-2359", iso, parsed));
+	DATETIME_CHECK(DateTime<std::chrono::seconds>::TryParseOffset("2024-03-05T10:20:30-23:59", "%FT%T%Ez", parsed));
+});
+
+DATETIME_TEST("Parse/Zulu", [] {
+	using namespace std::chrono;
+	const std::string iso(ISO8601_FORMAT);
+	// %z does not read Z, on either path
+	DATETIME_CHECK(!DateTime<seconds>::TryParse("2024-03-01T12:00:00Z", iso));
+	DATETIME_CHECK(!DateTime<seconds>::TryParse("2024-03-01T12:00:00Z", "%FT%T%z"));
+	DATETIME_CHECK(!DateTime<milliseconds>::TryParse("2024-03-01T12:00:00.250Z", std::string(ISO8601_FRAC_FORMAT)));
+	CheckLikeDateParse<seconds>("2024-03-01T12:00:00Z", iso, "%Y-%m-%dT%H:%M:%S%z");
+	// Parsing an offset reads it as UTC
+	auto parsed = DateTime<seconds>::ParseOffset("2024-03-01T12:00:00Z", iso);
+	DATETIME_CHECK(parsed.ZonedTime().get_time_zone().Offset() == minutes(0));
+	DATETIME_CHECK(parsed.ZonedTime().get_sys_time() == date::sys_days(date::year(2024) / date::March / 1) + hours(12));
+	DATETIME_CHECK(DateTime<seconds>::ParseOffset("2024-03-01T12:00:00+0000", iso).ZonedTime().get_sys_time() == parsed.ZonedTime().get_sys_time());
+});
+
+namespace {
+/// The sys time and offset date::parse reads from all of text, or nothing.
+std::optional<std::pair<date::sys_seconds, std::chrono::minutes>> DateParseOffset(const std::string &text, const std::string &format) {
+	std::istringstream ss(text);
+	date::local_seconds tp;
+	std::chrono::minutes offset;
+	ss >> date::parse(format, tp, offset);
+	if (ss.fail() || ss.peek() != std::char_traits<char>::eof() || offset <= -date::days(1) || offset >= date::days(1))
+		return std::nullopt;
+	return std::make_pair(date::sys_seconds((tp - offset).time_since_epoch()), offset);
+}
+
+std::optional<std::pair<date::sys_seconds, std::chrono::minutes>> ParsedOffset(const std::string &text, const std::string &format) {
+	DateTime<std::chrono::seconds, FixedOffsetZone> parsed;
+	if (!DateTime<std::chrono::seconds>::TryParseOffset(text, format, parsed))
+		return std::nullopt;
+	return std::make_pair(parsed.ZonedTime().get_sys_time(), std::chrono::minutes(parsed.ZonedTime().get_time_zone().Offset()));
+}
+}
+
+DATETIME_TEST("Parse/OffsetLikeDateParse", [] {
+	// ISO8601_FORMAT has a single pass parser, "%FT%T%z" does not, and both read what date::parse
+	// reads from the whole text. The colon form belongs to %Ez, under %z it leaves text over.
+	for (auto offset : {"+0530", "-0800", "+05", "+00", "+05:30", "-08:00", "+05:3", "+053", "+05:", "+5", "+0560", "+2359", "+2400", "+99", "+0530 "}) {
+		auto text = std::string("2005-01-01T12:00:00") + offset;
+		auto expected = DateParseOffset(text, "%FT%T%z");
+		auto fast = ParsedOffset(text, std::string(ISO8601_FORMAT));
+		auto slow = ParsedOffset(text, "%FT%T%z");
+		DATETIME_CHECK(fast == expected);
+		DATETIME_CHECK(slow == expected);
+		DATETIME_CHECK(ParsedOffset(text, "%FT%T%Ez") == DateParseOffset(text, "%FT%T%Ez"));
+	}
+	DATETIME_CHECK(!ParsedOffset("2005-01-01T12:00:00+05:30", std::string(ISO8601_FORMAT)));
+	auto colon = ParsedOffset("2005-01-01T12:00:00+05:30", "%FT%T%Ez");
+	DATETIME_CHECK(colon && colon->second == std::chrono::minutes(330));
+	DATETIME_CHECK(colon && colon->first == date::sys_days(date::year(2005) / date::January / 1) + std::chrono::hours(6) + std::chrono::minutes(30));
+	// Z is read only by the ISO 8601 formats
+	DATETIME_CHECK(ParsedOffset("2005-01-01T12:00:00Z", std::string(ISO8601_FORMAT)).has_value());
+	DATETIME_CHECK(!ParsedOffset("2005-01-01T12:00:00Z", "%FT%T%z"));
+});
@@ -0,0 +1,165 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "RecurrenceRule.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+using namespace std::chrono;
+
+namespace {
+using Days = std::vector<date::local_days>;
+
+/// The local days of the occurrences of rule from dtstart at 09:00 in New York, as in the
+/// examples of RFC 5545 section 3.8.5.3, up to limit occurrences before 2002. Every occurrence
+/// has to keep the 09:00 wall clock time across DST.
+Days Occurrences(const char *rule, date::local_days dtstart, std::size_t limit = 1000) {
+	auto zone = date::locate_zone("America/New_York");
+	auto at = [&](date::local_days day) { return DateTime<seconds>(date::make_zoned(zone, date::local_seconds(day) + hours(9))); };
+	auto range = RecurrenceRule::Parse(rule).Between(at(dtstart), at(dtstart), at(date::local_days(date::year(2002) / date::January / 1)));
+	Days days;
+	for (auto it = range.begin(); it != range.end() && days.size() < limit; ++it) {
+		auto local = (*it).ZonedTime().get_local_time();
+		auto day = date::floor<date::days>(local);
+		DATETIME_CHECK(local - day == hours(9));
+		days.push_back(day);
+	}
+	return days;
+}
+
+date::local_days Day(int y, unsigned m, unsigned d) {
+	return date::local_days(date::year(y) / date::month(m) / date::day(d));
+}
+
+/// Checks the occurrences, printing both lists when they differ.
+void CheckDays(const Days &actual, const Days &expected, const char *rule) {
+	if (actual == expected)
+		return;
+	std::string message = std::string(rule) + ": got";
+	for (auto day : actual)
+		message += ' ' + date::format("%F", day);
+	message += ", expected";
+	for (auto day : expected)
+		message += ' ' + date::format("%F", day);
+	test::Fail(__FILE__, __LINE__, message);
+}
+}
+
+DATETIME_TEST("Recurrence/Daily", [] {
+	CheckDays(Occurrences("FREQ=DAILY;COUNT=10", Day(1997, 9, 2)),
+		{Day(1997, 9, 2), Day(1997, 9, 3), Day(1997, 9, 4), Day(1997, 9, 5), Day(1997, 9, 6), Day(1997, 9, 7), Day(1997, 9, 8), Day(1997, 9, 9),
+			Day(1997, 9, 10), Day(1997, 9, 11)}, "daily count");
+	auto until = Occurrences("RRULE:FREQ=DAILY;UNTIL=19971224T000000Z", Day(1997, 9, 2));
+	DATETIME_CHECK_EQUAL(until.size(), std::size_t(113));
+	DATETIME_CHECK(until.back() == Day(1997, 12, 23));
+	CheckDays(Occurrences("FREQ=DAILY;INTERVAL=10;COUNT=5", Day(1997, 9, 2)),
+		{Day(1997, 9, 2), Day(1997, 9, 12), Day(1997, 9, 22), Day(1997, 10, 2), Day(1997, 10, 12)}, "every 10 days");
+	auto january = Occurrences("FREQ=DAILY;UNTIL=20000131T140000Z;BYMONTH=1", Day(1998, 1, 1));
+	DATETIME_CHECK_EQUAL(january.size(), std::size_t(93));
+	for (auto day : january)
+		DATETIME_CHECK(date::year_month_day(day).month() == date::January);
+});
+
+DATETIME_TEST("Recurrence/CountAgainstUntil", [] {
+	// 09:00 EDT is 13:00 UTC, an inclusive UNTIL there ends the same as COUNT
+	auto count = Occurrences("FREQ=DAILY;COUNT=10", Day(1997, 9, 2));
+	CheckDays(Occurrences("FREQ=DAILY;UNTIL=19970911T130000Z", Day(1997, 9, 2)), count, "until utc");
+	CheckDays(Occurrences("FREQ=DAILY;UNTIL=19970911T090000", Day(1997, 9, 2)), count, "until local");
+	CheckDays(Occurrences("FREQ=DAILY;UNTIL=19970911", Day(1997, 9, 2)), count, "until date");
+	CheckDays(Occurrences("FREQ=WEEKLY;UNTIL=19971007T000000Z;WKST=SU;BYDAY=TU,TH", Day(1997, 9, 2)),
+		Occurrences("FREQ=WEEKLY;COUNT=10;WKST=SU;BYDAY=TU,TH", Day(1997, 9, 2)), "weekly until against count");
+	bool rejected = false;
+	try {
+		RecurrenceRule::Parse("FREQ=DAILY;COUNT=2;UNTIL=19971224T000000Z");
+	} catch (const std::invalid_argument &) {
+		rejected = true;
+	}
+	DATETIME_CHECK(rejected);
+});
+
+DATETIME_TEST("Recurrence/Weekly", [] {
+	// Across the end of DST on 1997-10-26
+	CheckDays(Occurrences("FREQ=WEEKLY;COUNT=10", Day(1997, 9, 2)),
+		{Day(1997, 9, 2), Day(1997, 9, 9), Day(1997, 9, 16), Day(1997, 9, 23), Day(1997, 9, 30), Day(1997, 10, 7), Day(1997, 10, 14), Day(1997, 10, 21),
+			Day(1997, 10, 28), Day(1997, 11, 4)}, "weekly");
+	CheckDays(Occurrences("FREQ=WEEKLY;UNTIL=19971007T000000Z;WKST=SU;BYDAY=TU,TH", Day(1997, 9, 2)),
+		{Day(1997, 9, 2), Day(1997, 9, 4), Day(1997, 9, 9), Day(1997, 9, 11), Day(1997, 9, 16), Day(1997, 9, 18), Day(1997, 9, 23), Day(1997, 9, 25),
+			Day(1997, 9, 30), Day(1997, 10, 2)}, "tuesdays and thursdays");
+	CheckDays(Occurrences("FREQ=WEEKLY;INTERVAL=2;COUNT=8;WKST=SU;BYDAY=TU,TH", Day(1997, 9, 2)),
+		{Day(1997, 9, 2), Day(1997, 9, 4), Day(1997, 9, 16), Day(1997, 9, 18), Day(1997, 9, 30), Day(1997, 10, 2), Day(1997, 10, 14), Day(1997, 10, 16)},
+		"every other week");
+	// WKST changes which days share a week
+	CheckDays(Occurrences("FREQ=WEEKLY;INTERVAL=2;COUNT=4;BYDAY=TU,SU;WKST=MO", Day(1997, 8, 5)),
+		{Day(1997, 8, 5), Day(1997, 8, 10), Day(1997, 8, 19), Day(1997, 8, 24)}, "wkst monday");
+	CheckDays(Occurrences("FREQ=WEEKLY;INTERVAL=2;COUNT=4;BYDAY=TU,SU;WKST=SU", Day(1997, 8, 5)),
+		{Day(1997, 8, 5), Day(1997, 8, 17), Day(1997, 8, 19), Day(1997, 8, 31)}, "wkst sunday");
+});
+
+DATETIME_TEST("Recurrence/MonthlyByDay", [] {
+	CheckDays(Occurrences("FREQ=MONTHLY;COUNT=10;BYDAY=1FR", Day(1997, 9, 5)),
+		{Day(1997, 9, 5), Day(1997, 10, 3), Day(1997, 11, 7), Day(1997, 12, 5), Day(1998, 1, 2), Day(1998, 2, 6), Day(1998, 3, 6), Day(1998, 4, 3),
+			Day(1998, 5, 1), Day(1998, 6, 5)}, "first friday");
+	CheckDays(Occurrences("FREQ=MONTHLY;INTERVAL=2;COUNT=10;BYDAY=1SU,-1SU", Day(1997, 9, 7)),
+		{Day(1997, 9, 7), Day(1997, 9, 28), Day(1997, 11, 2), Day(1997, 11, 30), Day(1998, 1, 4), Day(1998, 1, 25), Day(1998, 3, 1), Day(1998, 3, 29),
+			Day(1998, 5, 3), Day(1998, 5, 31)}, "first and last sunday");
+	CheckDays(Occurrences("FREQ=MONTHLY;COUNT=6;BYDAY=-2MO", Day(1997, 9, 22)),
+		{Day(1997, 9, 22), Day(1997, 10, 20), Day(1997, 11, 17), Day(1997, 12, 22), Day(1998, 1, 19), Day(1998, 2, 16)}, "second to last monday");
+});
+
+DATETIME_TEST("Recurrence/MonthlyByMonthDay", [] {
+	CheckDays(Occurrences("FREQ=MONTHLY;BYMONTHDAY=-3", Day(1997, 9, 28), 6),
+		{Day(1997, 9, 28), Day(1997, 10, 29), Day(1997, 11, 28), Day(1997, 12, 29), Day(1998, 1, 29), Day(1998, 2, 26)}, "third to last day");
+	CheckDays(Occurrences("FREQ=MONTHLY;COUNT=10;BYMONTHDAY=2,15", Day(1997, 9, 2)),
+		{Day(1997, 9, 2), Day(1997, 9, 15), Day(1997, 10, 2), Day(1997, 10, 15), Day(1997, 11, 2), Day(1997, 11, 15), Day(1997, 12, 2), Day(1997, 12, 15),
+			Day(1998, 1, 2), Day(1998, 1, 15)}, "2nd and 15th");
+	CheckDays(Occurrences("FREQ=MONTHLY;COUNT=10;BYMONTHDAY=1,-1", Day(1997, 9, 30)),
+		{Day(1997, 9, 30), Day(1997, 10, 1), Day(1997, 10, 31), Day(1997, 11, 1), Day(1997, 11, 30), Day(1997, 12, 1), Day(1997, 12, 31), Day(1998, 1, 1),
+			Day(1998, 1, 31), Day(1998, 2, 1)}, "first and last day");
+	// Every Friday the 13th, DTSTART itself not being one
+	CheckDays(Occurrences("FREQ=MONTHLY;BYDAY=FR;BYMONTHDAY=13", Day(1997, 9, 2), 5),
+		{Day(1998, 2, 13), Day(1998, 3, 13), Day(1998, 11, 13), Day(1999, 8, 13), Day(2000, 10, 13)}, "friday the 13th");
+	CheckDays(Occurrences("FREQ=MONTHLY;BYDAY=SA;BYMONTHDAY=7,8,9,10,11,12,13", Day(1997, 9, 13), 10),
+		{Day(1997, 9, 13), Day(1997, 10, 11), Day(1997, 11, 8), Day(1997, 12, 13), Day(1998, 1, 10), Day(1998, 2, 7), Day(1998, 3, 7), Day(1998, 4, 11),
+			Day(1998, 5, 9), Day(1998, 6, 13)}, "saturday after the first sunday");
+});
+
+DATETIME_TEST("Recurrence/MonthDayAndOrdinalIntersect", [] {
+	// The first Friday is never the 13th, the second one is whenever a Friday is
+	CheckDays(Occurrences("FREQ=MONTHLY;BYDAY=1FR;BYMONTHDAY=13", Day(1997, 9, 2)), {}, "first friday the 13th");
+	CheckDays(Occurrences("FREQ=MONTHLY;BYDAY=2FR;BYMONTHDAY=13", Day(1997, 9, 2), 5),
+		Occurrences("FREQ=MONTHLY;BYDAY=FR;BYMONTHDAY=13", Day(1997, 9, 2), 5), "second friday the 13th");
+	// The last Friday falling on the 25th or later
+	CheckDays(Occurrences("FREQ=MONTHLY;COUNT=4;BYDAY=-1FR;BYMONTHDAY=25,26,27,28,29,30,31", Day(1997, 9, 2)),
+		{Day(1997, 9, 26), Day(1997, 10, 31), Day(1997, 11, 28), Day(1997, 12, 26)}, "last friday from the 25th");
+	CheckDays(Occurrences("FREQ=MONTHLY;COUNT=4;BYDAY=-1FR;BYMONTHDAY=1,2,3,4,5,6,7", Day(1997, 9, 2)), {}, "last friday in the first week");
+	// Yearly without BYMONTH counts the ordinal within the year: the first Friday of 1998
+	// is January 2, of 1999 January 1
+	CheckDays(Occurrences("FREQ=YEARLY;BYDAY=1FR;BYMONTHDAY=1,2", Day(1997, 9, 2)), {Day(1998, 1, 2), Day(1999, 1, 1)}, "first friday of the year");
+});
+
+DATETIME_TEST("Recurrence/BySetPos", [] {
+	CheckDays(Occurrences("FREQ=MONTHLY;COUNT=3;BYDAY=TU,WE,TH;BYSETPOS=3", Day(1997, 9, 4)),
+		{Day(1997, 9, 4), Day(1997, 10, 7), Day(1997, 11, 6)}, "third tuesday to thursday");
+	CheckDays(Occurrences("FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-2", Day(1997, 9, 29), 7),
+		{Day(1997, 9, 29), Day(1997, 10, 30), Day(1997, 11, 27), Day(1997, 12, 30), Day(1998, 1, 29), Day(1998, 2, 26), Day(1998, 3, 30)},
+		"second to last weekday");
+});
+
+DATETIME_TEST("Recurrence/Yearly", [] {
+	CheckDays(Occurrences("FREQ=YEARLY;COUNT=10;BYMONTH=6,7", Day(1997, 6, 10)),
+		{Day(1997, 6, 10), Day(1997, 7, 10), Day(1998, 6, 10), Day(1998, 7, 10), Day(1999, 6, 10), Day(1999, 7, 10), Day(2000, 6, 10), Day(2000, 7, 10),
+			Day(2001, 6, 10), Day(2001, 7, 10)}, "june and july");
+	CheckDays(Occurrences("FREQ=YEARLY;BYDAY=20MO", Day(1997, 5, 19), 3), {Day(1997, 5, 19), Day(1998, 5, 18), Day(1999, 5, 17)}, "20th monday");
+	CheckDays(Occurrences("FREQ=YEARLY;BYMONTH=3;BYDAY=TH", Day(1997, 3, 13), 11),
+		{Day(1997, 3, 13), Day(1997, 3, 20), Day(1997, 3, 27), Day(1998, 3, 5), Day(1998, 3, 12), Day(1998, 3, 19), Day(1998, 3, 26), Day(1999, 3, 4),
+			Day(1999, 3, 11), Day(1999, 3, 18), Day(1999, 3, 25)}, "thursdays in march");
+	// A window starting years after DTSTART still counts the earlier occurrences
+	auto zone = date::locate_zone("America/New_York");
+	auto at = [&](date::local_days day) { return DateTime<seconds>(date::make_zoned(zone, date::local_seconds(day) + hours(9))); };
+	auto range = RecurrenceRule::Parse("FREQ=YEARLY;COUNT=10;BYMONTH=6,7").Between(at(Day(1997, 6, 10)), at(Day(2000, 1, 1)), at(Day(2010, 1, 1)));
+	Days days;
+	for (auto dt : range)
+		days.push_back(date::floor<date::days>(dt.ZonedTime().get_local_time()));
+	CheckDays(days, {Day(2000, 6, 10), Day(2000, 7, 10), Day(2001, 6, 10), Day(2001, 7, 10)}, "window after dtstart");
+});
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#include "DateTime.hpp"
+#include "Stats.hpp"
+#include "ZoneDatabase.hpp"
+#include "Test.hpp"
+
+#if TZ_STATS
+using namespace datetime;
+using namespace std::chrono;
+
+namespace {
+/// The work counted while f runs.
+template<class F>
+StatsSnapshot Counted(F f) {
+	auto before = Stats();
+	f();
+	return Stats() - before;
+}
+}
+
+DATETIME_TEST("Stats/LocateZone", [] {
+	auto hit = Counted([] { date::locate_zone("Europe/Berlin"); });
+	DATETIME_CHECK_EQUAL(hit.locateZoneHits, 1u);
+	DATETIME_CHECK_EQUAL(hit.locateZoneMisses, 0u);
+	DATETIME_CHECK_EQUAL(hit.exceptions, 0u);
+	auto miss = Counted([] {
+		try {
+			date::locate_zone("No/Such_Zone");
+		} catch (const std::runtime_error &) {
+		}
+	});
+	DATETIME_CHECK_EQUAL(miss.locateZoneHits, 0u);
+	DATETIME_CHECK_EQUAL(miss.locateZoneMisses, 1u);
+	DATETIME_CHECK_EQUAL(miss.exceptions, 1u);
+});
+
+DATETIME_TEST("Stats/GetInfo", [] {
+	auto zone = date::locate_zone("Europe/Berlin");
+	auto instant = date::sys_days(date::year(2024) / date::July / 1) + hours(12);
+	zone->get_info(instant);
+	auto sys = Counted([&] { zone->get_info(instant); });
+	DATETIME_CHECK_EQUAL(sys.sysInfoCalls, 1u);
+	DATETIME_CHECK_EQUAL(sys.localInfoCalls, 0u);
+	auto view = Counted([&] { zone->get_info_view(instant); });
+	DATETIME_CHECK_EQUAL(view.sysInfoCalls, 1u);
+	DATETIME_CHECK_EQUAL(view.localInfoCalls, 0u);
+	auto local = Counted([&] {
+		zone->get_info(date::local_seconds(instant.time_since_epoch()));
+		zone->get_info_view(date::local_seconds(instant.time_since_epoch()));
+	});
+	DATETIME_CHECK_EQUAL(local.sysInfoCalls, 0u);
+	DATETIME_CHECK_EQUAL(local.localInfoCalls, 2u);
+	// 02:30 on the last Sunday of March does not exist in Berlin
+	auto gap = Counted([&] {
+		try {
+			zone->to_sys(date::local_days(date::year(2024) / date::March / 31) + hours(2) + minutes(30));
+		} catch (const date::nonexistent_local_time &) {
+		}
+	});
+	// date reads the info again for the exception message
+	DATETIME_CHECK_EQUAL(gap.localInfoCalls, 2u);
+	DATETIME_CHECK_EQUAL(gap.exceptions, 1u);
+});
+
+DATETIME_TEST("Stats/ParseAndFormat", [] {
+	const std::string text = "2024-03-05T10:20:30+0000";
+	auto parse = Counted([&] { DateTime<seconds>::Parse(text, std::string(ISO8601_FORMAT)); });
+	DATETIME_CHECK_EQUAL(parse.parseCalls, 1u);
+	DATETIME_CHECK_EQUAL(parse.parseBytes, text.size());
+	auto offset = Counted([&] { DateTime<seconds>::ParseOffset(text); });
+	DATETIME_CHECK_EQUAL(offset.parseCalls, 1u);
+	DATETIME_CHECK_EQUAL(offset.parseBytes, text.size());
+
+	DateTime<seconds> dt(date::make_zoned(date::locate_zone("UTC"), date::sys_days(date::year(2024) / date::March / 5) + hours(10) + minutes(20) + seconds(30)));
+	std::string formatted;
+	auto format = Counted([&] { formatted = dt.Format(ISO8601_FORMAT); });
+	DATETIME_CHECK_EQUAL(formatted, text);
+	DATETIME_CHECK_EQUAL(format.formatCalls, 1u);
+	DATETIME_CHECK_EQUAL(format.formatBytes, text.size());
+	// A format the single pass formatter leaves to date::format
+	auto slow = Counted([&] { formatted = dt.Format("%A, %d %B %Y"); });
+	DATETIME_CHECK_EQUAL(formatted, std::string("Tuesday, 05 March 2024"));
+	DATETIME_CHECK_EQUAL(slow.formatCalls, 1u);
+	DATETIME_CHECK_EQUAL(slow.formatBytes, formatted.size());
+});
+
+DATETIME_TEST("Stats/FirstZoneLoad", [] {
+	// A reload gives zones that have not been read yet
+	auto &zones = ZoneDatabase::Instance();
+	auto reload = Counted([&] { zones.Reload(); });
+	DATETIME_CHECK_EQUAL(reload.tzdbLoads, 1u);
+	DATETIME_CHECK(reload.tzdbLoadNanoseconds > 0);
+	auto guard = zones.Read();
+	auto zone = guard.Locate("Pacific/Chatham");
+	auto instant = date::sys_days(date::year(2024) / date::January / 1);
+	auto first = Counted([&] { zone->get_info(instant); });
+	DATETIME_CHECK_EQUAL(first.zoneLoads, 1u);
+	DATETIME_CHECK(first.zoneLoadNanoseconds > 0);
+	DATETIME_CHECK_EQUAL(first.sysInfoCalls, 1u);
+	auto again = Counted([&] { zone->get_info(instant); });
+	DATETIME_CHECK_EQUAL(again.zoneLoads, 0u);
+	DATETIME_CHECK_EQUAL(again.zoneLoadNanoseconds, 0u);
+});
+#endif
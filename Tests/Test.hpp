@@ -0,0 +1,54 @@
+#pragma once
+
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace datetime::test {
+/// A named test. It fails when one of its checks fails or it throws.
+struct Test {
+	std::string name;
+	std::function<void()> run;
+};
+
+inline std::vector<Test> &Registry() {
+	static std::vector<Test> tests;
+	return tests;
+}
+
+/// Reports a failed check of the running test, which carries on so that all its failures
+/// are reported.
+void Fail(const char *file, int line, const std::string &message);
+
+template<class T, class U>
+void CheckEqual(const T &actual, const U &expected, const char *file, int line, const char *expression) {
+	if (actual == expected)
+		return;
+	std::ostringstream ss;
+	ss << expression << ": got " << actual << ", expected " << expected;
+	Fail(file, line, ss.str());
+}
+
+struct Register {
+	Register(std::string name, std::function<void()> run) {
+		Registry().push_back({std::move(name), std::move(run)});
+	}
+};
+}
+
+#define DATETIME_TEST_CONCAT_IMPL(a, b) a##b
+#define DATETIME_TEST_CONCAT(a, b) DATETIME_TEST_CONCAT_IMPL(a, b)
+
+/// Registers a test body, for example
+///   DATETIME_TEST("Parse/RoundTrip", [] { DATETIME_CHECK(...); });
+/// The part of the name before the first / is its suite, which CMake registers with CTest.
+#define DATETIME_TEST(name, ...) \
+	static datetime::test::Register DATETIME_TEST_CONCAT(testRegister, __LINE__)(name, __VA_ARGS__)
+
+/// Checks that hold in every build type, unlike assert.
+#define DATETIME_CHECK(condition) \
+	((condition) ? void() : datetime::test::Fail(__FILE__, __LINE__, #condition))
+#define DATETIME_CHECK_EQUAL(actual, expected) \
+	datetime::test::CheckEqual((actual), (expected), __FILE__, __LINE__, #actual)
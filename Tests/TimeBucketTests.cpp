@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "TimeBuckets.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+using namespace std::chrono;
+
+namespace {
+/// Checks Floor, Ceil and BucketIndex of buckets around a DST transition every 5 minutes: the
+/// floor and ceiling bound t, no other bucket starts between t and them, and the ceiling lies
+/// in another bucket unless it is t. With steps that neither divide nor are a multiple of an
+/// hour, a bucket straddles the start of the hour a fall back repeats and is split in two
+/// pieces, so only the ceiling side is checked for them.
+void CheckAround(const TimeBuckets &buckets, date::sys_seconds transition, bool aligned) {
+	for (auto t = transition - hours(8); t <= transition + hours(8); t += minutes(5)) {
+		auto index = buckets.BucketIndex(t);
+		auto floor = buckets.Floor(t);
+		auto ceil = buckets.Ceil(t);
+		DATETIME_CHECK(floor <= t);
+		DATETIME_CHECK_EQUAL(buckets.BucketIndex(floor), index);
+		for (auto u = floor; aligned && u < t; u += minutes(1))
+			DATETIME_CHECK_EQUAL(buckets.BucketIndex(u), index);
+		DATETIME_CHECK(ceil >= t);
+		DATETIME_CHECK((ceil == t) == (floor == t));
+		if (ceil > t)
+			DATETIME_CHECK(buckets.BucketIndex(ceil) != index);
+		for (auto u = t; u < ceil; u += minutes(1))
+			DATETIME_CHECK_EQUAL(buckets.BucketIndex(u), index);
+	}
+}
+
+/// Every step around both transitions of 2024, through the zone and through a table.
+void CheckZone(const char *name) {
+	auto zone = date::locate_zone(name);
+	auto year = date::sys_days(date::year(2024) / date::January / 1);
+	auto spring = zone->get_info_view(date::sys_seconds(year)).end;
+	auto autumn = zone->get_info_view(spring).end;
+	for (minutes step : {minutes(15), minutes(30), minutes(45), minutes(hours(1)), minutes(hours(2)), minutes(hours(3)), minutes(hours(6)), minutes(hours(24))}) {
+		TimeBuckets direct(step, zone);
+		TimeBuckets table(step, zone);
+		table.Precompute(date::year(2024), date::year(2024));
+		auto aligned = hours(1) % step == minutes(0) || step % hours(1) == minutes(0);
+		for (auto transition : {spring, autumn}) {
+			CheckAround(direct, transition, aligned);
+			CheckAround(table, transition, aligned);
+		}
+	}
+}
+}
+
+DATETIME_TEST("TimeBuckets/FixedFloorAcrossSpringForward", [] {
+	// 03:30+02:00 is in the 00:00 to 06:00 bucket, which starts at 00:00+01:00
+	TimeBuckets buckets(hours(6), date::locate_zone("Europe/Berlin"));
+	auto t = date::sys_days(date::year(2024) / date::March / 31) + hours(1) + minutes(30);
+	auto floor = buckets.Floor(t);
+	DATETIME_CHECK(floor == date::sys_days(date::year(2024) / date::March / 30) + hours(23));
+	DATETIME_CHECK_EQUAL(buckets.BucketIndex(t), std::int64_t(79252));
+	DATETIME_CHECK_EQUAL(buckets.BucketIndex(floor), std::int64_t(79252));
+	DATETIME_CHECK(buckets.Ceil(t) == date::sys_days(date::year(2024) / date::March / 31) + hours(4));
+});
+
+DATETIME_TEST("TimeBuckets/FixedAroundTransitions", [] {
+	CheckZone("Europe/Berlin");
+	CheckZone("America/New_York");
+	// A half hour DST shift
+	CheckZone("Australia/Lord_Howe");
+});
+
+DATETIME_TEST("TimeBuckets/WeekIndexFromEpoch", [] {
+	auto zone = date::locate_zone("UTC");
+	auto epoch = date::sys_seconds();
+	for (unsigned w = 0; w < 7; ++w) {
+		TimeBuckets weeks(CalendarUnit::Week, zone, date::weekday(w));
+		DATETIME_CHECK_EQUAL(weeks.BucketIndex(epoch), std::int64_t(0));
+		DATETIME_CHECK_EQUAL(weeks.BucketIndex(weeks.Floor(epoch) - seconds(1)), std::int64_t(-1));
+		DATETIME_CHECK_EQUAL(weeks.BucketIndex(weeks.Ceil(epoch + seconds(1))), std::int64_t(1));
+		DATETIME_CHECK(date::weekday(date::floor<date::days>(weeks.Floor(epoch))) == date::weekday(w));
+	}
+	TimeBuckets iso(CalendarUnit::IsoWeek, zone);
+	DATETIME_CHECK_EQUAL(iso.BucketIndex(epoch), std::int64_t(0));
+	DATETIME_CHECK_EQUAL(iso.BucketIndex(date::sys_days(date::year(1970) / date::January / 5)), std::int64_t(1));
+	DATETIME_CHECK_EQUAL(iso.BucketIndex(date::sys_days(date::year(1969) / date::December / 28)), std::int64_t(-1));
+});
+
+DATETIME_TEST("TimeBuckets/PrecomputedUnsorted", [] {
+	// Instants anywhere in and just outside a long table, in random order, one at a time and
+	// as a batch, against the zone
+	auto zone = date::locate_zone("America/New_York");
+	auto begin = date::sys_days(date::year(1969) / date::June / 1).time_since_epoch().count();
+	auto end = date::sys_days(date::year(2101) / date::June / 1).time_since_epoch().count();
+	std::mt19937_64 random(20240331);
+	std::uniform_int_distribution<std::int64_t> days(begin, end), secondsOfDay(0, 86399);
+	std::vector<date::sys_seconds> instants;
+	for (int i = 0; i < 2000; ++i)
+		instants.push_back(date::sys_days(date::days(days(random))) + seconds(secondsOfDay(random)));
+	auto check = [&](const TimeBuckets &direct, const TimeBuckets &table) {
+		std::vector<date::sys_seconds> floors, ceils;
+		std::vector<std::int64_t> indices;
+		table.Floor(instants.begin(), instants.end(), std::back_inserter(floors));
+		table.Ceil(instants.begin(), instants.end(), std::back_inserter(ceils));
+		table.BucketIndex(instants.begin(), instants.end(), std::back_inserter(indices));
+		for (std::size_t i = 0; i < instants.size(); ++i) {
+			auto t = instants[i];
+			DATETIME_CHECK(table.Floor(t) == direct.Floor(t));
+			DATETIME_CHECK(table.Ceil(t) == direct.Ceil(t));
+			DATETIME_CHECK_EQUAL(table.BucketIndex(t), direct.BucketIndex(t));
+			DATETIME_CHECK(floors[i] == direct.Floor(t));
+			DATETIME_CHECK(ceils[i] == direct.Ceil(t));
+			DATETIME_CHECK_EQUAL(indices[i], direct.BucketIndex(t));
+		}
+	};
+	for (auto unit : {CalendarUnit::Day, CalendarUnit::Week, CalendarUnit::Month, CalendarUnit::Year}) {
+		TimeBuckets direct(unit, zone);
+		TimeBuckets table(unit, zone);
+		table.Precompute(date::year(1970), date::year(2100));
+		check(direct, table);
+	}
+	for (minutes step : {minutes(15), minutes(hours(3))}) {
+		TimeBuckets direct(step, zone);
+		TimeBuckets table(step, zone);
+		table.Precompute(date::year(1970), date::year(2100));
+		check(direct, table);
+	}
+});
@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <utility>
+
+#include "DateTime.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+using namespace std::chrono;
+
+namespace {
+date::sys_seconds At(int y, unsigned m, unsigned d, int h) {
+	return date::sys_days(date::year(y) / date::month(m) / date::day(d)) + hours(h);
+}
+
+/// The two transitions of a zone in a year past the last one of its table, read from the
+/// POSIX TZ footer.
+void CheckTransitions(const char *name, date::sys_seconds first, seconds firstOffset, date::sys_seconds second, seconds secondOffset) {
+	auto zone = date::locate_zone(name);
+	auto info = zone->get_info(first - hours(24 * 30));
+	DATETIME_CHECK(info.end == first);
+	info = zone->get_info(first);
+	DATETIME_CHECK(info.begin == first);
+	DATETIME_CHECK(info.offset == firstOffset);
+	DATETIME_CHECK(info.end == second);
+	info = zone->get_info(second);
+	DATETIME_CHECK(info.offset == secondOffset);
+	// The local side agrees, past any overlap
+	auto local = zone->get_info(date::local_seconds((second + secondOffset + hours(3)).time_since_epoch()));
+	DATETIME_CHECK_EQUAL(static_cast<int>(local.result), static_cast<int>(date::local_info::unique));
+	DATETIME_CHECK(local.first.offset == secondOffset);
+}
+}
+
+DATETIME_TEST("TimeZone/Footer2040", [] {
+	CheckTransitions("Europe/Berlin", At(2040, 3, 25, 1), hours(2), At(2040, 10, 28, 1), hours(1));
+	CheckTransitions("America/New_York", At(2040, 3, 11, 7), -hours(4), At(2040, 11, 4, 6), -hours(5));
+	// Southern hemisphere, DST ends in April and starts in October
+	CheckTransitions("Australia/Sydney", At(2040, 3, 31, 16), hours(10), At(2040, 10, 6, 16), hours(11));
+	// No DST
+	for (auto [name, offset] : {std::pair<const char *, seconds>{"Asia/Tokyo", hours(9)}, {"America/Phoenix", -hours(7)}}) {
+		auto info = date::locate_zone(name)->get_info(At(2040, 7, 1, 0));
+		DATETIME_CHECK(info.offset == offset);
+		DATETIME_CHECK(info.save == minutes(0));
+	}
+});
+
+#ifndef _WIN32
+DATETIME_TEST("TimeZone/FooterAgainstLocaltime", [] {
+	// The C library evaluates the same footer on its own
+	auto saved = std::getenv("TZ");
+	std::string previous = saved ? saved : "";
+	for (auto name : {"Europe/Berlin", "America/New_York", "Australia/Sydney", "America/Santiago", "Asia/Tokyo"}) {
+		setenv("TZ", name, 1);
+		tzset();
+		auto zone = date::locate_zone(name);
+		std::size_t mismatches = 0;
+		for (auto t = At(2038, 1, 1, 0); t < At(2101, 1, 1, 0); t += hours(23) + minutes(17)) {
+			auto info = zone->get_info(t);
+			auto time = static_cast<std::time_t>(t.time_since_epoch().count());
+			std::tm tm{};
+			localtime_r(&time, &tm);
+			mismatches += tm.tm_gmtoff != info.offset.count() || (tm.tm_isdst > 0) != (info.save != minutes(0));
+		}
+		if (mismatches != 0)
+			test::Fail(__FILE__, __LINE__, std::string(name) + ": " + std::to_string(mismatches) + " instants differ from localtime_r");
+	}
+	if (saved)
+		setenv("TZ", previous.c_str(), 1);
+	else
+		unsetenv("TZ");
+	tzset();
+});
+#endif
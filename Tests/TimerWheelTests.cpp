@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "TimerWheel.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+using namespace std::chrono;
+
+namespace {
+using Nanoseconds = date::sys_time<nanoseconds>;
+
+const auto start = Nanoseconds(date::sys_days(date::year(2024) / date::January / 1));
+
+/// Schedules timers from a tick to far past the top level of a small wheel, cancels some, and
+/// advances in uneven steps: every other timer fires once, at the first tick at or after its
+/// deadline, in deadline order.
+void CheckExpiry(nanoseconds tick, std::initializer_list<unsigned> levelBits, nanoseconds horizon) {
+	TimerWheel<std::size_t> wheel(start, tick, levelBits);
+	std::vector<Nanoseconds> deadlines;
+	std::vector<TimerWheel<std::size_t>::TimerId> ids;
+	std::uint64_t state = 88172645463325252ull;
+	auto random = [&] {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	};
+	for (std::size_t i = 0; i < 20000; ++i) {
+		// Exponentially spread, so every level and the overflow get timers
+		auto range = static_cast<std::uint64_t>(horizon.count()) >> (random() % 40);
+		deadlines.push_back(start + nanoseconds(static_cast<std::int64_t>(random() % (range + 1))));
+		ids.push_back(wheel.Schedule(deadlines.back(), i));
+	}
+	std::vector<bool> cancelled(deadlines.size()), fired(deadlines.size());
+	std::size_t pending = deadlines.size();
+	for (std::size_t i = 0; i < deadlines.size(); i += 7) {
+		DATETIME_CHECK(wheel.Cancel(ids[i]));
+		DATETIME_CHECK(!wheel.Cancel(ids[i]));
+		cancelled[i] = true;
+		--pending;
+	}
+	DATETIME_CHECK_EQUAL(wheel.Size(), pending);
+
+	auto previous = start;
+	std::size_t mismatches = 0;
+	for (auto now = start; !wheel.Empty(); now += nanoseconds(static_cast<std::int64_t>(random() % static_cast<std::uint64_t>(horizon.count() / 50 + 1)))) {
+		auto expired = wheel.Advance(now, [&](std::size_t i) {
+			auto at = wheel.Now();
+			// Deadlines at the start, not after Now(), fire on the first tick
+			auto due = std::max(deadlines[i], start + tick);
+			mismatches += cancelled[i] || fired[i] || at < due || at - due >= tick || at > now || at < previous;
+			fired[i] = true;
+			previous = at;
+		});
+		pending -= expired;
+		DATETIME_CHECK_EQUAL(wheel.Size(), pending);
+	}
+	DATETIME_CHECK_EQUAL(mismatches, std::size_t(0));
+	for (std::size_t i = 0; i < deadlines.size(); ++i)
+		mismatches += fired[i] == cancelled[i];
+	DATETIME_CHECK_EQUAL(mismatches, std::size_t(0));
+	// Ids of expired timers are stale
+	DATETIME_CHECK(!wheel.Cancel(ids[1]));
+}
+
+/// Has no default constructor and can only be moved.
+struct Handle {
+	explicit Handle(int v) : value(std::make_unique<int>(v)) {}
+	std::unique_ptr<int> value;
+};
+}
+
+DATETIME_TEST("TimerWheel/CascadeAcrossLevels", [] {
+	// Three levels of 16 slots span 4096 ticks, the horizon is far past them
+	CheckExpiry(milliseconds(1), {4, 4, 4}, hours(2));
+	CheckExpiry(microseconds(100), {2, 3, 5}, seconds(30));
+	CheckExpiry(milliseconds(1), {8, 6, 6, 6, 6}, hours(24 * 30));
+});
+
+DATETIME_TEST("TimerWheel/FarFuture", [] {
+	TimerWheel<int> wheel(start, milliseconds(1), {4, 4});
+	auto years = start + date::days(3650);
+	wheel.Schedule(years, 2);
+	wheel.Schedule(start + date::days(365), 1);
+	std::vector<int> fired;
+	DATETIME_CHECK_EQUAL(wheel.Advance(years - milliseconds(1), [&](int v) { fired.push_back(v); }), std::size_t(1));
+	DATETIME_CHECK(fired == std::vector<int>{1});
+	DATETIME_CHECK(wheel.Now() == years - milliseconds(1));
+	DATETIME_CHECK_EQUAL(wheel.Advance(years, [&](int v) { fired.push_back(v); }), std::size_t(1));
+	DATETIME_CHECK((fired == std::vector<int>{1, 2}));
+});
+
+DATETIME_TEST("TimerWheel/PastAndRounding", [] {
+	TimerWheel<int> wheel(start, milliseconds(10));
+	wheel.Schedule(start - hours(1), 1);
+	// Rounded up to the next tick
+	wheel.Schedule(start + milliseconds(11), 2);
+	std::vector<int> fired;
+	wheel.Advance(start + milliseconds(10), [&](int v) { fired.push_back(v); });
+	DATETIME_CHECK(fired == std::vector<int>{1});
+	wheel.Advance(start + milliseconds(19), [&](int v) { fired.push_back(v); });
+	DATETIME_CHECK(fired == std::vector<int>{1});
+	wheel.Advance(start + milliseconds(20), [&](int v) { fired.push_back(v); });
+	DATETIME_CHECK((fired == std::vector<int>{1, 2}));
+});
+
+DATETIME_TEST("TimerWheel/ScheduleFromCallback", [] {
+	TimerWheel<Handle> wheel(start);
+	auto cancelled = wheel.Schedule(start + milliseconds(5), Handle(0));
+	wheel.Schedule(start + milliseconds(1), Handle(1));
+	DATETIME_CHECK(wheel.Cancel(cancelled));
+	std::vector<int> fired;
+	auto record = [&](Handle &h) {
+		fired.push_back(*h.value);
+		if (*h.value < 4)
+			wheel.ScheduleAfter(TimeDelta(milliseconds(300)), Handle(*h.value + 1));
+	};
+	wheel.Advance(start + seconds(2), record);
+	DATETIME_CHECK((fired == std::vector<int>{1, 2, 3, 4}));
+	DATETIME_CHECK(wheel.Empty());
+});
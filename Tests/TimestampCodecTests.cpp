@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "TimestampCodec.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+using namespace std::chrono;
+
+namespace {
+using TimePoint = date::sys_time<microseconds>;
+
+/// Encodes values, stores the column as its parts, reads it back and decodes all of it and
+/// ranges starting within seek intervals.
+void CheckRoundTrip(const std::vector<TimePoint> &values, std::size_t seekInterval) {
+	TimestampEncoder<microseconds> encoder(seekInterval);
+	encoder.Append(values.begin(), values.end());
+	auto encoded = encoder.Finish();
+	DATETIME_CHECK_EQUAL(encoded.Size(), values.size());
+	auto column = CompressedTimestamps<microseconds>::FromWords(encoded.Words(), encoded.SeekPoints(), encoded.SeekInterval(), encoded.Size());
+	DATETIME_CHECK(column.Decode() == values);
+	for (std::size_t first : {std::size_t(0), seekInterval / 2, seekInterval, seekInterval + 1, values.size() / 2 + 3}) {
+		if (first >= values.size())
+			continue;
+		auto count = std::min<std::size_t>(values.size() - first, 2 * seekInterval + 5);
+		std::vector<TimePoint> range(count);
+		column.Decode(first, count, range.data());
+		DATETIME_CHECK(std::equal(range.begin(), range.end(), values.begin() + static_cast<std::ptrdiff_t>(first)));
+		DATETIME_CHECK(column.At(first) == values[first]);
+	}
+}
+}
+
+DATETIME_TEST("TimestampCodec/RoundTrip", [] {
+	auto start = TimePoint(date::sys_days(date::year(2024) / date::January / 1));
+	std::vector<TimePoint> regular, irregular, negative, wide;
+	std::uint64_t state = 88172645463325252ull;
+	auto random = [&] {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	};
+	for (int i = 0; i < 5000; ++i) {
+		regular.push_back(start + seconds(10) * i);
+		irregular.push_back((irregular.empty() ? start : irregular.back()) + seconds(10) + milliseconds(static_cast<std::int64_t>(random() % 2000)) - seconds(1));
+		negative.push_back(start - seconds(i % 7 == 3 ? 40 : 0) + seconds(5) * (i % 1000) - hours(24 * 365 * 60));
+		wide.push_back(TimePoint(microseconds(static_cast<std::int64_t>(random()))));
+	}
+	for (std::size_t seekInterval : {std::size_t(1), std::size_t(64), std::size_t(1024)}) {
+		CheckRoundTrip(regular, seekInterval);
+		CheckRoundTrip(irregular, seekInterval);
+		CheckRoundTrip(negative, seekInterval);
+		CheckRoundTrip(wide, seekInterval);
+	}
+	CheckRoundTrip({}, 16);
+	CheckRoundTrip({start}, 16);
+	// A regular column takes about a bit a value
+	TimestampEncoder<microseconds> encoder;
+	encoder.Append(regular.begin(), regular.end());
+	auto column = encoder.Finish();
+	DATETIME_CHECK(column.Words().size() * 64 < regular.size() * 2);
+});
+
+DATETIME_TEST("TimestampCodec/FromWordsRejects", [] {
+	auto start = TimePoint(date::sys_days(date::year(2024) / date::January / 1));
+	TimestampEncoder<microseconds> encoder(16);
+	for (int i = 0; i < 100; ++i)
+		encoder.Append(start + seconds(i * i));
+	auto column = encoder.Finish();
+	auto rejects = [](auto &&f) {
+		try {
+			f();
+		} catch (const std::invalid_argument &) {
+			return true;
+		}
+		return false;
+	};
+	using Column = CompressedTimestamps<microseconds>;
+	DATETIME_CHECK(rejects([&] { Column::FromWords(column.Words(), column.SeekPoints(), 0, column.Size()); }));
+	DATETIME_CHECK(rejects([&] { Column::FromWords(column.Words(), column.SeekPoints(), 16, column.Size() + 20); }));
+	DATETIME_CHECK(rejects([&] { Column::FromWords({}, column.SeekPoints(), 16, column.Size()); }));
+	// Cut words, and a seek point past them
+	auto words = column.Words();
+	words.resize(words.size() / 2);
+	DATETIME_CHECK(rejects([&] { Column::FromWords(words, column.SeekPoints(), 16, column.Size()); }));
+	auto seekPoints = column.SeekPoints();
+	seekPoints.back().position = column.Words().size() * 64;
+	DATETIME_CHECK(rejects([&] { Column::FromWords(column.Words(), seekPoints, 16, column.Size()); }));
+	// Words of all ones are 69 bit codes that run off the end
+	std::vector<std::uint64_t> ones(4, ~std::uint64_t(0));
+	DATETIME_CHECK(rejects([&] { Column::FromWords(ones, {{0, 0, 0}}, 16, 16); }));
+});
+
+DATETIME_TEST("TimestampCodec/DateTimes", [] {
+	auto berlin = date::locate_zone("Europe/Berlin");
+	auto york = date::locate_zone("America/New_York");
+	auto start = date::sys_days(date::year(2024) / date::March / 31) + hours(1);
+	std::vector<DateTime<microseconds>> values;
+	for (int i = 0; i < 300; ++i)
+		values.push_back(DateTime<microseconds>(date::make_zoned(i / 70 % 2 ? york : berlin, start + minutes(i) + microseconds(i))));
+	DateTimeEncoder<microseconds> encoder(32);
+	encoder.Append(values.begin(), values.end());
+	auto encoded = encoder.Finish();
+	DATETIME_CHECK_EQUAL(encoded.Zones().Runs(), std::size_t(5));
+	DATETIME_CHECK_EQUAL(encoded.Zones().Zones().size(), std::size_t(2));
+
+	// Stored as words, seek points, zone names and runs
+	const auto &instants = encoded.Instants();
+	std::vector<const date::time_zone *> zones;
+	for (auto zone : encoded.Zones().Zones())
+		zones.push_back(date::locate_zone(zone->name()));
+	CompressedDateTimes<microseconds> column(
+		CompressedTimestamps<microseconds>::FromWords(instants.Words(), instants.SeekPoints(), instants.SeekInterval(), instants.Size()),
+		ZoneRuns::FromRuns(zones, encoded.Zones().RunTable()));
+
+	for (std::size_t first : {std::size_t(0), std::size_t(65), std::size_t(139)}) {
+		std::vector<DateTime<microseconds>> decoded(values.size() - first);
+		column.Decode(first, decoded.size(), decoded.data());
+		for (std::size_t i = 0; i < decoded.size(); ++i) {
+			DATETIME_CHECK(decoded[i].ZonedTime().get_sys_time() == values[first + i].ZonedTime().get_sys_time());
+			DATETIME_CHECK(decoded[i].Timezone() == values[first + i].Timezone());
+		}
+	}
+	DATETIME_CHECK(column.Zones().At(100) == york);
+
+	bool rejected = false;
+	try {
+		ZoneRuns::FromRuns(zones, {{0, 10}, {2, 20}});
+	} catch (const std::invalid_argument &) {
+		rejected = true;
+	}
+	DATETIME_CHECK(rejected);
+});
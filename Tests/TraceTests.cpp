@@ -0,0 +1,76 @@
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ChromeTrace.hpp"
+#include "ZoneDatabase.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+
+namespace {
+/// Counts spans reported after set_tzdb_tracer gave it back, when it could have been destroyed.
+class RetiringTracer : public date::tzdb_tracer {
+public:
+	explicit RetiringTracer(std::atomic<std::size_t> &late) :
+		_late(late) {
+	}
+
+	void span(const date::tzdb_span &) override {
+		// Long enough for the tracer to be replaced while a span reports
+		std::this_thread::sleep_for(std::chrono::microseconds(200));
+		_late += _retired.load();
+	}
+
+	void Retire() { _retired = true; }
+
+private:
+	std::atomic<std::size_t> &_late;
+	std::atomic<bool> _retired{false};
+};
+}
+
+DATETIME_TEST("Trace/ReplaceWaitsForSpans", [] {
+	auto &zones = ZoneDatabase::Instance();
+	std::atomic<bool> stop{false};
+	std::atomic<std::size_t> late{0}, reloads{0};
+	std::thread worker([&] {
+		while (!stop)
+			zones.Reload(), ++reloads;
+	});
+	// Kept until the end, so a late span is counted instead of reaching freed memory
+	std::vector<std::unique_ptr<RetiringTracer>> tracers;
+	for (int i = 0; i < 200; ++i) {
+		tracers.push_back(std::make_unique<RetiringTracer>(late));
+		date::set_tzdb_tracer(tracers.back().get());
+		std::this_thread::sleep_for(std::chrono::microseconds(300));
+		date::set_tzdb_tracer(nullptr);
+		tracers.back()->Retire();
+	}
+	stop = true;
+	worker.join();
+	DATETIME_CHECK(reloads > 0);
+	DATETIME_CHECK_EQUAL(late.load(), std::size_t(0));
+});
+
+DATETIME_TEST("Trace/ChromeTraceFile", [] {
+	auto path = (std::filesystem::temp_directory_path() / "DateTimeCPP_trace.json").string();
+	{
+		ChromeTraceWriter writer(path);
+		ZoneDatabase::Instance().Reload();
+	}
+	std::ifstream file(path);
+	std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	file.close();
+	std::filesystem::remove(path);
+	DATETIME_CHECK(text.rfind("{\"traceEvents\": [", 0) == 0);
+	DATETIME_CHECK(text.find("\"name\": \"reload_tzdb\"") != std::string::npos);
+	DATETIME_CHECK(text.find("\"name\": \"init_tzdb\"") != std::string::npos);
+	DATETIME_CHECK(text.size() >= 4 && text.compare(text.size() - 4, 4, "\n]}\n") == 0);
+});
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <string>
+
+#include <date/tz.h>
+
+#include "Test.hpp"
+
+#if !USE_OS_TZDB
+using namespace std::chrono;
+
+namespace {
+/// The years of the table and one either side of it.
+const date::sys_seconds First = date::sys_days(date::year(TRANSITION_TABLE_FIRST_YEAR - 1) / date::January / 1);
+const date::sys_seconds Last = date::sys_days(date::year(TRANSITION_TABLE_LAST_YEAR + 2) / date::January / 1);
+
+/// Where the table starts and where it stops.
+const date::sys_seconds Edges[] = {
+	date::sys_days(date::year(TRANSITION_TABLE_FIRST_YEAR) / date::January / 1),
+	date::sys_days(date::year(TRANSITION_TABLE_LAST_YEAR + 1) / date::January / 1),
+};
+
+/// Either side of an edge, past the two days local lookups keep from it.
+const seconds AroundEdge[] = {-hours(49), -hours(48), -hours(24), -seconds(1), seconds(0), hours(24), hours(48), hours(49)};
+
+/// Either side of a transition and of the hour DST moves by.
+const seconds AroundTransition[] = {-hours(1) - seconds(1), -hours(1), -seconds(1), seconds(0), hours(1)};
+
+template<class SysInfo>
+std::string Text(const SysInfo &info) {
+	return std::to_string(info.begin.time_since_epoch().count()) + ' ' + std::to_string(info.end.time_since_epoch().count()) + ' '
+		+ std::to_string(info.offset.count()) + ' ' + std::to_string(info.save.count()) + ' ' + std::string(info.abbrev);
+}
+
+/// The second period is unspecified for a unique local time.
+template<class LocalInfo>
+std::string LocalText(const LocalInfo &info) {
+	auto text = std::to_string(static_cast<int>(info.result)) + ": " + Text(info.first);
+	if (info.result != LocalInfo::unique)
+		text += ", " + Text(info.second);
+	return text;
+}
+
+/// Compares the table with the rules at tp, keeping the first difference.
+struct Comparison {
+	std::size_t checked = 0;
+	std::string mismatch;
+
+	void Check(const date::time_zone &zone, date::sys_seconds tp) {
+		auto expected = Text(zone.get_rule_info(tp, date::detail::undocumented{}));
+		Expect(zone, "sys", tp.time_since_epoch(), Text(zone.get_info(tp)), expected);
+		Expect(zone, "sys view", tp.time_since_epoch(), Text(zone.get_info_view(tp)), expected);
+	}
+
+	void Check(const date::time_zone &zone, date::local_seconds tp) {
+		auto expected = LocalText(zone.get_rule_info(tp, date::detail::undocumented{}));
+		Expect(zone, "local", tp.time_since_epoch(), LocalText(zone.get_info(tp)), expected);
+		Expect(zone, "local view", tp.time_since_epoch(), LocalText(zone.get_info_view(tp)), expected);
+	}
+
+	void Expect(const date::time_zone &zone, const char *kind, seconds tp, const std::string &got, const std::string &expected) {
+		++checked;
+		if (got != expected && mismatch.empty())
+			mismatch = zone.name() + ' ' + kind + " at " + std::to_string(tp.count()) + ": got " + got + ", expected " + expected;
+	}
+};
+}
+
+DATETIME_TEST("TransitionTable/MatchesRules", [] {
+	Comparison comparison;
+	for (const auto &zone : date::get_tzdb().zones) {
+		for (auto edge : Edges) {
+			for (auto d : AroundEdge) {
+				comparison.Check(zone, edge + d);
+				comparison.Check(zone, date::local_seconds(edge.time_since_epoch()) + d);
+			}
+		}
+		// Every transition, in local time from both its offsets to reach into the gaps and overlaps
+		for (auto t = First; t < Last;) {
+			auto before = zone.get_rule_info(t, date::detail::undocumented{});
+			if (before.end >= Last)
+				break;
+			auto after = zone.get_rule_info(before.end, date::detail::undocumented{});
+			for (auto d : AroundTransition) {
+				comparison.Check(zone, before.end + d);
+				comparison.Check(zone, date::local_seconds(before.end.time_since_epoch()) + before.offset + d);
+				comparison.Check(zone, date::local_seconds(before.end.time_since_epoch()) + after.offset + d);
+			}
+			t = before.end;
+		}
+	}
+	DATETIME_CHECK_EQUAL(comparison.mismatch, std::string());
+	DATETIME_CHECK(comparison.checked > 0);
+});
+
+DATETIME_TEST("TransitionTable/GapAndOverlap", [] {
+	// Berlin skips 02:00 to 03:00 on 2024-03-31 and repeats 02:00 to 03:00 on 2024-10-27
+	auto zone = date::locate_zone("Europe/Berlin");
+	auto gapTime = date::local_days(date::year(2024) / date::March / 31) + hours(2) + minutes(30);
+	auto gap = zone->get_info(gapTime);
+	DATETIME_CHECK(gap.result == date::local_info::nonexistent);
+	DATETIME_CHECK_EQUAL(LocalText(gap), LocalText(zone->get_rule_info(gapTime, date::detail::undocumented{})));
+	auto overlapTime = date::local_days(date::year(2024) / date::October / 27) + hours(2) + minutes(30);
+	auto overlap = zone->get_info(overlapTime);
+	DATETIME_CHECK(overlap.result == date::local_info::ambiguous);
+	DATETIME_CHECK_EQUAL(LocalText(overlap), LocalText(zone->get_rule_info(overlapTime, date::detail::undocumented{})));
+	DATETIME_CHECK_EQUAL(overlap.first.offset.count(), 7200);
+	DATETIME_CHECK_EQUAL(overlap.second.offset.count(), 3600);
+});
+#endif
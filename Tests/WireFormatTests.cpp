@@ -0,0 +1,165 @@
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "WireFormat.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+using namespace std::chrono;
+
+namespace {
+bool Same(const TimeDelta &x, const TimeDelta &y) {
+	return x.Days() == y.Days() && x.Seconds() == y.Seconds() && x.Microseconds() == y.Microseconds();
+}
+
+void AppendVarint(std::vector<std::uint8_t> &bytes, std::uint64_t value) {
+	for (; value >= 0x80; value >>= 7)
+		bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+	bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+/// A batch holding one date time in Europe/Berlin with the given ticks and unit.
+std::vector<std::uint8_t> DateTimeRecord(std::int64_t ticks, std::uint8_t unit) {
+	std::vector<std::uint8_t> bytes = {WireVersion, unit, 13};
+	for (auto c : std::string("Europe/Berlin"))
+		bytes.push_back(static_cast<std::uint8_t>(c));
+	AppendVarint(bytes, static_cast<std::uint64_t>(ticks) << 1 ^ static_cast<std::uint64_t>(ticks >> 63));
+	return bytes;
+}
+
+template<class Exception, class F>
+bool Throws(F f) {
+	try {
+		f();
+	} catch (const Exception &) {
+		return true;
+	}
+	return false;
+}
+}
+
+DATETIME_TEST("WireFormat/DateRoundTrip", [] {
+	std::vector<Date> dates = {
+		Date(date::year(1970) / date::January / 1), Date(date::year(1969) / date::December / 31), Date(date::year(2024) / date::February / 29),
+		Date(date::year(-4000) / date::March / 1), Date(date::year(9999) / date::December / 31),
+		Date(date::year::min() / date::January / 1), Date(date::year::max() / date::December / 31),
+	};
+	std::uint8_t buffer[64];
+	WireWriter writer(buffer, sizeof(buffer));
+	writer.Write(dates.begin(), dates.end());
+	// The epoch takes a single byte after the version
+	DATETIME_CHECK(writer.Size() > 1 + dates.size());
+	WireReader reader(buffer, writer.Size());
+	for (auto &d : dates)
+		DATETIME_CHECK(reader.Read<Date>() == d);
+	DATETIME_CHECK(reader.AtEnd());
+});
+
+DATETIME_TEST("WireFormat/TimeDeltaRoundTrip", [] {
+	std::vector<TimeDelta> deltas = {
+		TimeDelta(seconds(0)), TimeDelta(hours(36)), TimeDelta(-hours(36)), TimeDelta(milliseconds(1500)), TimeDelta(-milliseconds(1500)),
+		TimeDelta(microseconds(-1)), TimeDelta(date::days(-20000), seconds(-5), microseconds(-7)),
+		// Just inside the limit, in microseconds and in whole seconds
+		TimeDelta(microseconds(WireTimeDeltaLimit - 1)), TimeDelta(microseconds(-(WireTimeDeltaLimit - 1))),
+		TimeDelta(seconds(WireTimeDeltaLimit / 1000000)),
+	};
+	std::vector<std::uint8_t> buffer(16 * deltas.size());
+	WireWriter writer(buffer.data(), buffer.size());
+	writer.Write(deltas.begin(), deltas.end());
+	WireReader reader(buffer.data(), writer.Size());
+	for (auto &td : deltas) {
+		auto read = reader.Read<TimeDelta>();
+		DATETIME_CHECK(Same(read, td));
+	}
+	DATETIME_CHECK(reader.AtEnd());
+});
+
+DATETIME_TEST("WireFormat/TimeDeltaOutOfRange", [] {
+	std::uint8_t buffer[64];
+	WireWriter writer(buffer, sizeof(buffer));
+	for (auto td : {TimeDelta(microseconds(WireTimeDeltaLimit)), TimeDelta(microseconds(-WireTimeDeltaLimit)), TimeDelta(date::days(100000000)),
+			TimeDelta(date::days(-2000000000))})
+		DATETIME_CHECK(Throws<std::out_of_range>([&] { writer.Write(td); }));
+	DATETIME_CHECK_EQUAL(writer.Size(), std::size_t(1));
+	// A whole second count that would overflow microseconds when read
+	const std::uint8_t tooLong[] = {WireVersion, 0xFC, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+	WireReader reader(tooLong, sizeof(tooLong));
+	DATETIME_CHECK(Throws<std::invalid_argument>([&] { reader.Read<TimeDelta>(); }));
+});
+
+DATETIME_TEST("WireFormat/DateTimeZoneTable", [] {
+	auto berlin = date::locate_zone("Europe/Berlin");
+	auto york = date::locate_zone("America/New_York");
+	auto t = date::sys_days(date::year(2024) / date::March / 31) + hours(1) + microseconds(250);
+	std::vector<DateTime<microseconds>> values;
+	for (int i = 0; i < 6; ++i)
+		values.push_back(DateTime<microseconds>(date::make_zoned(i % 2 ? york : berlin, t + minutes(i))));
+	std::uint8_t buffer[256];
+	WireWriter writer(buffer, sizeof(buffer));
+	writer.Write(values.begin(), values.end());
+	// Each zone is named once, later values refer to the table
+	auto nameBytes = berlin->name().size() + york->name().size();
+	DATETIME_CHECK(writer.Size() < 1 + nameBytes + 2 + values.size() * 10);
+	WireReader reader(buffer, writer.Size());
+	for (auto &dt : values) {
+		auto read = reader.Read<DateTime<microseconds>>();
+		DATETIME_CHECK(read.ZonedTime().get_sys_time() == dt.ZonedTime().get_sys_time());
+		DATETIME_CHECK(read.Timezone() == dt.Timezone());
+	}
+	DATETIME_CHECK(reader.AtEnd());
+
+	// Whole seconds read back at another precision
+	DateTime<seconds> whole(date::make_zoned(berlin, date::floor<seconds>(t)));
+	WireWriter secondsWriter(buffer, sizeof(buffer));
+	secondsWriter.Write(whole);
+	WireReader nanosReader(buffer, secondsWriter.Size());
+	DATETIME_CHECK(nanosReader.Read<DateTime<nanoseconds>>().ZonedTime().get_sys_time() == whole.ZonedTime().get_sys_time());
+});
+
+DATETIME_TEST("WireFormat/Malformed", [] {
+	std::uint8_t buffer[64];
+	WireWriter writer(buffer, sizeof(buffer));
+	writer.Write(DateTime<seconds>(date::make_zoned(date::locate_zone("Europe/Berlin"), date::sys_seconds(seconds(1700000000)))));
+	// Every strict prefix is truncated
+	for (std::size_t size = 1; size < writer.Size(); ++size) {
+		WireReader reader(buffer, size);
+		DATETIME_CHECK(Throws<std::out_of_range>([&] { reader.Read<DateTime<seconds>>(); }));
+	}
+	DATETIME_CHECK(Throws<std::out_of_range>([&] { WireReader(buffer, 0); }));
+	std::uint8_t version[] = {WireVersion + 1, 0};
+	DATETIME_CHECK(Throws<std::invalid_argument>([&] { WireReader(version, sizeof(version)); }));
+	// An unknown zone name and a zone reference the batch has not named
+	const std::uint8_t unknown[] = {WireVersion, 0, 7, 'N', 'o', '/', 'Z', 'o', 'n', 'e', 0};
+	WireReader unknownReader(unknown, sizeof(unknown));
+	DATETIME_CHECK(Throws<std::invalid_argument>([&] { unknownReader.Read<DateTime<seconds>>(); }));
+	const std::uint8_t reference[] = {WireVersion, 1 << 2, 0};
+	WireReader referenceReader(reference, sizeof(reference));
+	DATETIME_CHECK(Throws<std::invalid_argument>([&] { referenceReader.Read<DateTime<seconds>>(); }));
+	// Seconds that overflow nanoseconds, and seconds past year::max()
+	auto overflow = DateTimeRecord(std::int64_t(1) << 40, 0);
+	WireReader overflowReader(overflow.data(), overflow.size());
+	DATETIME_CHECK(Throws<std::invalid_argument>([&] { overflowReader.Read<DateTime<nanoseconds>>(); }));
+	for (auto ticks : {std::int64_t(1) << 45, -(std::int64_t(1) << 45)}) {
+		auto distant = DateTimeRecord(ticks, 0);
+		WireReader distantReader(distant.data(), distant.size());
+		DATETIME_CHECK(Throws<std::invalid_argument>([&] { distantReader.Read<DateTime<seconds>>(); }));
+	}
+	// The last second nanoseconds hold less a day still reads
+	auto edge = DateTimeRecord(std::numeric_limits<std::int64_t>::max() / 1000000000 - 86400, 0);
+	WireReader edgeReader(edge.data(), edge.size());
+	DATETIME_CHECK_EQUAL(edgeReader.Read<DateTime<nanoseconds>>().ZonedTime().get_sys_time().time_since_epoch().count(),
+		(std::numeric_limits<std::int64_t>::max() / 1000000000 - 86400) * 1000000000);
+	// Days past year::max(), which would narrow to a valid looking date
+	std::vector<std::uint8_t> days = {WireVersion};
+	AppendVarint(days, std::uint64_t(1) << 40);
+	WireReader daysReader(days.data(), days.size());
+	DATETIME_CHECK(Throws<std::invalid_argument>([&] { daysReader.Read<Date>(); }));
+	// Too small a buffer to write into
+	std::uint8_t small[3];
+	WireWriter smallWriter(small, sizeof(small));
+	DATETIME_CHECK(Throws<std::out_of_range>([&] { smallWriter.Write(TimeDelta(microseconds(WireTimeDeltaLimit - 1))); }));
+});
@@ -0,0 +1,97 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <date/tz.h>
+
+#include "Test.hpp"
+
+#if TZ_ZONE_BUDGET
+using namespace std::chrono;
+
+namespace {
+/// Before the first transitions, in the tables, around DST changes and on the POSIX footer.
+const date::sys_seconds Instants[] = {
+	date::sys_days(date::year(1850) / date::January / 1), date::sys_days(date::year(1975) / date::June / 15),
+	date::sys_days(date::year(2024) / date::March / 31) + hours(1), date::sys_days(date::year(2024) / date::October / 27) + hours(1),
+	date::sys_days(date::year(2045) / date::July / 1),
+};
+
+/// The answers of a zone at Instants, sys and view for every instant, then the local ones.
+std::string Answers(const date::time_zone *zone) {
+	std::string text;
+	auto add = [&text](const auto &info) {
+		text += std::to_string(info.begin.time_since_epoch().count()) + ' ' + std::to_string(info.end.time_since_epoch().count()) + ' '
+			+ std::to_string(info.offset.count()) + ' ' + std::to_string(info.save.count()) + ' ' + std::string(info.abbrev) + ';';
+	};
+	for (auto t : Instants) {
+		add(zone->get_info(t));
+		add(zone->get_info_view(t));
+		// Local times an hour either side of the instant
+		for (auto local : {date::local_seconds(t.time_since_epoch()) - hours(1), date::local_seconds(t.time_since_epoch()) + hours(1)}) {
+			// The second period is unspecified for a unique local time
+			auto info = zone->get_info(local);
+			text += std::to_string(static_cast<int>(info.result)) + ':';
+			add(info.first);
+			if (info.result != date::local_info::unique)
+				add(info.second);
+			auto view = zone->get_info_view(local);
+			text += std::to_string(static_cast<int>(view.result)) + ':';
+			add(view.first);
+			if (view.result != date::local_info_view::unique)
+				add(view.second);
+		}
+	}
+	return text;
+}
+}
+
+DATETIME_TEST("ZoneBudget/EvictAndReload", [] {
+	const auto &zones = date::get_tzdb().zones;
+	date::set_zone_memory_budget(0);
+	std::vector<std::string> expected;
+	for (const auto &zone : zones)
+		expected.push_back(Answers(&zone));
+
+	// A budget that holds a few dozen zones, far fewer than the threads cycle through.
+	constexpr std::size_t budget = 64 * 1024, threads = 4, rounds = 3;
+	date::set_zone_memory_budget(budget);
+	auto before = date::get_zone_memory();
+	std::atomic<std::size_t> mismatches{0};
+	std::vector<std::thread> workers;
+	for (std::size_t w = 0; w < threads; ++w) {
+		workers.emplace_back([&, w] {
+			// Each thread walks the zones from its own starting point and stride
+			for (std::size_t round = 0; round < rounds; ++round) {
+				for (std::size_t i = 0; i < zones.size(); ++i) {
+					auto z = (w * 97 + i * (2 * w + 1)) % zones.size();
+					mismatches += Answers(&zones[z]) != expected[z];
+				}
+			}
+		});
+	}
+	for (auto &worker : workers)
+		worker.join();
+	DATETIME_CHECK_EQUAL(mismatches.load(), std::size_t(0));
+
+	// Zones pinned by a lookup while another was read may have been passed over, setting the
+	// budget again with no lookups running applies it in full.
+	date::set_zone_memory_budget(budget);
+	auto memory = date::get_zone_memory();
+	DATETIME_CHECK_EQUAL(memory.budget, budget);
+	DATETIME_CHECK(memory.evictions > before.evictions);
+	DATETIME_CHECK(memory.reloads > before.reloads);
+	DATETIME_CHECK(memory.resident_bytes <= budget);
+	DATETIME_CHECK(memory.resident_zones > 0);
+
+	// Dropped zones answer the same once read again without a budget
+	date::set_zone_memory_budget(0);
+	std::size_t after = 0;
+	for (std::size_t z = 0; z < zones.size(); ++z)
+		after += Answers(&zones[z]) != expected[z];
+	DATETIME_CHECK_EQUAL(after, std::size_t(0));
+	DATETIME_CHECK_EQUAL(date::get_zone_memory().budget, std::size_t(0));
+});
+#endif
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ZoneDatabase.hpp"
+#include "Test.hpp"
+
+using namespace datetime;
+
+namespace {
+const char *zoneNames[] = {"Europe/Berlin", "America/New_York", "Asia/Tokyo", "Australia/Sydney"};
+
+constexpr std::size_t InstantCount = 512;
+
+date::sys_seconds Instant(std::size_t i) {
+	return date::sys_seconds(std::chrono::seconds(1700000000 + static_cast<std::int64_t>(i) * 86413));
+}
+
+bool InDatabase(const date::time_zone *zone, const date::tzdb &database) {
+	return !database.zones.empty() && zone >= &database.zones.front() && zone <= &database.zones.back();
+}
+}
+
+DATETIME_TEST("ZoneDatabase/FormatDuringReloads", [] {
+	auto &zones = ZoneDatabase::Instance();
+	std::vector<std::string> expected;
+	{
+		auto guard = zones.Read();
+		for (std::size_t i = 0; i < InstantCount; ++i)
+			expected.push_back(DateTime<std::chrono::seconds>(date::make_zoned(guard.Locate(zoneNames[i % 4]), Instant(i))).Format());
+	}
+
+	// Workers format in read sections while this thread reloads, every reload frees the
+	// databases the workers saw a moment before.
+	constexpr std::size_t threads = 4, reloads = 10;
+	std::atomic<bool> stop{false};
+	std::atomic<std::size_t> wrongText{0}, wrongZone{0}, sections{0};
+	std::vector<std::thread> workers;
+	for (std::size_t t = 0; t < threads; ++t) {
+		workers.emplace_back([&, t] {
+			do {
+				for (std::size_t i = t; i < InstantCount; i += threads) {
+					auto guard = zones.Read();
+					auto zone = guard.Locate(zoneNames[i % 4]);
+					if (zone->name() != zoneNames[i % 4] || !InDatabase(zone, guard.Database()))
+						++wrongZone;
+					if (DateTime<std::chrono::seconds>(date::make_zoned(zone, Instant(i))).Format() != expected[i])
+						++wrongText;
+					++sections;
+				}
+			} while (!stop);
+		});
+	}
+	auto generation = zones.Generation();
+	for (std::size_t i = 0; i < reloads; ++i)
+		zones.Reload();
+	stop = true;
+	for (auto &worker : workers)
+		worker.join();
+
+	DATETIME_CHECK_EQUAL(wrongText.load(), std::size_t(0));
+	DATETIME_CHECK_EQUAL(wrongZone.load(), std::size_t(0));
+	DATETIME_CHECK(sections.load() >= InstantCount);
+	DATETIME_CHECK_EQUAL(zones.Generation(), generation + reloads);
+	// Reload frees every database but the newest
+	auto &list = date::get_tzdb_list();
+	DATETIME_CHECK(std::next(list.begin()) == list.end());
+});
+
+DATETIME_TEST("ZoneDatabase/RebindFromSubscriber", [] {
+	auto &zones = ZoneDatabase::Instance();
+	DateTime<std::chrono::seconds> kept = date::make_zoned(zones.Read().Locate("Asia/Kolkata"), Instant(7));
+	auto text = kept.Format();
+	std::size_t notified = 0;
+	auto id = zones.Subscribe([&](const date::tzdb &database) {
+		++notified;
+		DATETIME_CHECK(&database == &date::get_tzdb_list().front());
+		kept = Rebind(kept, database);
+	});
+	for (int i = 0; i < 3; ++i) {
+		zones.Reload();
+		auto guard = zones.Read();
+		DATETIME_CHECK(&guard.Database() == &date::get_tzdb_list().front());
+		DATETIME_CHECK(kept.Timezone() == guard.Locate("Asia/Kolkata"));
+		DATETIME_CHECK_EQUAL(kept.Format(), text);
+	}
+	zones.Unsubscribe(id);
+	zones.Reload();
+	DATETIME_CHECK_EQUAL(notified, std::size_t(3));
+});
+
+DATETIME_TEST("ZoneDatabase/ConversionsMatchInfos", [] {
+	// Instants past the transition tables too, where the infos come from the zone's rules
+	auto guard = ZoneDatabase::Instance().Read();
+	for (auto name : zoneNames) {
+		auto zone = guard.Locate(name);
+		for (std::size_t i = 0; i < InstantCount; ++i) {
+			auto t = date::sys_seconds(std::chrono::seconds(-2000000000 + static_cast<std::int64_t>(i) * 17000023));
+			auto local = zone->to_local(t);
+			DATETIME_CHECK(local == date::local_seconds((t + zone->get_info(t).offset).time_since_epoch()));
+			auto info = zone->get_info(local);
+			if (info.result == date::local_info::unique)
+				DATETIME_CHECK(zone->to_sys(local) == date::sys_seconds((local - info.first.offset).time_since_epoch()));
+		}
+	}
+
+	auto berlin = guard.Locate("Europe/Berlin");
+	std::size_t thrown = 0;
+	try {
+		berlin->to_sys(date::local_days(date::year(2150) / date::March / date::Sunday[date::last]) + std::chrono::minutes(150));
+	} catch (const date::nonexistent_local_time &e) {
+		++thrown;
+		std::string what = e.what();
+		DATETIME_CHECK(what.find("02:00:00 CET and") != std::string::npos);
+		DATETIME_CHECK(what.find("03:00:00 CEST which") != std::string::npos);
+	}
+	try {
+		berlin->to_sys(date::local_days(date::year(2150) / date::October / date::Sunday[date::last]) + std::chrono::minutes(150));
+	} catch (const date::ambiguous_local_time &e) {
+		++thrown;
+		std::string what = e.what();
+		DATETIME_CHECK(what.find("02:30:00 CEST ==") != std::string::npos);
+		DATETIME_CHECK(what.find("02:30:00 CET ==") != std::string::npos);
+	}
+	DATETIME_CHECK_EQUAL(thrown, std::size_t(2));
+});
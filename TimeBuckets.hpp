@@ -0,0 +1,342 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "DateTime.hpp"
+
+namespace datetime {
+/// Calendar bucket widths in local time. Week starts on a chosen weekday, IsoWeek on Monday.
+enum class CalendarUnit {
+	Day, Week, IsoWeek, Month, Quarter, Year
+};
+
+/// Assigns instants to local time buckets of a zone, either calendar units or a fixed step
+/// aligned to local midnight. A bucket is identified by its start instant and by an index
+/// counting buckets from the one holding 1970-01-01 local time.
+///
+/// Without a precomputed table every call converts through the zone. Precompute builds the
+/// bucket starts (or the UTC offsets for fixed steps) of a year range, after which single
+/// instants are a binary search and sorted spans are bucketed by a linear merge.
+class TimeBuckets {
+public:
+	TimeBuckets(CalendarUnit unit, const date::time_zone *zone, date::weekday weekStart = date::Monday) :
+		_unit(unit), _zone(zone), _weekStart(unit == CalendarUnit::IsoWeek ? date::Monday : weekStart) {
+		if (_zone == nullptr)
+			throw std::invalid_argument("TimeBuckets needs a time zone");
+		if (!_weekStart.ok())
+			throw std::invalid_argument("invalid week start");
+	}
+
+	/// Fixed buckets of step, aligned to local midnight when step divides a day. Indices follow
+	/// the local clock, so the hour repeated by a DST fall back reuses the indices of its first pass.
+	/// A bucket starts where the local clock shows its start, at the DST transition when a gap
+	/// skips that time, and at the latest such instant up to t when an overlap repeats it.
+	TimeBuckets(std::chrono::seconds step, const date::time_zone *zone) :
+		_zone(zone), _step(step) {
+		if (_zone == nullptr)
+			throw std::invalid_argument("TimeBuckets needs a time zone");
+		if (_step <= std::chrono::seconds(0))
+			throw std::invalid_argument("bucket step must be positive");
+	}
+
+	bool Fixed() const { return _step != std::chrono::seconds(0); }
+	const date::time_zone *Zone() const { return _zone; }
+
+	/// Tabulates the buckets of the local years first through last.
+	TimeBuckets &Precompute(date::year first, date::year last) {
+		if (!first.ok() || !last.ok() || last < first)
+			throw std::invalid_argument("invalid year range");
+		_starts.clear();
+		_offsets.clear();
+		auto from = date::local_days(first / date::January / 1);
+		auto to = date::local_days((last + date::years(1)) / date::January / 1);
+		if (Fixed()) {
+			// Whole periods, so that a bucket start resolved near the table ends finds its period
+			auto begin = ToSys(from), end = ToSys(to);
+			for (auto info = _zone->get_info_view(begin); ; info = _zone->get_info_view(info.end)) {
+				_starts.push_back(info.begin);
+				_offsets.push_back(info.offset);
+				if (info.end >= end) {
+					_starts.push_back(info.end);
+					break;
+				}
+			}
+			return *this;
+		}
+		auto label = Label(from);
+		_firstIndex = Index(label);
+		for (;; label = Next(label)) {
+			_starts.push_back(ToSys(label));
+			if (label >= to)
+				break;
+		}
+		return *this;
+	}
+
+	template<class Duration>
+	date::sys_time<typename std::common_type<Duration, std::chrono::seconds>::type> Floor(date::sys_time<Duration> t) const {
+		std::size_t hint = 0;
+		return Floor(t, hint);
+	}
+
+	/// The first bucket start at or after t.
+	template<class Duration>
+	date::sys_time<typename std::common_type<Duration, std::chrono::seconds>::type> Ceil(date::sys_time<Duration> t) const {
+		std::size_t hint = 0;
+		return Ceil(t, hint);
+	}
+
+	template<class Duration>
+	std::int64_t BucketIndex(date::sys_time<Duration> t) const {
+		std::size_t hint = 0;
+		return BucketIndex(t, hint);
+	}
+
+	/// DateTime overloads return the bucket start in the zone of the buckets.
+	template<class Duration>
+	DateTime<typename std::common_type<Duration, std::chrono::seconds>::type> Floor(const DateTime<Duration> &dt) const {
+		return {date::make_zoned(_zone, Floor(dt.ZonedTime().get_sys_time()))};
+	}
+
+	template<class Duration>
+	DateTime<typename std::common_type<Duration, std::chrono::seconds>::type> Ceil(const DateTime<Duration> &dt) const {
+		return {date::make_zoned(_zone, Ceil(dt.ZonedTime().get_sys_time()))};
+	}
+
+	template<class Duration>
+	std::int64_t BucketIndex(const DateTime<Duration> &dt) const { return BucketIndex(dt.ZonedTime().get_sys_time()); }
+
+	/// Batch versions over sys_time values. Sorted input is merged against the table in one
+	/// pass, unsorted input stays correct but falls back to a search per element.
+	template<class InputIt, class OutputIt>
+	OutputIt Floor(InputIt first, InputIt last, OutputIt out) const {
+		std::size_t hint = 0;
+		for (; first != last; ++first)
+			*out++ = Floor(*first, hint);
+		return out;
+	}
+
+	template<class InputIt, class OutputIt>
+	OutputIt Ceil(InputIt first, InputIt last, OutputIt out) const {
+		std::size_t hint = 0;
+		for (; first != last; ++first)
+			*out++ = Ceil(*first, hint);
+		return out;
+	}
+
+	template<class InputIt, class OutputIt>
+	OutputIt BucketIndex(InputIt first, InputIt last, OutputIt out) const {
+		std::size_t hint = 0;
+		for (; first != last; ++first)
+			*out++ = BucketIndex(*first, hint);
+		return out;
+	}
+
+private:
+	static std::int64_t FloorDiv(std::int64_t x, std::int64_t y) { return x / y - ((x % y != 0) && ((x < 0) != (y < 0))); }
+
+	/// Local midnight as an instant, a nonexistent midnight starts the day at the transition.
+	date::sys_seconds ToSys(date::local_days ld) const {
+		return _zone->to_sys(date::local_seconds(ld), date::choose::earliest);
+	}
+
+	/// The first day of the calendar bucket holding ld.
+	date::local_days Label(date::local_days ld) const {
+		switch (_unit) {
+		case CalendarUnit::Day:
+			return ld;
+		case CalendarUnit::Week:
+		case CalendarUnit::IsoWeek:
+			return ld - (date::weekday(ld) - _weekStart);
+		case CalendarUnit::Month: {
+			date::year_month_day ymd{ld};
+			return date::local_days(ymd.year() / ymd.month() / 1);
+		}
+		case CalendarUnit::Quarter: {
+			date::year_month_day ymd{ld};
+			auto m = (static_cast<unsigned>(ymd.month()) - 1) / 3 * 3 + 1;
+			return date::local_days(ymd.year() / date::month(m) / 1);
+		}
+		case CalendarUnit::Year:
+			return date::local_days(date::year_month_day{ld}.year() / date::January / 1);
+		}
+		return ld;
+	}
+
+	date::local_days Next(date::local_days label) const {
+		switch (_unit) {
+		case CalendarUnit::Day:
+			return label + date::days(1);
+		case CalendarUnit::Week:
+		case CalendarUnit::IsoWeek:
+			return label + date::days(7);
+		case CalendarUnit::Month:
+			return date::local_days(date::year_month_day{label} + date::months(1));
+		case CalendarUnit::Quarter:
+			return date::local_days(date::year_month_day{label} + date::months(3));
+		case CalendarUnit::Year:
+			return date::local_days(date::year_month_day{label} + date::years(1));
+		}
+		return label;
+	}
+
+	std::int64_t Index(date::local_days label) const {
+		auto days = label.time_since_epoch().count();
+		switch (_unit) {
+		case CalendarUnit::Day:
+			return days;
+		case CalendarUnit::Week:
+		case CalendarUnit::IsoWeek:
+			// Labels all fall on _weekStart, the epoch was a Thursday.
+			return FloorDiv(days + (date::Thursday - _weekStart).count(), 7);
+		case CalendarUnit::Month:
+		case CalendarUnit::Quarter:
+		case CalendarUnit::Year: {
+			date::year_month_day ymd{label};
+			auto months = (static_cast<int>(ymd.year()) - 1970) * std::int64_t(12) + static_cast<unsigned>(ymd.month()) - 1;
+			return _unit == CalendarUnit::Month ? months : FloorDiv(months, _unit == CalendarUnit::Quarter ? 3 : 12);
+		}
+		}
+		return days;
+	}
+
+	/// Moves hint onto the table entry holding t, false when t is outside the table.
+	bool Locate(date::sys_seconds t, std::size_t &hint) const {
+		if (_starts.size() < 2 || t < _starts.front() || t >= _starts.back())
+			return false;
+		// A sorted column only ever moves forward, usually by zero or one entries, anything else
+		// is a binary search.
+		for (int step = 0; step < 2; ++step) {
+			if (t < _starts[hint])
+				break;
+			if (t < _starts[hint + 1])
+				return true;
+			if (hint + 2 == _starts.size())
+				break;
+			++hint;
+		}
+		hint = static_cast<std::size_t>(std::upper_bound(_starts.begin(), _starts.end(), t) - _starts.begin()) - 1;
+		return true;
+	}
+
+	/// A constant UTC offset period of the zone.
+	struct Period {
+		std::chrono::seconds offset;
+		date::sys_seconds begin;
+		date::sys_seconds end;
+	};
+
+	Period PeriodOf(date::sys_seconds t, std::size_t &hint) const {
+		if (Locate(t, hint))
+			return {_offsets[hint], _starts[hint], _starts[hint + 1]};
+		auto info = _zone->get_info_view(t);
+		return {info.offset, info.begin, info.end};
+	}
+
+	/// The local start of the fixed step bucket holding t, which has the given offset.
+	date::local_seconds LocalStart(date::sys_seconds t, std::chrono::seconds offset) const {
+		return date::local_seconds(FloorDiv((t.time_since_epoch() + offset).count(), _step.count()) * _step);
+	}
+
+	/// The instant of the local bucket boundary local. That is the period's offset applied to
+	/// local when the result falls in period, and otherwise local resolved through the zone:
+	/// a boundary skipped by a DST gap becomes the transition, a repeated one its occurrence
+	/// picked by choose.
+	date::sys_seconds Resolve(date::local_seconds local, const Period &period, date::choose choose) const {
+		auto t = date::sys_seconds(local.time_since_epoch() - period.offset);
+		if (t >= period.begin && t < period.end)
+			return t;
+		return _zone->to_sys(local, choose);
+	}
+
+	template<class Duration>
+	date::sys_time<typename std::common_type<Duration, std::chrono::seconds>::type> Floor(date::sys_time<Duration> t, std::size_t &hint) const {
+		auto seconds = date::floor<std::chrono::seconds>(t);
+		if (Fixed()) {
+			// The start may lie before a transition, so its offset can differ from the one at t
+			auto period = PeriodOf(seconds, hint);
+			return Resolve(LocalStart(seconds, period.offset), period, date::choose::latest);
+		}
+		if (Locate(seconds, hint))
+			return _starts[hint];
+		return ToSys(Label(date::floor<date::days>(_zone->to_local(seconds))));
+	}
+
+	template<class Duration>
+	date::sys_time<typename std::common_type<Duration, std::chrono::seconds>::type> Ceil(date::sys_time<Duration> t, std::size_t &hint) const {
+		auto floor = Floor(t, hint);
+		if (floor == t)
+			return floor;
+		if (Fixed()) {
+			auto seconds = date::floor<std::chrono::seconds>(t);
+			auto period = PeriodOf(seconds, hint);
+			auto next = Resolve(LocalStart(seconds, period.offset) + _step, period, date::choose::earliest);
+			// The local clock falling back at the end of the period may start a bucket sooner
+			auto end = hint;
+			if (period.end < next && BucketIndex(period.end, end) != BucketIndex(seconds, hint))
+				return period.end;
+			return next;
+		}
+		if (Locate(date::floor<std::chrono::seconds>(t), hint))
+			return _starts[hint + 1];
+		return ToSys(Next(Label(date::floor<date::days>(_zone->to_local(date::floor<std::chrono::seconds>(t))))));
+	}
+
+	template<class Duration>
+	std::int64_t BucketIndex(date::sys_time<Duration> t, std::size_t &hint) const {
+		auto seconds = date::floor<std::chrono::seconds>(t);
+		if (Fixed())
+			return FloorDiv((seconds.time_since_epoch() + PeriodOf(seconds, hint).offset).count(), _step.count());
+		if (Locate(seconds, hint))
+			return _firstIndex + static_cast<std::int64_t>(hint);
+		return Index(Label(date::floor<date::days>(_zone->to_local(seconds))));
+	}
+
+	CalendarUnit _unit = CalendarUnit::Day;
+	const date::time_zone *_zone;
+	date::weekday _weekStart = date::Monday;
+	std::chrono::seconds _step{0};
+	// Bucket starts for calendar units, or the starts of constant offset periods with their
+	// offsets in _offsets for fixed steps. The last entry is the end of the table, for fixed
+	// steps the end of the last period.
+	std::vector<date::sys_seconds> _starts;
+	std::vector<std::chrono::seconds> _offsets;
+	std::int64_t _firstIndex = 0;
+};
+
+/// The start of the calendar bucket holding dt, in the time zone of dt.
+template<class Duration>
+DateTime<typename std::common_type<Duration, std::chrono::seconds>::type> Floor(const DateTime<Duration> &dt, CalendarUnit unit, date::weekday weekStart = date::Monday) {
+	return TimeBuckets(unit, dt.Timezone(), weekStart).Floor(dt);
+}
+
+template<class Duration>
+DateTime<typename std::common_type<Duration, std::chrono::seconds>::type> Ceil(const DateTime<Duration> &dt, CalendarUnit unit, date::weekday weekStart = date::Monday) {
+	return TimeBuckets(unit, dt.Timezone(), weekStart).Ceil(dt);
+}
+
+template<class Duration>
+std::int64_t BucketIndex(const DateTime<Duration> &dt, CalendarUnit unit, date::weekday weekStart = date::Monday) {
+	return TimeBuckets(unit, dt.Timezone(), weekStart).BucketIndex(dt);
+}
+
+/// The start of the fixed step bucket holding dt in its local time, e.g. 15 minutes.
+template<class Duration>
+DateTime<typename std::common_type<Duration, std::chrono::seconds>::type> Floor(const DateTime<Duration> &dt, std::chrono::seconds step) {
+	return TimeBuckets(step, dt.Timezone()).Floor(dt);
+}
+
+template<class Duration>
+DateTime<typename std::common_type<Duration, std::chrono::seconds>::type> Ceil(const DateTime<Duration> &dt, std::chrono::seconds step) {
+	return TimeBuckets(step, dt.Timezone()).Ceil(dt);
+}
+
+template<class Duration>
+std::int64_t BucketIndex(const DateTime<Duration> &dt, std::chrono::seconds step) {
+	return TimeBuckets(step, dt.Timezone()).BucketIndex(dt);
+}
+}
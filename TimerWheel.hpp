@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Bits.hpp"
+#include "DateTime.hpp"
+
+namespace datetime {
+/// A hierarchical timing wheel holding millions of deadlines with constant time Schedule and
+/// Cancel. Level 0 has one slot per tick, every higher level has slots spanning a whole
+/// rotation of the level below, and timers further out than the top level wait in an
+/// overflow list. Time only moves when Advance is called, which makes expiry deterministic.
+///
+/// Deadlines are rounded up to the tick resolution so a timer never fires early, timers due at
+/// the same tick fire in no particular order. T only has to be move constructible. Slots hold
+/// node indices contiguously so cascading does not chase pointers, and per level occupancy
+/// bitmaps let Advance jump over empty slots instead of visiting every tick.
+template<class T>
+class TimerWheel {
+public:
+	/// Identifies a scheduled timer, stale ids are detected by a per node generation.
+	struct TimerId {
+		std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t generation = 0;
+	};
+
+	/// The wheel starts at now, levelBits gives the log2 slot count of each level.
+	template<class Duration>
+	explicit TimerWheel(date::sys_time<Duration> now, std::chrono::nanoseconds tick = std::chrono::milliseconds(1),
+		std::initializer_list<unsigned> levelBits = {8, 6, 6, 6, 6}) :
+		_tick(tick) {
+		if (_tick <= std::chrono::nanoseconds(0))
+			throw std::invalid_argument("timer wheel tick must be positive");
+		unsigned shift = 0;
+		for (auto bits : levelBits) {
+			if (bits == 0 || bits > 16)
+				throw std::invalid_argument("timer wheel levels must have between 1 and 16 bits");
+			Level level;
+			level.shift = shift;
+			level.bits = bits;
+			level.slotOffset = static_cast<std::uint32_t>(_slots.size());
+			level.occupied.assign(((std::size_t(1) << bits) + 63) / 64, 0);
+			_slots.resize(_slots.size() + (std::size_t(1) << bits));
+			_levels.push_back(std::move(level));
+			shift += bits;
+		}
+		if (_levels.empty() || shift > 62)
+			throw std::invalid_argument("timer wheel levels must span between 1 and 62 bits");
+		_totalBits = shift;
+		_overflowSlot = static_cast<std::uint32_t>(_slots.size());
+		_slots.emplace_back();
+		_current = FloorTick(now);
+	}
+
+	std::size_t Size() const { return _size; }
+	bool Empty() const { return _size == 0; }
+
+	/// The time up to which the wheel has been advanced.
+	date::sys_time<std::chrono::nanoseconds> Now() const { return date::sys_time<std::chrono::nanoseconds>(_current * _tick); }
+
+	void Reserve(std::size_t timers) { _nodes.reserve(timers); }
+
+	/// Deadlines that are not after Now() fire on the next tick.
+	template<class Duration>
+	TimerId Schedule(date::sys_time<Duration> deadline, T value) {
+		auto index = Allocate(std::move(value));
+		_nodes[index].deadline = std::max(CeilTick(deadline), _current + 1);
+		Insert(index);
+		++_size;
+		return {index, _nodes[index].generation};
+	}
+
+	template<class Duration>
+	TimerId Schedule(const DateTime<Duration> &deadline, T value) {
+		return Schedule(deadline.ZonedTime().get_sys_time(), std::move(value));
+	}
+
+	TimerId ScheduleAfter(const TimeDelta &delay, T value) {
+		return Schedule(Now() + date::days(delay.Days()) + std::chrono::seconds(delay.Seconds()) + std::chrono::microseconds(delay.Microseconds()), std::move(value));
+	}
+
+	/// Removes a pending timer, false if it already expired or was cancelled.
+	bool Cancel(TimerId id) {
+		if (id.index >= _nodes.size() || _nodes[id.index].generation != id.generation || _nodes[id.index].slot == Nil)
+			return false;
+		Unlink(id.index);
+		Release(id.index);
+		--_size;
+		return true;
+	}
+
+	/// Expires every timer with a deadline up to now in deadline order, calling onExpired with
+	/// each value, and returns how many expired. Timers scheduled from onExpired must not be
+	/// due before now.
+	template<class Duration, class Function>
+	std::size_t Advance(date::sys_time<Duration> now, Function &&onExpired) {
+		auto target = FloorTick(now);
+		std::size_t expired = 0;
+		while (_current < target) {
+			auto tick = NextEvent();
+			if (tick > target) {
+				_current = target;
+				break;
+			}
+			Cascade(tick);
+			auto slot = _levels[0].slotOffset + static_cast<std::uint32_t>(tick & Mask(_levels[0]));
+			while (!_slots[slot].empty()) {
+				auto index = _slots[slot].back();
+				Unlink(index);
+				--_size;
+				++expired;
+				auto value = std::move(*_nodes[index].value);
+				Release(index);
+				onExpired(value);
+			}
+		}
+		return expired;
+	}
+
+	template<class Duration, class Function>
+	std::size_t Advance(const DateTime<Duration> &now, Function &&onExpired) {
+		return Advance(now.ZonedTime().get_sys_time(), std::forward<Function>(onExpired));
+	}
+
+private:
+	static constexpr std::uint32_t Nil = std::numeric_limits<std::uint32_t>::max();
+
+	struct Level {
+		unsigned shift;
+		unsigned bits;
+		std::uint32_t slotOffset;
+		std::vector<std::uint64_t> occupied;
+	};
+
+	struct Node {
+		std::int64_t deadline = 0;
+		std::uint32_t slot = Nil;
+		std::uint32_t position = 0;
+		std::uint32_t generation = 0;
+		std::optional<T> value;
+	};
+
+	static std::int64_t Mask(const Level &level) { return (std::int64_t(1) << level.bits) - 1; }
+
+	template<class Duration>
+	std::int64_t FloorTick(date::sys_time<Duration> tp) const {
+		auto ns = date::floor<std::chrono::nanoseconds>(tp).time_since_epoch();
+		return ns / _tick - (ns % _tick < std::chrono::nanoseconds(0));
+	}
+
+	template<class Duration>
+	std::int64_t CeilTick(date::sys_time<Duration> tp) const {
+		auto ns = date::ceil<std::chrono::nanoseconds>(tp).time_since_epoch();
+		return ns / _tick + (ns % _tick > std::chrono::nanoseconds(0));
+	}
+
+	std::uint32_t Allocate(T value) {
+		std::uint32_t index;
+		if (!_free.empty()) {
+			index = _free.back();
+			_free.pop_back();
+		} else {
+			index = static_cast<std::uint32_t>(_nodes.size());
+			_nodes.emplace_back();
+		}
+		_nodes[index].value.emplace(std::move(value));
+		return index;
+	}
+
+	void Release(std::uint32_t index) {
+		auto &node = _nodes[index];
+		node.value.reset();
+		node.slot = Nil;
+		++node.generation;
+		_free.push_back(index);
+	}
+
+	/// Places a node relative to the current tick, in the lowest level whose rotation holds it.
+	void Insert(std::uint32_t index) {
+		auto deadline = _nodes[index].deadline;
+		std::uint32_t slot = _overflowSlot;
+		for (auto &level : _levels) {
+			auto above = level.shift + level.bits;
+			if ((deadline >> above) == (_current >> above)) {
+				auto i = static_cast<std::uint32_t>((deadline >> level.shift) & Mask(level));
+				level.occupied[i / 64] |= std::uint64_t(1) << (i % 64);
+				slot = level.slotOffset + i;
+				break;
+			}
+		}
+		if (slot == _overflowSlot)
+			_overflowEarliest = std::min(_overflowEarliest, deadline);
+		auto &node = _nodes[index];
+		node.slot = slot;
+		node.position = static_cast<std::uint32_t>(_slots[slot].size());
+		_slots[slot].push_back(index);
+	}
+
+	/// Removes a node from its slot by moving the last entry of the slot into its place.
+	void Unlink(std::uint32_t index) {
+		auto &node = _nodes[index];
+		auto &entries = _slots[node.slot];
+		entries[node.position] = entries.back();
+		_nodes[entries.back()].position = node.position;
+		entries.pop_back();
+		if (entries.empty())
+			ClearOccupied(node.slot);
+		node.slot = Nil;
+	}
+
+	void ClearOccupied(std::uint32_t slot) {
+		if (slot == _overflowSlot)
+			return;
+		for (auto &level : _levels) {
+			auto i = slot - level.slotOffset;
+			if (slot >= level.slotOffset && i < (std::uint32_t(1) << level.bits)) {
+				level.occupied[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+				return;
+			}
+		}
+	}
+
+	/// The first occupied slot index after from in the level, or -1.
+	static std::int64_t NextOccupied(const Level &level, std::int64_t from) {
+		auto size = std::int64_t(1) << level.bits;
+		for (auto i = from + 1; i < size;) {
+			auto word = level.occupied[static_cast<std::size_t>(i / 64)] >> (i % 64);
+			if (word != 0)
+				return i + detail::CountTrailingZeros(word);
+			i = (i / 64 + 1) * 64;
+		}
+		return -1;
+	}
+
+	/// The first tick after the current one at which a level 0 slot expires or a higher slot
+	/// cascades, skipping whole top level rotations that no overflow timer falls in.
+	std::int64_t NextEvent() const {
+		auto best = std::numeric_limits<std::int64_t>::max();
+		for (const auto &level : _levels) {
+			auto above = level.shift + level.bits;
+			auto j = NextOccupied(level, (_current >> level.shift) & Mask(level));
+			if (j >= 0)
+				best = std::min(best, ((_current >> above) << above) + (j << level.shift));
+		}
+		if (!_slots[_overflowSlot].empty())
+			best = std::min(best, std::max((_current >> _totalBits) + 1, _overflowEarliest >> _totalBits) << _totalBits);
+		return best;
+	}
+
+	/// Moves the wheel to tick and redistributes the higher level slots starting there, top
+	/// level first so their timers can land in lower slots that are due at the same tick.
+	void Cascade(std::int64_t tick) {
+		_current = tick;
+		if ((tick & ((std::int64_t(1) << _totalBits) - 1)) == 0)
+			Reinsert(_overflowSlot);
+		for (auto level = _levels.size(); level-- > 1;) {
+			const auto &l = _levels[level];
+			if ((tick & ((std::int64_t(1) << l.shift) - 1)) == 0)
+				Reinsert(l.slotOffset + static_cast<std::uint32_t>((tick >> l.shift) & Mask(l)));
+		}
+	}
+
+	void Reinsert(std::uint32_t slot) {
+		if (_slots[slot].empty())
+			return;
+		// Detach the whole slot first, Insert may put nodes back into the overflow slot.
+		_cascading.swap(_slots[slot]);
+		ClearOccupied(slot);
+		if (slot == _overflowSlot)
+			_overflowEarliest = std::numeric_limits<std::int64_t>::max();
+		for (auto index : _cascading)
+			Insert(index);
+		_cascading.clear();
+	}
+
+	std::chrono::nanoseconds _tick;
+	std::vector<Level> _levels;
+	unsigned _totalBits = 0;
+	std::vector<std::vector<std::uint32_t>> _slots;
+	std::vector<std::uint32_t> _cascading;
+	std::uint32_t _overflowSlot = 0;
+	// A lower bound on the overflow deadlines, cancelled timers can leave it too early.
+	std::int64_t _overflowEarliest = std::numeric_limits<std::int64_t>::max();
+	std::vector<Node> _nodes;
+	std::vector<std::uint32_t> _free;
+	std::size_t _size = 0;
+	std::int64_t _current = 0;
+};
+}
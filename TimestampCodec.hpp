@@ -0,0 +1,465 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Bits.hpp"
+#include "DateTime.hpp"
+
+namespace datetime {
+namespace detail {
+/// Appends bit fields most significant bit first to a vector of words.
+class BitWriter {
+public:
+	/// Writes the low bits of value, bits must be between 1 and 64.
+	void Write(std::uint64_t value, unsigned bits) {
+		if (bits < 64)
+			value &= (std::uint64_t(1) << bits) - 1;
+		auto used = static_cast<unsigned>(_size % 64);
+		if (used == 0)
+			_words.push_back(0);
+		auto free = 64 - used;
+		if (bits <= free) {
+			_words.back() |= bits == 64 ? value : value << (free - bits);
+		} else {
+			_words.back() |= value >> (bits - free);
+			_words.push_back(value << (64 - (bits - free)));
+		}
+		_size += bits;
+	}
+
+	std::size_t Size() const { return _size; }
+	const std::vector<std::uint64_t> &Words() const { return _words; }
+	std::vector<std::uint64_t> Release() {
+		// A trailing zero word lets readers always load two words.
+		_words.push_back(0);
+		return std::move(_words);
+	}
+
+private:
+	std::vector<std::uint64_t> _words;
+	std::size_t _size = 0;
+};
+
+/// Reads bit fields written by BitWriter, the words must end with a padding word.
+class BitReader {
+public:
+	BitReader(const std::uint64_t *words, std::size_t position) :
+		_words(words), _position(position) {
+	}
+
+	/// The next 64 bits without consuming them.
+	std::uint64_t Peek() const {
+		auto word = _position / 64;
+		auto offset = static_cast<unsigned>(_position % 64);
+		return offset == 0 ? _words[word] : (_words[word] << offset) | (_words[word + 1] >> (64 - offset));
+	}
+
+	void Skip(std::size_t bits) { _position += bits; }
+
+	std::uint64_t Read(unsigned bits) {
+		auto value = Peek() >> (64 - bits);
+		_position += bits;
+		return value;
+	}
+
+private:
+	const std::uint64_t *_words;
+	std::size_t _position;
+};
+
+inline std::uint64_t ZigZag(std::uint64_t x) { return (x << 1) ^ (0 - (x >> 63)); }
+inline std::uint64_t UnZigZag(std::uint64_t z) { return (z >> 1) ^ (0 - (z & 1)); }
+}
+
+/// A compressed column of instants, see TimestampEncoder. Decoding starts from the seek point
+/// before the first requested value, so any range decodes in time proportional to its length
+/// plus at most one seek interval.
+template<class Duration = std::chrono::system_clock::duration>
+class CompressedTimestamps {
+public:
+	using TimePoint = date::sys_time<Duration>;
+
+	/// The state at a multiple of the seek interval, the value itself is not in the bit stream.
+	struct SeekPoint {
+		std::uint64_t position;
+		std::uint64_t value;
+		std::uint64_t delta;
+	};
+
+	CompressedTimestamps() = default;
+
+	/// A column from the parts of one stored earlier, throws std::invalid_argument when they
+	/// do not make up a column whose values can all be decoded from within words.
+	static CompressedTimestamps FromWords(std::vector<std::uint64_t> words, std::vector<SeekPoint> seekPoints, std::size_t seekInterval, std::size_t size) {
+		if (seekInterval == 0)
+			throw std::invalid_argument("seek interval must be positive");
+		if (words.empty() || seekPoints.size() != (size + seekInterval - 1) / seekInterval)
+			throw std::invalid_argument("compressed column does not match its size");
+		CompressedTimestamps column;
+		column._words = std::move(words);
+		column._seekPoints = std::move(seekPoints);
+		column._seekInterval = seekInterval;
+		column._size = size;
+		column.Validate();
+		return column;
+	}
+
+	std::size_t Size() const { return _size; }
+	bool Empty() const { return _size == 0; }
+
+	/// The parts to store, FromWords puts them back together.
+	const std::vector<std::uint64_t> &Words() const { return _words; }
+	const std::vector<SeekPoint> &SeekPoints() const { return _seekPoints; }
+	std::size_t SeekInterval() const { return _seekInterval; }
+
+	/// Bytes of the bit stream and the seek table.
+	std::size_t Bytes() const { return _words.size() * sizeof(std::uint64_t) + _seekPoints.size() * sizeof(SeekPoint); }
+
+	TimePoint At(std::size_t index) const {
+		TimePoint value;
+		Decode(index, 1, &value);
+		return value;
+	}
+
+	/// Decodes count values starting at first into out.
+	void Decode(std::size_t first, std::size_t count, TimePoint *out) const {
+		if (first > _size || count > _size - first)
+			throw std::out_of_range("decoded range is past the end of the column");
+		if (count == 0)
+			return;
+		auto seek = first / _seekInterval;
+		const auto &point = _seekPoints[seek];
+		auto index = seek * _seekInterval;
+		detail::BitReader reader(_words.data(), point.position);
+		auto value = point.value;
+		auto delta = point.delta;
+		auto last = first + count;
+		auto emit = [&](std::size_t i) {
+			if (i >= first)
+				out[i - first] = TimePoint(Duration(static_cast<typename Duration::rep>(value)));
+		};
+		emit(index++);
+		while (index < last) {
+			if (index % _seekInterval == 0) {
+				const auto &next = _seekPoints[index / _seekInterval];
+				reader = detail::BitReader(_words.data(), next.position);
+				value = next.value;
+				delta = next.delta;
+				emit(index++);
+				continue;
+			}
+			auto window = reader.Peek();
+			if ((window >> 63) == 0) {
+				// A run of unchanged deltas is a run of zero bits, emitted without decoding each.
+				auto run = window == 0 ? std::size_t(64) : std::size_t(detail::CountLeadingZeros(window));
+				run = std::min({run, last - index, _seekInterval - index % _seekInterval});
+				reader.Skip(run);
+				for (auto end = index + run; index < end; ++index) {
+					value += delta;
+					emit(index);
+				}
+				continue;
+			}
+			auto prefix = ~window == 0 ? 5 : detail::CountLeadingZeros(~window);
+			std::uint64_t zigzag;
+			switch (prefix) {
+			case 1:
+				reader.Skip(2);
+				zigzag = reader.Read(7);
+				break;
+			case 2:
+				reader.Skip(3);
+				zigzag = reader.Read(9);
+				break;
+			case 3:
+				reader.Skip(4);
+				zigzag = reader.Read(12);
+				break;
+			case 4:
+				reader.Skip(5);
+				zigzag = reader.Read(32);
+				break;
+			default:
+				reader.Skip(5);
+				zigzag = reader.Read(64);
+				break;
+			}
+			delta += detail::UnZigZag(zigzag);
+			value += delta;
+			emit(index++);
+		}
+	}
+
+	void Decode(TimePoint *out) const { Decode(0, _size, out); }
+
+	std::vector<TimePoint> Decode() const {
+		std::vector<TimePoint> values(_size);
+		Decode(values.data());
+		return values;
+	}
+
+private:
+	template<class>
+	friend class TimestampEncoder;
+
+	/// Bits of the code starting with the 64 bits of window.
+	static unsigned CodeBits(std::uint64_t window) {
+		if ((window >> 63) == 0)
+			return 1;
+		switch (~window == 0 ? 5 : detail::CountLeadingZeros(~window)) {
+		case 1:
+			return 9;
+		case 2:
+			return 12;
+		case 3:
+			return 16;
+		case 4:
+			return 37;
+		default:
+			return 69;
+		}
+	}
+
+	/// Walks every code, so that Decode never reads past the last word.
+	void Validate() const {
+		// Peek reads the word at a position and the one after it
+		auto limit = static_cast<std::uint64_t>(_words.size() - 1) * 64;
+		for (std::size_t seek = 0; seek < _seekPoints.size(); ++seek) {
+			auto position = _seekPoints[seek].position;
+			auto count = std::min(_seekInterval, _size - seek * _seekInterval);
+			for (std::size_t i = 1; i <= count; ++i) {
+				if (position > limit)
+					throw std::invalid_argument("compressed column ends within its values");
+				if (i < count)
+					position += CodeBits(detail::BitReader(_words.data(), position).Peek());
+			}
+		}
+	}
+
+	std::vector<std::uint64_t> _words{0};
+	std::vector<SeekPoint> _seekPoints;
+	std::size_t _seekInterval = 1;
+	std::size_t _size = 0;
+};
+
+/// Streams instants into delta of delta codes with variable bit widths, after Gorilla. Each
+/// value stores the change of its delta to the previous one: a single 0 bit when regular,
+/// then 2 + 7, 3 + 9, 4 + 12, 5 + 32 or 5 + 64 bits of the zigzag encoded change. Every
+/// seekInterval values a seek point records the state so decoding can start there.
+///
+/// Ticks use wrapping unsigned arithmetic, so any sequence round trips, sorted or not.
+template<class Duration = std::chrono::system_clock::duration>
+class TimestampEncoder {
+public:
+	using TimePoint = date::sys_time<Duration>;
+
+	explicit TimestampEncoder(std::size_t seekInterval = 1024) :
+		_seekInterval(seekInterval) {
+		if (_seekInterval == 0)
+			throw std::invalid_argument("seek interval must be positive");
+	}
+
+	void Append(TimePoint t) {
+		auto value = static_cast<std::uint64_t>(t.time_since_epoch().count());
+		auto delta = value - _previous;
+		if (_size % _seekInterval == 0) {
+			_seekPoints.push_back({_bits.Size(), value, _size == 0 ? 0 : delta});
+		} else {
+			auto zigzag = detail::ZigZag(delta - _delta);
+			if (zigzag == 0)
+				_bits.Write(0, 1);
+			else if (zigzag < (std::uint64_t(1) << 7))
+				_bits.Write((std::uint64_t(0b10) << 7) | zigzag, 9);
+			else if (zigzag < (std::uint64_t(1) << 9))
+				_bits.Write((std::uint64_t(0b110) << 9) | zigzag, 12);
+			else if (zigzag < (std::uint64_t(1) << 12))
+				_bits.Write((std::uint64_t(0b1110) << 12) | zigzag, 16);
+			else if (zigzag < (std::uint64_t(1) << 32))
+				_bits.Write((std::uint64_t(0b11110) << 32) | zigzag, 37);
+			else {
+				_bits.Write(0b11111, 5);
+				_bits.Write(zigzag, 64);
+			}
+		}
+		_delta = _size == 0 ? 0 : delta;
+		_previous = value;
+		++_size;
+	}
+
+	template<class D>
+	void Append(const DateTime<D> &dt) {
+		Append(date::floor<Duration>(dt.ZonedTime().get_sys_time()));
+	}
+
+	template<class InputIt>
+	void Append(InputIt first, InputIt last) {
+		for (; first != last; ++first)
+			Append(*first);
+	}
+
+	std::size_t Size() const { return _size; }
+
+	/// Hands over the encoded column and resets the encoder.
+	CompressedTimestamps<Duration> Finish() {
+		CompressedTimestamps<Duration> column;
+		column._words = _bits.Release();
+		column._seekPoints = std::move(_seekPoints);
+		column._seekInterval = _seekInterval;
+		column._size = _size;
+		*this = TimestampEncoder(_seekInterval);
+		return column;
+	}
+
+private:
+	std::size_t _seekInterval;
+	detail::BitWriter _bits;
+	std::vector<typename CompressedTimestamps<Duration>::SeekPoint> _seekPoints;
+	std::uint64_t _previous = 0;
+	std::uint64_t _delta = 0;
+	std::size_t _size = 0;
+};
+
+/// The time zones of a DateTime column as a dictionary of zones and runs of equal zones.
+class ZoneRuns {
+public:
+	void Append(const date::time_zone *zone, std::size_t count = 1) {
+		if (count == 0)
+			return;
+		if (!_runs.empty() && _zones[_runs.back().zone] == zone) {
+			_runs.back().end += count;
+			return;
+		}
+		auto it = std::find(_zones.begin(), _zones.end(), zone);
+		auto id = static_cast<std::uint32_t>(it - _zones.begin());
+		if (it == _zones.end())
+			_zones.push_back(zone);
+		_runs.push_back({id, Size() + count});
+	}
+
+	std::size_t Size() const { return _runs.empty() ? 0 : _runs.back().end; }
+	std::size_t Runs() const { return _runs.size(); }
+	const std::vector<const date::time_zone *> &Zones() const { return _zones; }
+
+	/// A run of rows up to end in the zone at index zone of Zones.
+	struct Run {
+		std::uint32_t zone;
+		std::uint64_t end;
+	};
+
+	/// The runs to store with the zone names, FromRuns puts them back together.
+	const std::vector<Run> &RunTable() const { return _runs; }
+
+	/// Runs read back, throws std::invalid_argument for a missing zone, a zone index past the
+	/// zones or ends that do not increase.
+	static ZoneRuns FromRuns(std::vector<const date::time_zone *> zones, std::vector<Run> runs) {
+		if (std::find(zones.begin(), zones.end(), nullptr) != zones.end())
+			throw std::invalid_argument("zone runs need time zones");
+		std::uint64_t end = 0;
+		for (auto &run : runs) {
+			if (run.zone >= zones.size() || run.end <= end)
+				throw std::invalid_argument("invalid zone run");
+			end = run.end;
+		}
+		ZoneRuns result;
+		result._zones = std::move(zones);
+		result._runs = std::move(runs);
+		return result;
+	}
+
+	/// Bytes of the run table plus the zone names.
+	std::size_t Bytes() const {
+		auto bytes = _runs.size() * sizeof(Run);
+		for (auto zone : _zones)
+			bytes += zone->name().size() + 1;
+		return bytes;
+	}
+
+	const date::time_zone *At(std::size_t index) const {
+		auto it = std::upper_bound(_runs.begin(), _runs.end(), index, [](std::size_t i, const Run &run) { return i < run.end; });
+		if (it == _runs.end())
+			throw std::out_of_range("zone index is past the end of the column");
+		return _zones[it->zone];
+	}
+
+	/// Calls f(zone, first, last) for every run overlapping [first, last).
+	template<class Function>
+	void ForEachRun(std::size_t first, std::size_t last, Function &&f) const {
+		auto it = std::upper_bound(_runs.begin(), _runs.end(), first, [](std::size_t i, const Run &run) { return i < run.end; });
+		for (; it != _runs.end() && first < last; ++it) {
+			auto end = std::min<std::size_t>(it->end, last);
+			f(_zones[it->zone], first, end);
+			first = end;
+		}
+	}
+
+private:
+	std::vector<const date::time_zone *> _zones;
+	std::vector<Run> _runs;
+};
+
+/// A DateTime column stored as compressed instants and zone runs.
+template<class Duration = std::chrono::system_clock::duration>
+class CompressedDateTimes {
+	using CommonDuration = typename std::common_type<Duration, std::chrono::seconds>::type;
+public:
+	CompressedDateTimes(CompressedTimestamps<Duration> instants, ZoneRuns zones) :
+		_instants(std::move(instants)), _zones(std::move(zones)) {
+		if (_instants.Size() != _zones.Size())
+			throw std::invalid_argument("instant and zone columns differ in length");
+	}
+
+	std::size_t Size() const { return _instants.Size(); }
+	std::size_t Bytes() const { return _instants.Bytes() + _zones.Bytes(); }
+
+	const CompressedTimestamps<Duration> &Instants() const { return _instants; }
+	const ZoneRuns &Zones() const { return _zones; }
+
+	void Decode(std::size_t first, std::size_t count, DateTime<CommonDuration> *out) const {
+		std::vector<date::sys_time<Duration>> instants(count);
+		_instants.Decode(first, count, instants.data());
+		_zones.ForEachRun(first, first + count, [&](const date::time_zone *zone, std::size_t begin, std::size_t end) {
+			for (auto i = begin; i < end; ++i)
+				out[i - first] = DateTime<CommonDuration>(date::make_zoned(zone, instants[i - first]));
+		});
+	}
+
+private:
+	CompressedTimestamps<Duration> _instants;
+	ZoneRuns _zones;
+};
+
+/// Encodes DateTime values into a CompressedDateTimes column.
+template<class Duration = std::chrono::system_clock::duration>
+class DateTimeEncoder {
+public:
+	explicit DateTimeEncoder(std::size_t seekInterval = 1024) :
+		_instants(seekInterval) {
+	}
+
+	template<class D>
+	void Append(const DateTime<D> &dt) {
+		_instants.Append(dt);
+		_zones.Append(dt.Timezone());
+	}
+
+	template<class InputIt>
+	void Append(InputIt first, InputIt last) {
+		for (; first != last; ++first)
+			Append(*first);
+	}
+
+	CompressedDateTimes<Duration> Finish() {
+		auto column = CompressedDateTimes<Duration>(_instants.Finish(), std::move(_zones));
+		_zones = ZoneRuns();
+		return column;
+	}
+
+private:
+	TimestampEncoder<Duration> _instants;
+	ZoneRuns _zones;
+};
+}
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "Bits.hpp"
+#include "DateTime.hpp"
+
+namespace datetime {
+/// The version byte that starts every wire batch.
+constexpr std::uint8_t WireVersion = 1;
+
+/// Zones a batch interns, later zones are sent by name each time.
+constexpr std::size_t WireZoneTableSize = 64;
+
+/// TimeDelta values must be shorter than this many microseconds either way, about 73000 years.
+constexpr std::int64_t WireTimeDeltaLimit = std::int64_t(1) << 61;
+
+namespace detail {
+/// Tick units of the wire format, a value is sent in the coarsest one that holds it exactly.
+enum class WireUnit : std::uint8_t {
+	Seconds, Milliseconds, Microseconds, Nanoseconds
+};
+
+inline std::uint64_t WireZigZag(std::int64_t x) {
+	return (static_cast<std::uint64_t>(x) << 1) ^ (0 - (static_cast<std::uint64_t>(x) >> 63));
+}
+
+inline std::int64_t WireUnZigZag(std::uint64_t z) { return static_cast<std::int64_t>((z >> 1) ^ (0 - (z & 1))); }
+
+/// The unit of a duration type, durations of whole seconds count as seconds.
+template<class Duration>
+constexpr WireUnit WireUnitOf() {
+	using Period = typename Duration::period;
+	static_assert(std::ratio_less_equal<std::nano, Period>::value, "durations finer than nanoseconds cannot be sent");
+	if constexpr (std::ratio_less<Period, std::micro>::value)
+		return WireUnit::Nanoseconds;
+	else if constexpr (std::ratio_less<Period, std::milli>::value)
+		return WireUnit::Microseconds;
+	else if constexpr (std::ratio_less<Period, std::ratio<1>>::value)
+		return WireUnit::Milliseconds;
+	else
+		return WireUnit::Seconds;
+}
+
+template<WireUnit Unit>
+using WireDuration = std::conditional_t<Unit == WireUnit::Seconds, std::chrono::duration<std::int64_t>,
+	std::conditional_t<Unit == WireUnit::Milliseconds, std::chrono::duration<std::int64_t, std::milli>,
+	std::conditional_t<Unit == WireUnit::Microseconds, std::chrono::duration<std::int64_t, std::micro>,
+	std::chrono::duration<std::int64_t, std::nano>>>>;
+
+/// Drops factors of 1000 from ticks while the unit allows it.
+inline void WireReduce(std::int64_t &ticks, WireUnit &unit) {
+	while (unit != WireUnit::Seconds && ticks % 1000 == 0) {
+		ticks /= 1000;
+		unit = static_cast<WireUnit>(static_cast<std::uint8_t>(unit) - 1);
+	}
+}
+
+/// The days from year::min() to year::max(), the span of a year_month_day.
+constexpr std::int64_t WireFirstDay = date::sys_days(date::year::min() / date::January / 1).time_since_epoch().count();
+constexpr std::int64_t WireLastDay = date::sys_days(date::year::max() / date::December / 31).time_since_epoch().count();
+
+/// Whether ticks in the given unit fall between year::min() and year::max() and a day inside
+/// what Duration holds, so converting them and adding any zone offset cannot overflow.
+template<class Duration>
+bool WireTicksFit(std::int64_t ticks, WireUnit unit) {
+	constexpr std::int64_t perSecond[] = {1, 1000, 1000000, 1000000000};
+	constexpr std::int64_t range = static_cast<std::int64_t>(std::numeric_limits<typename Duration::rep>::max()
+		/ std::chrono::duration_cast<Duration>(std::chrono::seconds(1)).count()) - 86400;
+	auto p = perSecond[static_cast<std::uint8_t>(unit)];
+	auto s = ticks / p - (ticks % p < 0);
+	return s >= std::max(WireFirstDay * 86400, -range) && s <= std::min(WireLastDay * 86400 + 86399, range);
+}
+
+/// Ticks in the given unit as a Duration, rounding down when Duration is coarser.
+template<class Duration>
+Duration WireTicks(std::int64_t ticks, WireUnit unit) {
+	switch (unit) {
+	case WireUnit::Seconds:
+		return date::floor<Duration>(WireDuration<WireUnit::Seconds>(ticks));
+	case WireUnit::Milliseconds:
+		return date::floor<Duration>(WireDuration<WireUnit::Milliseconds>(ticks));
+	case WireUnit::Microseconds:
+		return date::floor<Duration>(WireDuration<WireUnit::Microseconds>(ticks));
+	default:
+		return date::floor<Duration>(WireDuration<WireUnit::Nanoseconds>(ticks));
+	}
+}
+}
+
+/// Writes Date, TimeDelta and DateTime values in a compact binary format into a caller buffer
+/// without allocating. A batch starts with WireVersion and reads back with WireReader, values
+/// must be read in the order they were written.
+///
+///   Date       zigzag varint of days since 1970-01-01
+///   TimeDelta  varint of the zigzag ticks shifted left by two, or'ed with the tick unit
+///   DateTime   varint of the zone reference shifted left by two, or'ed with the tick unit,
+///              then the zigzag varint ticks since the epoch in UTC
+///
+/// A zone reference is 0 for a zone sent by name, a varint length and the IANA name follow,
+/// or 1 + its index among the named zones of the batch. The first WireZoneTableSize named
+/// zones are interned, so a batch names each of them once.
+///
+/// Writing past the end of the buffer throws std::out_of_range and leaves the batch unusable,
+/// a TimeDelta outside WireTimeDeltaLimit throws std::out_of_range before writing anything.
+class WireWriter {
+public:
+	WireWriter(std::uint8_t *buffer, std::size_t size) :
+		_buffer(buffer), _position(buffer), _end(buffer + size) {
+		Reserve(1);
+		*_position++ = WireVersion;
+	}
+
+	/// Bytes written so far, including the version byte.
+	std::size_t Size() const { return static_cast<std::size_t>(_position - _buffer); }
+
+	void Write(const Date &d) {
+		WriteVarint(detail::WireZigZag(date::sys_days(d.YearMonthDay()).time_since_epoch().count()));
+	}
+
+	void Write(const TimeDelta &td) {
+		// Bounding the days first keeps the microseconds from overflowing
+		constexpr std::int64_t maxDays = WireTimeDeltaLimit / (std::int64_t(86400) * 1000000);
+		if (td.Days() > maxDays || td.Days() < -maxDays)
+			throw std::out_of_range("time delta is too large for the wire format");
+		auto ticks = (std::int64_t(td.Days()) * 86400 + td.Seconds()) * 1000000 + td.Microseconds();
+		if (ticks >= WireTimeDeltaLimit || ticks <= -WireTimeDeltaLimit)
+			throw std::out_of_range("time delta is too large for the wire format");
+		auto unit = detail::WireUnit::Microseconds;
+		detail::WireReduce(ticks, unit);
+		WriteUnitTicks(detail::WireZigZag(ticks), unit);
+	}
+
+	template<class Duration>
+	void Write(const DateTime<Duration> &dt) {
+		using Common = typename std::common_type<Duration, std::chrono::seconds>::type;
+		constexpr auto unit = detail::WireUnitOf<Common>();
+		auto sent = unit;
+		auto ticks = static_cast<std::int64_t>(date::floor<detail::WireDuration<unit>>(dt.ZonedTime().get_sys_time().time_since_epoch()).count());
+		detail::WireReduce(ticks, sent);
+		WriteZone(dt.Timezone(), sent);
+		WriteVarint(detail::WireZigZag(ticks));
+	}
+
+	/// Writes every value of [first, last), the count is left to the enclosing message.
+	template<class InputIt>
+	void Write(InputIt first, InputIt last) {
+		for (; first != last; ++first)
+			Write(*first);
+	}
+
+private:
+	void Reserve(std::size_t bytes) {
+		if (static_cast<std::size_t>(_end - _position) < bytes)
+			throw std::out_of_range("wire buffer is too small");
+	}
+
+	void WriteVarint(std::uint64_t value) {
+		// Ten bytes hold any varint, checking the exact length only near the end of the buffer.
+		if (_end - _position < 10)
+			Reserve((70 - detail::CountLeadingZeros(value | 1)) / 7);
+		while (value >= 0x80) {
+			*_position++ = static_cast<std::uint8_t>(value | 0x80);
+			value >>= 7;
+		}
+		*_position++ = static_cast<std::uint8_t>(value);
+	}
+
+	void WriteUnitTicks(std::uint64_t zigzag, detail::WireUnit unit) {
+		// Deltas beyond 2^61 ticks, tens of thousands of years, do not leave room for the unit.
+		if (zigzag >> 62 != 0)
+			throw std::out_of_range("time delta is too large for the wire format");
+		WriteVarint((zigzag << 2) | static_cast<std::uint8_t>(unit));
+	}
+
+	void WriteZone(const date::time_zone *zone, detail::WireUnit unit) {
+		for (std::size_t i = 0; i < _zoneCount; ++i) {
+			if (_zones[i] == zone) {
+				WriteVarint(((i + 1) << 2) | static_cast<std::uint8_t>(unit));
+				return;
+			}
+		}
+		WriteVarint(static_cast<std::uint8_t>(unit));
+		const auto &name = zone->name();
+		WriteVarint(name.size());
+		Reserve(name.size());
+		std::memcpy(_position, name.data(), name.size());
+		_position += name.size();
+		if (_zoneCount < _zones.size())
+			_zones[_zoneCount++] = zone;
+	}
+
+	std::uint8_t *_buffer;
+	std::uint8_t *_position;
+	std::uint8_t *_end;
+	std::array<const date::time_zone *, WireZoneTableSize> _zones{};
+	std::size_t _zoneCount = 0;
+};
+
+/// Reads a batch written by WireWriter from a caller buffer without allocating. Truncated
+/// input throws std::out_of_range, an unknown version or malformed value std::invalid_argument.
+/// Dates and date times outside year::min() to year::max(), or beyond what the duration read
+/// into holds, count as malformed.
+class WireReader {
+public:
+	WireReader(const std::uint8_t *data, std::size_t size) :
+		_data(data), _position(data), _end(data + size) {
+		if (size == 0)
+			throw std::out_of_range("wire batch is empty");
+		if (*_position++ != WireVersion)
+			throw std::invalid_argument("unsupported wire format version");
+	}
+
+	/// Bytes consumed so far, including the version byte.
+	std::size_t Position() const { return static_cast<std::size_t>(_position - _data); }
+	bool AtEnd() const { return _position == _end; }
+
+	void Read(Date &d) {
+		auto days = detail::WireUnZigZag(ReadVarint());
+		if (days < detail::WireFirstDay || days > detail::WireLastDay)
+			throw std::invalid_argument("wire date is out of range");
+		d = Date(date::year_month_day(date::sys_days(date::days(static_cast<date::days::rep>(days)))));
+	}
+
+	void Read(TimeDelta &td) {
+		auto value = ReadVarint();
+		auto ticks = detail::WireUnZigZag(value >> 2);
+		// The largest tick count below WireTimeDeltaLimit microseconds
+		std::int64_t limit = WireTimeDeltaLimit - 1;
+		for (auto unit = UnitOf(value); unit < detail::WireUnit::Microseconds; unit = static_cast<detail::WireUnit>(static_cast<std::uint8_t>(unit) + 1))
+			limit /= 1000;
+		if (ticks > limit || ticks < -limit)
+			throw std::invalid_argument("wire time delta is out of range");
+		td = TimeDelta(detail::WireTicks<std::chrono::microseconds>(ticks, UnitOf(value)));
+	}
+
+	template<class Duration>
+	void Read(DateTime<Duration> &dt) {
+		using Common = typename std::common_type<Duration, std::chrono::seconds>::type;
+		auto reference = ReadVarint();
+		auto zone = ReadZone(reference >> 2);
+		auto ticks = detail::WireUnZigZag(ReadVarint());
+		if (!detail::WireTicksFit<Common>(ticks, UnitOf(reference)))
+			throw std::invalid_argument("wire date time is out of range");
+		dt = DateTime<Duration>(date::make_zoned(zone, date::sys_time<Common>(detail::WireTicks<Common>(ticks, UnitOf(reference)))));
+	}
+
+	template<class T>
+	T Read() {
+		// TimeDelta has no default constructor.
+		T value = [] {
+			if constexpr (std::is_same<T, TimeDelta>::value)
+				return TimeDelta(std::chrono::seconds(0));
+			else
+				return T();
+		}();
+		Read(value);
+		return value;
+	}
+
+	/// Reads count values into out.
+	template<class OutputIt>
+	OutputIt Read(OutputIt out, std::size_t count) {
+		for (std::size_t i = 0; i < count; ++i, ++out)
+			Read(*out);
+		return out;
+	}
+
+private:
+	static detail::WireUnit UnitOf(std::uint64_t value) { return static_cast<detail::WireUnit>(value & 3); }
+
+	std::uint64_t ReadVarint() {
+		std::uint64_t value = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			if (_position == _end)
+				throw std::out_of_range("wire batch ends within a value");
+			auto byte = *_position++;
+			value |= std::uint64_t(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0)
+				return value;
+		}
+		throw std::invalid_argument("wire varint is longer than ten bytes");
+	}
+
+	const date::time_zone *ReadZone(std::uint64_t reference) {
+		if (reference != 0) {
+			if (reference > _zoneCount)
+				throw std::invalid_argument("wire zone reference is not in the batch");
+			return _zones[reference - 1];
+		}
+		auto length = ReadVarint();
+		if (length > static_cast<std::uint64_t>(_end - _position))
+			throw std::out_of_range("wire batch ends within a zone name");
+		const date::time_zone *zone;
+		try {
+			zone = date::locate_zone(std::string_view(reinterpret_cast<const char *>(_position), static_cast<std::size_t>(length)));
+		} catch (const std::runtime_error &) {
+			throw std::invalid_argument("wire batch names an unknown time zone");
+		}
+		_position += length;
+		if (_zoneCount < _zones.size())
+			_zones[_zoneCount++] = zone;
+		return zone;
+	}
+
+	const std::uint8_t *_data;
+	const std::uint8_t *_position;
+	const std::uint8_t *_end;
+	std::array<const date::time_zone *, WireZoneTableSize> _zones{};
+	std::size_t _zoneCount = 0;
+};
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "DateTime.hpp"
+
+namespace datetime {
+/// Reloads the tz database while other threads keep using it, in the manner of read-copy-update.
+/// Readers enter a read section with Read(), two atomic operations and no lock, and see one
+/// database for the whole section. Reload publishes a new database at the front of the date
+/// tzdb_list, notifies subscribers, waits until no read section can still see the older
+/// databases and only then frees them, so a reload never pauses readers.
+///
+/// Once reloads happen, zone pointers and the DateTime and zoned_time values built on them are
+/// valid until the end of the read section they came from. Values kept longer are moved to the
+/// new database with Rebind, typically from a subscriber, which runs before anything is freed.
+/// Code that reaches date::get_tzdb() directly, for example date::locate_zone or DateTime::Now,
+/// has to run inside a read section as well.
+class ZoneDatabase {
+public:
+	/// A read section, the database it sees stays alive until the guard is destroyed.
+	class ReadGuard {
+	public:
+		ReadGuard(ReadGuard &&other) noexcept :
+			_owner(std::exchange(other._owner, nullptr)), _parity(other._parity), _database(other._database) {
+		}
+
+		ReadGuard(const ReadGuard &) = delete;
+		ReadGuard &operator=(const ReadGuard &) = delete;
+		ReadGuard &operator=(ReadGuard &&) = delete;
+
+		~ReadGuard() {
+			if (_owner != nullptr)
+				_owner->_readers[_parity].count.fetch_sub(1, std::memory_order_release);
+		}
+
+		const date::tzdb &Database() const { return *_database; }
+
+		const date::time_zone *Locate(std::string_view name) const { return _database->locate_zone(name); }
+
+	private:
+		friend class ZoneDatabase;
+
+		ReadGuard(const ZoneDatabase *owner, unsigned parity) :
+			_owner(owner), _parity(parity), _database(&date::get_tzdb_list().front()) {
+		}
+
+		const ZoneDatabase *_owner;
+		unsigned _parity;
+		const date::tzdb *_database;
+	};
+
+	/// Identifies a subscription.
+	using SubscriptionId = std::uint64_t;
+
+	/// The database of the process, date keeps a single tzdb_list.
+	static ZoneDatabase &Instance() {
+		static ZoneDatabase database;
+		return database;
+	}
+
+	ZoneDatabase(const ZoneDatabase &) = delete;
+	ZoneDatabase &operator=(const ZoneDatabase &) = delete;
+
+	~ZoneDatabase() { StopWatching(); }
+
+	ReadGuard Read() const {
+		for (;;) {
+			auto epoch = _epoch.load(std::memory_order_seq_cst);
+			auto parity = static_cast<unsigned>(epoch & 1);
+			_readers[parity].count.fetch_add(1, std::memory_order_seq_cst);
+			// A reader counted under an epoch that flipped meanwhile could be missed by Reload.
+			if (_epoch.load(std::memory_order_seq_cst) == epoch)
+				return ReadGuard(this, parity);
+			_readers[parity].count.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	/// How many reloads have been published.
+	std::uint64_t Generation() const { return _generation.load(std::memory_order_acquire); }
+
+	/// Loads the database again and publishes it, returning the new generation. Subscribers are
+	/// called with the new database from this thread, after which the older databases are freed.
+	/// Must not be called from a read section of the same thread, which it would wait for.
+	std::uint64_t Reload() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		const auto &database = date::reload_tzdb();
+		auto generation = _generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+		for (const auto &subscriber : _subscribers)
+			subscriber.second(database);
+		Synchronize();
+		auto &list = date::get_tzdb_list();
+		while (std::next(list.begin()) != list.end())
+			list.erase_after(list.begin());
+		return generation;
+	}
+
+	/// Calls callback with every database Reload publishes. Callbacks must not subscribe,
+	/// unsubscribe or reload themselves.
+	SubscriptionId Subscribe(std::function<void(const date::tzdb &)> callback) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_subscribers.emplace_back(++_lastSubscription, std::move(callback));
+		return _lastSubscription;
+	}
+
+	void Unsubscribe(SubscriptionId id) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (auto it = _subscribers.begin(); it != _subscribers.end(); ++it) {
+			if (it->first == id) {
+				_subscribers.erase(it);
+				return;
+			}
+		}
+	}
+
+	/// Polls the modification times of path, a file or a directory tree such as the zoneinfo
+	/// directory, every interval from a background thread and reloads when they change. A failed
+	/// reload keeps the current database and is retried at the next poll.
+	void Watch(std::filesystem::path path, std::chrono::milliseconds interval = std::chrono::seconds(10)) {
+		StopWatching();
+		std::lock_guard<std::mutex> lock(_watchMutex);
+		_stopWatching = false;
+		_watcher = std::thread([this, path = std::move(path), interval] {
+			auto seen = LastChange(path);
+			std::unique_lock<std::mutex> lock(_watchMutex);
+			while (!_watchStopped.wait_for(lock, interval, [this] { return _stopWatching; })) {
+				lock.unlock();
+				auto change = LastChange(path);
+				if (change != seen) {
+					try {
+						Reload();
+						seen = change;
+					} catch (const std::exception &) {
+					}
+				}
+				lock.lock();
+			}
+		});
+	}
+
+	void StopWatching() {
+		{
+			std::lock_guard<std::mutex> lock(_watchMutex);
+			_stopWatching = true;
+		}
+		_watchStopped.notify_all();
+		if (_watcher.joinable())
+			_watcher.join();
+	}
+
+private:
+	ZoneDatabase() {
+		// Created first so it is destroyed after this object.
+		date::get_tzdb_list();
+	}
+
+	/// Waits until every read section that may have seen a database before the last publication
+	/// has ended. Those sections counted themselves under the current epoch, after the flip new
+	/// sections count on the other side and see the new database.
+	void Synchronize() {
+		auto epoch = _epoch.fetch_add(1, std::memory_order_seq_cst);
+		const auto &readers = _readers[epoch & 1].count;
+		while (readers.load(std::memory_order_acquire) != 0)
+			std::this_thread::yield();
+	}
+
+	/// The latest modification time under path, the minimum when it cannot be read.
+	static std::filesystem::file_time_type LastChange(const std::filesystem::path &path) {
+		std::error_code error;
+		auto latest = std::filesystem::last_write_time(path, error);
+		if (error)
+			return std::filesystem::file_time_type::min();
+		if (std::filesystem::is_directory(path, error)) {
+			for (std::filesystem::recursive_directory_iterator it(path, error), end; !error && it != end; it.increment(error)) {
+				auto time = it->last_write_time(error);
+				if (!error && time > latest)
+					latest = time;
+			}
+		}
+		return latest;
+	}
+
+	/// Each counter on its own cache line so readers of both epochs do not share one.
+	struct alignas(64) ReaderCount {
+		std::atomic<std::int64_t> count{0};
+	};
+
+	mutable std::atomic<std::uint64_t> _epoch{0};
+	mutable ReaderCount _readers[2];
+	std::atomic<std::uint64_t> _generation{0};
+
+	std::mutex _mutex;
+	std::vector<std::pair<SubscriptionId, std::function<void(const date::tzdb &)>>> _subscribers;
+	SubscriptionId _lastSubscription = 0;
+
+	std::mutex _watchMutex;
+	std::condition_variable _watchStopped;
+	bool _stopWatching = false;
+	std::thread _watcher;
+};
+
+/// The same instant in the zone of the same name in database.
+template<class Duration>
+DateTime<Duration> Rebind(const DateTime<Duration> &dt, const date::tzdb &database) {
+	return DateTime<Duration>(date::make_zoned(database.locate_zone(dt.Timezone()->name()), dt.ZonedTime().get_sys_time()));
+}
+}
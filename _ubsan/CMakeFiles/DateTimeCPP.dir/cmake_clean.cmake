@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DateTimeCPP.dir/Main.cpp.o"
+  "CMakeFiles/DateTimeCPP.dir/Main.cpp.o.d"
+  "CMakeFiles/DateTimeCPP.dir/date/tz.cpp.o"
+  "CMakeFiles/DateTimeCPP.dir/date/tz.cpp.o.d"
+  "bin/DateTimeCPP"
+  "bin/DateTimeCPP.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DateTimeCPP.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,35 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Benchmarks/ArithmeticBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ArithmeticBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ArithmeticBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/CronBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/CronBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/CronBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/FormatBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/FormatBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/FormatBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/LeapSecondBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LeapSecondBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LeapSecondBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/LocalTimeFilterBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LocalTimeFilterBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LocalTimeFilterBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/LocalTimeIndexBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LocalTimeIndexBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LocalTimeIndexBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/Main.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/Main.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/Main.cpp.o.d"
+  "/root/repo/Benchmarks/ParseBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ParseBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ParseBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/RecurrenceBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/RecurrenceBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/RecurrenceBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/StatsBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/StatsBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/StatsBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/TimeBucketBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimeBucketBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimeBucketBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/TimeZoneBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimeZoneBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimeZoneBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/TimerWheelBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimerWheelBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimerWheelBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/TimestampCodecBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimestampCodecBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimestampCodecBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/WireFormatBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/WireFormatBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/WireFormatBenchmarks.cpp.o.d"
+  "/root/repo/Benchmarks/ZoneDatabaseBenchmarks.cpp" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ZoneDatabaseBenchmarks.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ZoneDatabaseBenchmarks.cpp.o.d"
+  "/root/repo/date/tz.cpp" "CMakeFiles/DateTimeCPP_bench.dir/date/tz.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_bench.dir/date/tz.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
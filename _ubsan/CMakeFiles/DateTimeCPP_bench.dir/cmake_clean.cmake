@@ -0,0 +1,43 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ArithmeticBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ArithmeticBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/CronBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/CronBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/FormatBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/FormatBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LeapSecondBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LeapSecondBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LocalTimeFilterBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LocalTimeFilterBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LocalTimeIndexBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/LocalTimeIndexBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/Main.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/Main.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ParseBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ParseBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/RecurrenceBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/RecurrenceBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/StatsBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/StatsBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimeBucketBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimeBucketBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimeZoneBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimeZoneBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimerWheelBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimerWheelBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimestampCodecBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/TimestampCodecBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/WireFormatBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/WireFormatBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ZoneDatabaseBenchmarks.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/Benchmarks/ZoneDatabaseBenchmarks.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_bench.dir/date/tz.cpp.o"
+  "CMakeFiles/DateTimeCPP_bench.dir/date/tz.cpp.o.d"
+  "bin/DateTimeCPP_bench"
+  "bin/DateTimeCPP_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DateTimeCPP_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
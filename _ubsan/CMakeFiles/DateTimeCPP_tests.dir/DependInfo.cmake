@@ -0,0 +1,36 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Tests/BusinessCalendarTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/BusinessCalendarTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/BusinessCalendarTests.cpp.o.d"
+  "/root/repo/Tests/CronTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/CronTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/CronTests.cpp.o.d"
+  "/root/repo/Tests/DateRangeTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/DateRangeTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/DateRangeTests.cpp.o.d"
+  "/root/repo/Tests/DateTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/DateTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/DateTests.cpp.o.d"
+  "/root/repo/Tests/LeapSecondTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/LeapSecondTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/LeapSecondTests.cpp.o.d"
+  "/root/repo/Tests/LocalTimeFilterTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/LocalTimeFilterTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/LocalTimeFilterTests.cpp.o.d"
+  "/root/repo/Tests/LocalTimeIndexTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/LocalTimeIndexTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/LocalTimeIndexTests.cpp.o.d"
+  "/root/repo/Tests/Main.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/Main.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/Main.cpp.o.d"
+  "/root/repo/Tests/ParseTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/ParseTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/ParseTests.cpp.o.d"
+  "/root/repo/Tests/RecurrenceTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/RecurrenceTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/RecurrenceTests.cpp.o.d"
+  "/root/repo/Tests/TimeBucketTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimeBucketTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimeBucketTests.cpp.o.d"
+  "/root/repo/Tests/TimeZoneTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimeZoneTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimeZoneTests.cpp.o.d"
+  "/root/repo/Tests/TimerWheelTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimerWheelTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimerWheelTests.cpp.o.d"
+  "/root/repo/Tests/TimestampCodecTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimestampCodecTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimestampCodecTests.cpp.o.d"
+  "/root/repo/Tests/TraceTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/TraceTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/TraceTests.cpp.o.d"
+  "/root/repo/Tests/WireFormatTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/WireFormatTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/WireFormatTests.cpp.o.d"
+  "/root/repo/Tests/ZoneDatabaseTests.cpp" "CMakeFiles/DateTimeCPP_tests.dir/Tests/ZoneDatabaseTests.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/Tests/ZoneDatabaseTests.cpp.o.d"
+  "/root/repo/date/tz.cpp" "CMakeFiles/DateTimeCPP_tests.dir/date/tz.cpp.o" "gcc" "CMakeFiles/DateTimeCPP_tests.dir/date/tz.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,45 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/BusinessCalendarTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/BusinessCalendarTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/CronTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/CronTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/DateRangeTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/DateRangeTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/DateTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/DateTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/LeapSecondTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/LeapSecondTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/LocalTimeFilterTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/LocalTimeFilterTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/LocalTimeIndexTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/LocalTimeIndexTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/Main.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/Main.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/ParseTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/ParseTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/RecurrenceTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/RecurrenceTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimeBucketTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimeBucketTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimeZoneTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimeZoneTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimerWheelTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimerWheelTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimestampCodecTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/TimestampCodecTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/TraceTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/TraceTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/WireFormatTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/WireFormatTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/ZoneDatabaseTests.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/Tests/ZoneDatabaseTests.cpp.o.d"
+  "CMakeFiles/DateTimeCPP_tests.dir/date/tz.cpp.o"
+  "CMakeFiles/DateTimeCPP_tests.dir/date/tz.cpp.o.d"
+  "bin/DateTimeCPP_tests"
+  "bin/DateTimeCPP_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DateTimeCPP_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
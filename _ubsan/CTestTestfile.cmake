@@ -0,0 +1,38 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_ubsan
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(BusinessCalendar "/root/repo/_ubsan/bin/DateTimeCPP_tests" "BusinessCalendar/")
+set_tests_properties(BusinessCalendar PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Cron "/root/repo/_ubsan/bin/DateTimeCPP_tests" "Cron/")
+set_tests_properties(Cron PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Date "/root/repo/_ubsan/bin/DateTimeCPP_tests" "Date/")
+set_tests_properties(Date PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(DateRange "/root/repo/_ubsan/bin/DateTimeCPP_tests" "DateRange/")
+set_tests_properties(DateRange PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(LeapSeconds "/root/repo/_ubsan/bin/DateTimeCPP_tests" "LeapSeconds/")
+set_tests_properties(LeapSeconds PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(LocalTimeFilter "/root/repo/_ubsan/bin/DateTimeCPP_tests" "LocalTimeFilter/")
+set_tests_properties(LocalTimeFilter PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(LocalTimeIndex "/root/repo/_ubsan/bin/DateTimeCPP_tests" "LocalTimeIndex/")
+set_tests_properties(LocalTimeIndex PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Parse "/root/repo/_ubsan/bin/DateTimeCPP_tests" "Parse/")
+set_tests_properties(Parse PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Recurrence "/root/repo/_ubsan/bin/DateTimeCPP_tests" "Recurrence/")
+set_tests_properties(Recurrence PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(TimeBuckets "/root/repo/_ubsan/bin/DateTimeCPP_tests" "TimeBuckets/")
+set_tests_properties(TimeBuckets PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(TimerWheel "/root/repo/_ubsan/bin/DateTimeCPP_tests" "TimerWheel/")
+set_tests_properties(TimerWheel PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(TimeZone "/root/repo/_ubsan/bin/DateTimeCPP_tests" "TimeZone/")
+set_tests_properties(TimeZone PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(TimestampCodec "/root/repo/_ubsan/bin/DateTimeCPP_tests" "TimestampCodec/")
+set_tests_properties(TimestampCodec PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Trace "/root/repo/_ubsan/bin/DateTimeCPP_tests" "Trace/")
+set_tests_properties(Trace PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(WireFormat "/root/repo/_ubsan/bin/DateTimeCPP_tests" "WireFormat/")
+set_tests_properties(WireFormat PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(ZoneDatabase "/root/repo/_ubsan/bin/DateTimeCPP_tests" "ZoneDatabase/")
+set_tests_properties(ZoneDatabase PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;151;add_test;/root/repo/CMakeLists.txt;0;")
@@ -103,12 +103,14 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory>
 #if USE_OS_TZDB
 #  include <queue>
 #endif
 #include <sstream>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 #include <sys/stat.h>
@@ -334,6 +336,22 @@ CONSTDATA auto max_year = date::year::max();
 CONSTDATA auto min_day = date::January/1;
 CONSTDATA auto max_day = date::December/31;
 
+#if !USE_OS_TZDB
+
+// Instants in these years are answered from a transition table each zone builds at first
+// use, the rule engine handles the others.  A first year after the last one disables it.
+#ifndef TRANSITION_TABLE_FIRST_YEAR
+#  define TRANSITION_TABLE_FIRST_YEAR 1970
+#endif
+#ifndef TRANSITION_TABLE_LAST_YEAR
+#  define TRANSITION_TABLE_LAST_YEAR 2100
+#endif
+
+CONSTDATA auto table_first_year = date::year{TRANSITION_TABLE_FIRST_YEAR};
+CONSTDATA auto table_last_year = date::year{TRANSITION_TABLE_LAST_YEAR};
+
+#endif  // !USE_OS_TZDB
+
 #if USE_OS_TZDB
 
 CONSTCD14 const sys_seconds min_seconds = sys_days(min_year/min_day);
@@ -1715,16 +1733,462 @@ detail::zonelet::zonelet(const zonelet& i)
 
 #endif  // !USE_OS_TZDB
 
+#if TZ_STATS
+
+// stats
+
+namespace detail
+{
+
+namespace
+{
+
+CONSTDATA unsigned stat_count = static_cast<unsigned>(stat_id::count);
+
+struct stat_block;
+
+// The blocks of running threads and the sums of the threads that have exited.
+struct stat_registry
+{
+    std::mutex               mutex;
+    std::vector<stat_block*> blocks;
+    std::uint64_t            retired[stat_count] = {};
+};
+
+stat_registry&
+get_stat_registry()
+{
+    // Never destroyed, threads may exit after static destruction has begun.
+    static stat_registry* registry = new stat_registry;
+    return *registry;
+}
+
+// Only its own thread writes a block, so a relaxed load and store add without a
+// locked instruction while read_stats can still read it from other threads.
+struct stat_block
+{
+    std::atomic<std::uint64_t> values[stat_count] = {};
+
+    stat_block()
+    {
+        auto& registry = get_stat_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.blocks.push_back(this);
+    }
+
+    ~stat_block()
+    {
+        auto& registry = get_stat_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (unsigned i = 0; i < stat_count; ++i)
+            registry.retired[i] += values[i].load(std::memory_order_relaxed);
+        registry.blocks.erase(std::find(registry.blocks.begin(), registry.blocks.end(), this));
+    }
+};
+
+thread_local stat_block thread_stats;
+
+}  // unnamed namespace
+
+void
+add_stat(stat_id s, std::uint64_t n) NOEXCEPT
+{
+    auto& value = thread_stats.values[static_cast<unsigned>(s)];
+    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+void
+read_stats(std::uint64_t (&values)[static_cast<unsigned>(stat_id::count)])
+{
+    auto& registry = get_stat_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (unsigned i = 0; i < stat_count; ++i)
+        values[i] = registry.retired[i];
+    for (auto block : registry.blocks)
+        for (unsigned i = 0; i < stat_count; ++i)
+            values[i] += block->values[i].load(std::memory_order_relaxed);
+}
+
+}  // namespace detail
+
+#endif  // TZ_STATS
+
+// tzdb_tracer
+
+static std::atomic<tzdb_tracer*> installed_tracer{nullptr};
+// Spans holding a tracer.  A span counts itself before it reads the tracer and
+// set_tzdb_tracer swaps the tracer before it reads the count, so once the count has been
+// seen at zero no span can still report to the tracer that was replaced.
+static std::atomic<unsigned> active_spans{0};
+
+tzdb_tracer*
+set_tzdb_tracer(tzdb_tracer* t) NOEXCEPT
+{
+    auto previous = installed_tracer.exchange(t);
+    while (active_spans.load() != 0)
+        std::this_thread::yield();
+    return previous;
+}
+
+namespace detail
+{
+
+namespace
+{
+
+// Reports a span to the installed tracer when it goes out of scope, nothing but a load
+// when no tracer is installed.  While it holds a tracer it is counted in active_spans,
+// which keeps set_tzdb_tracer from returning the tracer to be destroyed.
+class trace_scope
+{
+    tzdb_tracer* tracer_;
+    tzdb_span    span_;
+
+public:
+    explicit trace_scope(const char* name, const char* detail = nullptr) NOEXCEPT
+        : tracer_(installed_tracer.load(std::memory_order_relaxed))
+        , span_{name, detail, 0, {}, {}}
+    {
+        if (tracer_ == nullptr)
+            return;
+        ++active_spans;
+        tracer_ = installed_tracer.load();
+        if (tracer_ == nullptr)
+            --active_spans;
+        else
+            span_.begin = std::chrono::steady_clock::now();
+    }
+
+    ~trace_scope()
+    {
+        if (tracer_ != nullptr)
+        {
+            span_.end = std::chrono::steady_clock::now();
+            tracer_->span(span_);
+            --active_spans;
+        }
+    }
+
+    void add_bytes(std::uintmax_t n) NOEXCEPT {span_.bytes += n;}
+
+    trace_scope(const trace_scope&) = delete;
+    trace_scope& operator=(const trace_scope&) = delete;
+};
+
+}  // unnamed namespace
+
+}  // namespace detail
+
 // time_zone
 
+// A sys_info gets a copy of the interned abbreviation, a sys_info_view refers to it.
+static
+inline
+void
+set_abbrev(sys_info& r, const detail::tz_string& abbrev)
+{
+    r.abbrev.assign(abbrev.data(), abbrev.size());
+}
+
+#if HAS_STRING_VIEW
+
+static
+inline
+void
+set_abbrev(sys_info_view& r, const detail::tz_string& abbrev)
+{
+    r.abbrev = abbrev;
+}
+
+sys_info_view
+time_zone::get_info_view_impl(sys_seconds tp) const
+{
+    detail::add_stat(detail::stat_id::sys_info_calls);
+    return get_sys_info<sys_info_view>(tp);
+}
+
+local_info_view
+time_zone::get_info_view_impl(local_seconds tp) const
+{
+    detail::add_stat(detail::stat_id::local_info_calls);
+    return get_local_info<local_info_view>(tp);
+}
+
+#endif  // HAS_STRING_VIEW
+
+// What a zone owns goes into the arena of its tzdb, when there is one.  Tables are
+// built in a std::vector and copied in once complete, so that growing them leaves
+// nothing behind in the arena.
+
+template <class T>
+static
+inline
+void
+move_into(std::vector<T>& to, std::vector<T>&& from)
+{
+    to = std::move(from);
+}
+
+template <class T, class U, class ...Args>
+static
+inline
+detail::tz_unique_ptr<T>
+make_tz_unique(const std::allocator<U>&, Args&& ...args)
+{
+    return detail::tz_unique_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+#if TZ_ARENA
+
+template <class T>
+static
+inline
+void
+move_into(std::pmr::vector<T>& to, std::vector<T>&& from)
+{
+    to.assign(std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+}
+
+template <class T, class U, class ...Args>
+static
+inline
+detail::tz_unique_ptr<T>
+make_tz_unique(const std::pmr::polymorphic_allocator<U>& a, Args&& ...args)
+{
+    auto p = a.resource()->allocate(sizeof(T), alignof(T));
+    return detail::tz_unique_ptr<T>(::new (p) T(std::forward<Args>(args)...),
+                                    detail::arena_delete{a.resource()});
+}
+
+#endif  // TZ_ARENA
+
+sys_info
+time_zone::get_info_impl(sys_seconds tp) const
+{
+    detail::add_stat(detail::stat_id::sys_info_calls);
+    return get_sys_info<sys_info>(tp);
+}
+
+local_info
+time_zone::get_info_impl(local_seconds tp) const
+{
+    detail::add_stat(detail::stat_id::local_info_calls);
+    return get_local_info<local_info>(tp);
+}
+
 #if USE_OS_TZDB
 
+#if TZ_ARENA
+
+time_zone::time_zone(const std::string& s, detail::undocumented)
+    : time_zone(s, std::pmr::get_default_resource(), detail::undocumented{})
+{
+}
+
+time_zone::time_zone(const std::string& s, std::pmr::memory_resource* arena,
+                     detail::undocumented)
+    : name_(s)
+    , transitions_(arena)
+    , ttinfos_(arena)
+    , search_tree_(arena)
+    , offsets_(arena)
+    , is_dst_(arena)
+    , abbrev_indices_(arena)
+    , adjusted_(make_tz_unique<std::once_flag>(transitions_.get_allocator()))
+{
+}
+
+#else  // !TZ_ARENA
+
 time_zone::time_zone(const std::string& s, detail::undocumented)
     : name_(s)
+#  if TZ_ZONE_BUDGET
+    , residency_(new detail::zone_residency)
+#  endif
     , adjusted_(new std::once_flag{})
 {
 }
 
+#endif  // !TZ_ARENA
+
+#if TZ_ZONE_BUDGET
+
+// zone memory budget
+
+namespace detail
+{
+
+// The zones whose tables are in memory, held to the budget.  A zone joins the list when
+// it is read, by then its tzdb is complete and it no longer moves, and leaves it when
+// its tables are dropped or it is destroyed.
+class residency_list
+{
+    std::mutex                    mutex_;
+    std::vector<const time_zone*> zones_;
+    std::size_t                   budget_ = 0;
+    std::size_t                   bytes_ = 0;
+    std::uint64_t                 evictions_ = 0;
+    std::uint64_t                 reloads_ = 0;
+    std::atomic<std::uint64_t>    clock_{1};  // advances with every zone read
+
+public:
+    static
+    residency_list&
+    instance()
+    {
+        // Never destroyed, zones may be destroyed after static destruction has begun.
+        static residency_list* list = new residency_list;
+        return *list;
+    }
+
+    // Keeps the tables of z until the lock is released, and marks z used now.  Only
+    // a stamp that changed is stored, so lookups of a hot zone share its cache line.
+    std::shared_lock<std::shared_mutex>
+    pin(const time_zone& z)
+    {
+        auto& r = *z.residency_;
+        std::shared_lock<std::shared_mutex> lock(r.mutex);
+        auto now = clock_.load(std::memory_order_relaxed);
+        if (r.last_use.load(std::memory_order_relaxed) != now)
+            r.last_use.store(now, std::memory_order_relaxed);
+        return lock;
+    }
+
+    // Counts the tables z has just read while pinned, and makes room for them.
+    void
+    admit(const time_zone& z)
+    {
+        auto& r = *z.residency_;
+        std::lock_guard<std::mutex> lock(mutex_);
+        r.bytes = z.table_bytes();
+        r.resident = true;
+        if (r.dropped)
+            ++reloads_;
+        r.dropped = false;
+        r.last_use.store(clock_.fetch_add(1, std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+        zones_.push_back(&z);
+        bytes_ += r.bytes;
+        shrink(&z);
+    }
+
+    void
+    remove(const time_zone& z)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!z.residency_->resident)
+            return;
+        zones_.erase(std::find(zones_.begin(), zones_.end(), &z));
+        bytes_ -= z.residency_->bytes;
+    }
+
+    void
+    set_budget(std::size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        budget_ = bytes;
+        shrink(nullptr);
+    }
+
+    zone_memory
+    memory()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return {budget_, bytes_, zones_.size(), evictions_, reloads_};
+    }
+
+private:
+    // Drops the tables of the zones used longest ago until the rest fit the budget,
+    // passing over keep and the zones being read.
+    void
+    shrink(const time_zone* keep)
+    {
+        if (budget_ == 0 || bytes_ <= budget_)
+            return;
+        // The stamps keep changing, sort a copy of them.
+        std::vector<std::pair<std::uint64_t, const time_zone*>> order;
+        order.reserve(zones_.size());
+        for (auto z : zones_)
+            order.emplace_back(z->residency_->last_use.load(std::memory_order_relaxed), z);
+        std::sort(order.begin(), order.end());
+        for (auto const& o : order)
+        {
+            if (bytes_ <= budget_)
+                break;
+            auto z = o.second;
+            if (z == keep)
+                continue;
+            auto& r = *z->residency_;
+            std::unique_lock<std::shared_mutex> lock(r.mutex, std::try_to_lock);
+            if (!lock.owns_lock())
+                continue;
+            const_cast<time_zone*>(z)->drop_tables();
+            zones_.erase(std::find(zones_.begin(), zones_.end(), z));
+            bytes_ -= r.bytes;
+            r.bytes = 0;
+            r.resident = false;
+            r.dropped = true;
+            ++evictions_;
+        }
+    }
+};
+
+}  // namespace detail
+
+time_zone::~time_zone()
+{
+    if (residency_ != nullptr)
+        detail::residency_list::instance().remove(*this);
+}
+
+std::size_t
+time_zone::table_bytes() const NOEXCEPT
+{
+    return transitions_.capacity() * sizeof(detail::transition) +
+           ttinfos_.capacity() * sizeof(detail::expanded_ttinfo) +
+           (posix_ != nullptr ? sizeof(detail::posix_rule) : 0) +
+           search_tree_.capacity() * sizeof(std::int64_t) +
+           offsets_.capacity() * sizeof(std::int32_t) +
+           is_dst_.capacity() + abbrev_indices_.capacity();
+}
+
+template <class T>
+static
+inline
+void
+free_table(std::vector<T>& v)
+{
+    std::vector<T>().swap(v);
+}
+
+// Frees what init_impl read, which it reads again on the next use of the zone.
+void
+time_zone::drop_tables()
+{
+    free_table(transitions_);
+    free_table(ttinfos_);
+    posix_.reset();
+    free_table(search_tree_);
+    free_table(offsets_);
+    free_table(is_dst_);
+    free_table(abbrev_indices_);
+    adjusted_.reset(new std::once_flag{});
+}
+
+void
+set_zone_memory_budget(std::size_t bytes)
+{
+    detail::residency_list::instance().set_budget(bytes);
+}
+
+zone_memory
+get_zone_memory()
+{
+    return detail::residency_list::instance().memory();
+}
+
+#endif  // TZ_ZONE_BUDGET
+
 enum class endian
 {
     native = __BYTE_ORDER__,
@@ -1999,7 +2463,7 @@ time_zone::load_data(std::istream& inf,
                      std::int32_t tzh_typecnt, std::int32_t tzh_charcnt)
 {
     using namespace std::chrono;
-    transitions_ = load_transitions<TimeType>(inf, tzh_timecnt);
+    auto transitions = load_transitions<TimeType>(inf, tzh_timecnt);
     auto indices = load_indices(inf, tzh_timecnt);
     auto infos = load_ttinfo(inf, tzh_typecnt);
     auto abbrev = load_abbreviations(inf, tzh_charcnt);
@@ -2008,27 +2472,328 @@ time_zone::load_data(std::istream& inf,
     if (leap_seconds.empty() && tzh_leapcnt > 0)
         leap_seconds = load_leaps<TimeType>(inf, tzh_leapcnt);
 #endif
+    assert(abbrevs_ != nullptr);
     ttinfos_.reserve(infos.size());
     for (auto& info : infos)
     {
         ttinfos_.push_back({seconds{info.tt_gmtoff},
-                            abbrev.c_str() + info.tt_abbrind,
+                            &abbrevs_->intern(abbrev.c_str() + info.tt_abbrind),
                             info.tt_isdst != 0});
     }
     auto i = 0u;
-    if (transitions_.empty() || transitions_.front().timepoint != min_seconds)
+    if (transitions.empty() || transitions.front().timepoint != min_seconds)
     {
-        transitions_.emplace(transitions_.begin(), min_seconds);
+        transitions.emplace(transitions.begin(), min_seconds);
         auto tf = std::find_if(ttinfos_.begin(), ttinfos_.end(),
                                [](const expanded_ttinfo& ti)
                                    {return ti.is_dst == 0;});
         if (tf == ttinfos_.end())
             tf = ttinfos_.begin();
-        transitions_[i].info = &*tf;
+        transitions[i].info = &*tf;
         ++i;
     }
-    for (auto j = 0u; i < transitions_.size(); ++i, ++j)
-        transitions_[i].info = ttinfos_.data() + indices[j];
+    for (auto j = 0u; i < transitions.size(); ++i, ++j)
+        transitions[i].info = ttinfos_.data() + indices[j];
+    move_into(transitions_, std::move(transitions));
+}
+
+// The POSIX TZ string at the end of a TZif file
+
+static
+bool
+read_posix_name(const char*& p, const char* e, std::string& name)
+{
+    if (p != e && *p == '<')
+    {
+        auto close = std::find(p+1, e, '>');
+        if (close == e)
+            return false;
+        name.assign(p+1, close);
+        p = close + 1;
+    }
+    else
+    {
+        auto b = p;
+        while (p != e && std::isalpha(static_cast<unsigned char>(*p)))
+            ++p;
+        name.assign(b, p);
+    }
+    return !name.empty();
+}
+
+static
+bool
+read_posix_number(const char*& p, const char* e, unsigned& n)
+{
+    if (p == e || !std::isdigit(static_cast<unsigned char>(*p)))
+        return false;
+    n = 0;
+    for (auto digits = 0; p != e && std::isdigit(static_cast<unsigned char>(*p)); ++p)
+    {
+        if (++digits > 3)
+            return false;
+        n = 10*n + static_cast<unsigned>(*p - '0');
+    }
+    return true;
+}
+
+// [+|-]hh[:mm[:ss]], with hours up to 167 as TZif version 3 allows
+static
+bool
+read_posix_time(const char*& p, const char* e, std::chrono::seconds& t)
+{
+    auto sign = 1;
+    if (p != e && (*p == '+' || *p == '-'))
+        sign = *p++ == '-' ? -1 : 1;
+    unsigned h, m = 0, s = 0;
+    if (!read_posix_number(p, e, h))
+        return false;
+    if (p != e && *p == ':')
+    {
+        if (!read_posix_number(++p, e, m))
+            return false;
+        if (p != e && *p == ':' && !read_posix_number(++p, e, s))
+            return false;
+    }
+    t = std::chrono::seconds{sign * static_cast<long>(3600*h + 60*m + s)};
+    return h <= 167 && m < 60 && s < 60;
+}
+
+static
+bool
+read_posix_change(const char*& p, const char* e, detail::posix_rule::change& c)
+{
+    using change = detail::posix_rule::change;
+    if (p == e || *p++ != ',')
+        return false;
+    c.n = c.m = c.w = c.d = 0;
+    if (p != e && *p == 'J')
+    {
+        c.kind = change::julian;
+        if (!read_posix_number(++p, e, c.n) || c.n < 1 || c.n > 365)
+            return false;
+    }
+    else if (p != e && *p == 'M')
+    {
+        c.kind = change::month_week_day;
+        if (!read_posix_number(++p, e, c.m) || c.m < 1 || c.m > 12 ||
+            p == e || *p != '.' || !read_posix_number(++p, e, c.w) || c.w < 1 || c.w > 5 ||
+            p == e || *p != '.' || !read_posix_number(++p, e, c.d) || c.d > 6)
+            return false;
+    }
+    else
+    {
+        c.kind = change::zero_based;
+        if (!read_posix_number(p, e, c.n) || c.n > 365)
+            return false;
+    }
+    c.time = std::chrono::hours{2};
+    if (p != e && *p == '/')
+        return read_posix_time(++p, e, c.time);
+    return true;
+}
+
+// False when tz has no daylight saving time or cannot be read, the last transition
+// then stays in effect as it always has.
+static
+bool
+parse_posix_rule(const std::string& tz, detail::abbrev_pool& abbrevs, detail::posix_rule& r)
+{
+    using namespace std::chrono;
+    static std::atomic<std::uint64_t> last_id{0};
+    auto p = tz.data();
+    auto e = p + tz.size();
+    std::string std_abbrev, dst_abbrev;
+    seconds std_time, dst_time;
+    if (!read_posix_name(p, e, std_abbrev) || !read_posix_time(p, e, std_time) ||
+        p == e || !read_posix_name(p, e, dst_abbrev))
+        return false;
+    // POSIX offsets are positive west of Greenwich.
+    dst_time = std_time - hours{1};
+    if (p != e && *p != ',' && !read_posix_time(p, e, dst_time))
+        return false;
+    if (p == e)
+    {
+        // The default of POSIX is implementation defined, this is the one of glibc.
+        r.start = {detail::posix_rule::change::month_week_day, 0, 3, 2, 0, hours{2}};
+        r.end = {detail::posix_rule::change::month_week_day, 0, 11, 1, 0, hours{2}};
+    }
+    else if (!read_posix_change(p, e, r.start) || !read_posix_change(p, e, r.end) ||
+             p != e)
+        return false;
+    r.id = ++last_id;
+    r.std_info = {-std_time, &abbrevs.intern(std_abbrev), false};
+    r.dst_info = {-dst_time, &abbrevs.intern(dst_abbrev), true};
+    return true;
+}
+
+static
+sys_seconds
+posix_change_time(const detail::posix_rule::change& c, year y, std::chrono::seconds offset)
+{
+    using change = detail::posix_rule::change;
+    sys_days d;
+    switch (c.kind)
+    {
+    case change::julian:
+        d = sys_days(y/jan/1) + days{static_cast<int>(c.n) - (c.n < 60 || !y.is_leap())};
+        break;
+    case change::zero_based:
+        d = sys_days(y/jan/1) + days{static_cast<int>(c.n)};
+        break;
+    default:
+        if (c.w == 5)
+            d = sys_days(y/month{c.m}/weekday{c.d}[last]);
+        else
+            d = sys_days(y/month{c.m}/weekday{c.d}[c.w]);
+        break;
+    }
+    return d + c.time - offset;
+}
+
+static
+bool
+same_info(const detail::expanded_ttinfo& x, const detail::expanded_ttinfo& y)
+{
+    return x.offset == y.offset && x.abbrev == y.abbrev && x.is_dst == y.is_dst;
+}
+
+// The last three transitions of the file followed by those of rule r in the years y-2
+// through y+2, enough for any lookup in year y.  The result is cached per thread, a few
+// zones and years at a time, and valid until the next call from the same thread.
+static
+const std::vector<detail::transition>&
+posix_transitions(const detail::posix_rule& r,
+                  const detail::tz_vector<detail::transition>& transitions, year y)
+{
+    using detail::transition;
+    struct cache
+    {
+        std::uint64_t           id = 0;
+        year                    y;
+        std::vector<transition> transitions;
+        std::vector<transition> changes;
+    };
+    thread_local cache caches[8];
+    auto& c = caches[(r.id*5 + static_cast<unsigned>(static_cast<int>(y))) % 8];
+    if (c.id == r.id && c.y == y)
+        return c.transitions;
+    c.changes.clear();
+    for (auto i = y - years{2}; i <= y + years{2}; ++i)
+    {
+        if (!i.ok())
+            continue;
+        c.changes.emplace_back(posix_change_time(r.start, i, r.std_info.offset),
+                               &r.dst_info);
+        c.changes.emplace_back(posix_change_time(r.end, i, r.dst_info.offset),
+                               &r.std_info);
+    }
+    // Nearly sorted already, an insertion sort keeps equal instants in order and
+    // allocates nothing.
+    auto earlier = [](const transition& x, const transition& t)
+                   {
+                       return x.timepoint < t.timepoint;
+                   };
+    for (auto i = c.changes.begin(); i != c.changes.end(); ++i)
+        std::rotate(std::upper_bound(c.changes.begin(), i, *i, earlier), i, i + 1);
+    c.transitions.assign(transitions.end() - std::min<std::size_t>(transitions.size(), 3),
+                         transitions.end());
+    auto n = c.transitions.size();
+    for (auto const& t : c.changes)
+    {
+        if (t.timepoint <= transitions.back().timepoint)
+            continue;
+        // A change at the instant of the previous one replaces it.
+        if (c.transitions.size() > n && c.transitions.back().timepoint == t.timepoint)
+            c.transitions.pop_back();
+        if (!same_info(*c.transitions.back().info, *t.info))
+            c.transitions.push_back(t);
+    }
+    c.id = r.id;
+    c.y = y;
+    return c.transitions;
+}
+
+// The search index holds the timepoints of transitions_ in Eytzinger order: tree[1] is
+// the middle one, and the children of tree[k] are tree[2k] and tree[2k+1], so the first
+// steps of every search share a few cache lines.  The tree is complete, its size a power
+// of 2 with tree[0] unused, and padded past the last transition with the largest time.
+
+static
+void
+eytzinger_fill(std::vector<std::int64_t>& tree, const std::vector<std::int64_t>& sorted,
+               std::size_t& i, std::size_t k)
+{
+    if (k >= tree.size())
+        return;
+    eytzinger_fill(tree, sorted, i, 2*k);
+    tree[k] = i < sorted.size() ? sorted[i] : std::numeric_limits<std::int64_t>::max();
+    ++i;
+    eytzinger_fill(tree, sorted, i, 2*k+1);
+}
+
+// The number of timepoints of tree at or before x.  Every search takes the full height
+// of the tree, each step adding a comparison to the index rather than branching on it,
+// and the leaf it ends at, counted from the left, is that number.
+static
+inline
+std::size_t
+eytzinger_upper_bound(const detail::tz_vector<std::int64_t>& tree, std::int64_t x)
+{
+    auto p = tree.data();
+    auto n = tree.size();
+    std::size_t k = 1;
+    while (k < n)
+        k = 2*k + (p[k] <= x);
+    return k - n;
+}
+
+// The index in tree of the timepoint that is i-th in sorted order: the ancestor of leaf
+// i+1 where the path from the root last went right.
+static
+inline
+std::size_t
+eytzinger_index(const detail::tz_vector<std::int64_t>& tree, std::size_t i)
+{
+    auto k = tree.size() + i + 1;
+#if defined(__GNUC__)
+    return k >> (__builtin_ctzll(i + 1) + 1);
+#else
+    for (k >>= 1, ++i; (i & 1) == 0; i >>= 1)
+        k >>= 1;
+    return k;
+#endif
+}
+
+void
+time_zone::build_search_index()
+{
+    auto n = transitions_.size();
+    std::vector<std::int64_t> sorted;
+    std::vector<std::int32_t> offsets;
+    std::vector<std::uint8_t> is_dst;
+    std::vector<std::uint8_t> abbrev_indices;
+    sorted.reserve(n);
+    offsets.reserve(n);
+    is_dst.reserve(n);
+    abbrev_indices.reserve(n);
+    for (auto const& t : transitions_)
+    {
+        sorted.push_back(t.timepoint.time_since_epoch().count());
+        offsets.push_back(static_cast<std::int32_t>(t.info->offset.count()));
+        is_dst.push_back(t.info->is_dst);
+        abbrev_indices.push_back(static_cast<std::uint8_t>(t.info - ttinfos_.data()));
+    }
+    std::size_t size = 1;
+    while (size <= n)
+        size *= 2;
+    std::vector<std::int64_t> tree(size);
+    std::size_t i = 0;
+    eytzinger_fill(tree, sorted, i, 1);
+    move_into(search_tree_, std::move(tree));
+    move_into(offsets_, std::move(offsets));
+    move_into(is_dst_, std::move(is_dst));
+    move_into(abbrev_indices_, std::move(abbrev_indices));
 }
 
 void
@@ -2036,6 +2801,7 @@ time_zone::init_impl()
 {
     using namespace std;
     using namespace std::chrono;
+    detail::trace_scope trace("load_zone", name_.c_str());
     auto name = get_tz_dir() + ('/' + name_);
     std::ifstream inf(name);
     if (!inf.is_open())
@@ -2067,8 +2833,25 @@ time_zone::init_impl()
 #endif  // defined(NDEBUG)
         load_counts(inf, tzh_ttisgmtcnt, tzh_ttisstdcnt, tzh_leapcnt,
                          tzh_timecnt,    tzh_typecnt,    tzh_charcnt);
+        auto footer = inf.tellg() + static_cast<std::streamoff>(
+                          (8+1)*tzh_timecnt + 6*tzh_typecnt + tzh_charcnt +
+                          (8+4)*tzh_leapcnt + tzh_ttisstdcnt + tzh_ttisgmtcnt);
         load_data<int64_t>(inf, tzh_leapcnt, tzh_timecnt, tzh_typecnt, tzh_charcnt);
+        // The TZ string between two newlines gives the offsets after the last transition.
+        inf.seekg(footer);
+        if (inf.peek() == '\n')
+        {
+            inf.get();
+            std::string tz;
+            std::getline(inf, tz);
+            detail::posix_rule rule;
+            if (parse_posix_rule(tz, *abbrevs_, rule))
+                posix_ = make_tz_unique<detail::posix_rule>(transitions_.get_allocator(), rule);
+        }
+        else
+            inf.clear();  // peek may have reached the end of a file without one
     }
+    trace.add_bytes(static_cast<std::uintmax_t>(inf.tellg()));
 #if !MISSING_LEAP_SECONDS
     if (tzh_leapcnt > 0)
     {
@@ -2107,64 +2890,120 @@ time_zone::init_impl()
                 i = transitions_.erase(i);
         }
     }
+    build_search_index();
 }
 
 void
 time_zone::init() const
 {
-    std::call_once(*adjusted_, [this]() {const_cast<time_zone*>(this)->init_impl();});
+    std::call_once(*adjusted_,
+                   [this]()
+                   {
+                       detail::stat_timer timer(detail::stat_id::zone_loads, detail::stat_id::zone_load_ns);
+                       const_cast<time_zone*>(this)->init_impl();
+#if TZ_ZONE_BUDGET
+                       detail::residency_list::instance().admit(*this);
+#endif
+                   });
 }
 
-sys_info
-time_zone::load_sys_info(std::vector<detail::transition>::const_iterator i) const
+template <class SysInfo>
+SysInfo
+time_zone::load_sys_info(const detail::transition* i, const detail::transition* last) const
 {
     using namespace std::chrono;
     assert(!transitions_.empty());
-    assert(i != transitions_.begin());
-    sys_info r;
+    SysInfo r;
     r.begin = i[-1].timepoint;
-    r.end = i != transitions_.end() ? i->timepoint :
-                                      sys_seconds(sys_days(year::max()/max_day));
+    r.end = i != last ? i->timepoint : sys_seconds(sys_days(year::max()/max_day));
     r.offset = i[-1].info->offset;
     r.save = i[-1].info->is_dst ? minutes{1} : minutes{0};
-    r.abbrev = i[-1].info->abbrev;
+    set_abbrev(r, *i[-1].info->abbrev);
     return r;
 }
 
-sys_info
-time_zone::get_info_impl(sys_seconds tp) const
+// The period that transition i-1 begins, read from the search index.
+template <class SysInfo>
+SysInfo
+time_zone::load_sys_info(std::size_t i) const
 {
-    using namespace std;
-    init();
-    return load_sys_info(upper_bound(transitions_.begin(), transitions_.end(), tp,
-                                     [](const sys_seconds& x, const transition& t)
-                                     {
-                                         return x < t.timepoint;
-                                     }));
+    using namespace std::chrono;
+    assert(i > 0 && i <= offsets_.size());
+    SysInfo r;
+    r.begin = sys_seconds{seconds{search_tree_[eytzinger_index(search_tree_, i-1)]}};
+    r.end = i != offsets_.size()
+                ? sys_seconds{seconds{search_tree_[eytzinger_index(search_tree_, i)]}}
+                : sys_seconds(sys_days(year::max()/max_day));
+    r.offset = seconds{offsets_[i-1]};
+    r.save = is_dst_[i-1] ? minutes{1} : minutes{0};
+    set_abbrev(r, *ttinfos_[abbrev_indices_[i-1]].abbrev);
+    return r;
 }
 
-local_info
-time_zone::get_info_impl(local_seconds tp) const
+template <class SysInfo>
+SysInfo
+time_zone::get_sys_info(sys_seconds tp) const
+{
+    using namespace std;
+#if TZ_ZONE_BUDGET
+    auto pin = detail::residency_list::instance().pin(*this);
+#endif
+    init();
+    if (posix_ == nullptr || tp < transitions_.back().timepoint)
+    {
+        auto i = eytzinger_upper_bound(search_tree_, tp.time_since_epoch().count());
+        return load_sys_info<SysInfo>(min(i, offsets_.size()));
+    }
+    // From the last transition of the file on its rule gives the offsets.
+    auto const& rule = posix_transitions(*posix_, transitions_,
+                                         year_month_day{floor<days>(tp)}.year());
+    auto first = rule.data();
+    auto last = first + rule.size();
+    auto tr = upper_bound(first, last, tp, [](const sys_seconds& x, const transition& t)
+                                           {
+                                               return x < t.timepoint;
+                                           });
+    return load_sys_info<SysInfo>(tr, last);
+}
+
+template <class LocalInfo>
+LocalInfo
+time_zone::get_local_info(local_seconds tp) const
 {
     using namespace std::chrono;
+    using SysInfo = decltype(LocalInfo::first);
+#if TZ_ZONE_BUDGET
+    auto pin = detail::residency_list::instance().pin(*this);
+#endif
     init();
-    local_info i;
-    i.result = local_info::unique;
-    auto tr = upper_bound(transitions_.begin(), transitions_.end(), tp,
-                          [](const local_seconds& x, const transition& t)
-                          {
-                              return sys_seconds{x.time_since_epoch()} -
-                                                         t.info->offset < t.timepoint;
-                          });
-    i.first = load_sys_info(tr);
+    LocalInfo i;
+    i.result = LocalInfo::unique;
+    auto later = [](const local_seconds& x, const transition& t)
+                 {
+                     return sys_seconds{x.time_since_epoch()} -
+                                                t.info->offset < t.timepoint;
+                 };
+    auto first = transitions_.data();
+    auto last = first + transitions_.size();
+    auto tr = upper_bound(first, last, tp, later);
+    if (last - tr <= 1 && posix_ != nullptr)
+    {
+        // From the last transition of the file on, or its neighbours, its rule applies.
+        auto const& rule = posix_transitions(*posix_, transitions_,
+                                             year_month_day{floor<days>(tp)}.year());
+        first = rule.data();
+        last = first + rule.size();
+        tr = upper_bound(first, last, tp, later);
+    }
+    i.first = load_sys_info<SysInfo>(tr, last);
     auto tps = sys_seconds{(tp - i.first.offset).time_since_epoch()};
-    if (tps < i.first.begin + days{1} && tr != transitions_.begin())
+    if (tps < i.first.begin + days{1} && tr - first > 1)
     {
-        i.second = load_sys_info(--tr);
+        i.second = load_sys_info<SysInfo>(--tr, last);
         tps = sys_seconds{(tp - i.second.offset).time_since_epoch()};
         if (tps < i.second.end)
         {
-           i.result = local_info::ambiguous;
+           i.result = LocalInfo::ambiguous;
            std::swap(i.first, i.second);
         }
         else
@@ -2172,12 +3011,12 @@ time_zone::get_info_impl(local_seconds tp) const
             i.second = {};
         }
     }
-    else if (tps >= i.first.end && tr != transitions_.end())
+    else if (tps >= i.first.end && tr != last)
     {
-        i.second = load_sys_info(++tr);
+        i.second = load_sys_info<SysInfo>(++tr, last);
         tps = sys_seconds{(tp - i.second.offset).time_since_epoch()};
         if (tps < i.second.begin)
-            i.result = local_info::nonexistent;
+            i.result = LocalInfo::nonexistent;
         else
             i.second = {};
     }
@@ -2188,6 +3027,9 @@ std::ostream&
 operator<<(std::ostream& os, const time_zone& z)
 {
     using namespace std::chrono;
+#if TZ_ZONE_BUDGET
+    auto pin = detail::residency_list::instance().pin(z);
+#endif
     z.init();
     os << z.name_ << '\n';
     os << "Initially:           ";
@@ -2199,7 +3041,7 @@ operator<<(std::ostream& os, const time_zone& z)
         os << " daylight ";
     else
         os << " standard ";
-    os << t.info->abbrev << '\n';
+    os << *t.info->abbrev << '\n';
     for (auto i = std::next(z.transitions_.cbegin()); i < z.transitions_.cend(); ++i)
         os << *i << '\n';
     return os;
@@ -2216,8 +3058,21 @@ leap_second::leap_second(const sys_seconds& s, detail::undocumented)
 
 #else  // !USE_OS_TZDB
 
+#if TZ_ARENA
+
+time_zone::time_zone(const std::string& s, detail::undocumented)
+    : time_zone(s, std::pmr::get_default_resource(), detail::undocumented{})
+{
+}
+
+time_zone::time_zone(const std::string& s, std::pmr::memory_resource* arena,
+                     detail::undocumented)
+    : table_(arena)
+    , adjusted_(make_tz_unique<std::once_flag>(table_.get_allocator()))
+#else  // !TZ_ARENA
 time_zone::time_zone(const std::string& s, detail::undocumented)
     : adjusted_(new std::once_flag{})
+#endif  // !TZ_ARENA
 {
     try
     {
@@ -2237,37 +3092,67 @@ time_zone::time_zone(const std::string& s, detail::undocumented)
     }
 }
 
-sys_info
-time_zone::get_info_impl(sys_seconds tp) const
+template <class SysInfo>
+SysInfo
+time_zone::get_sys_info(sys_seconds tp) const
 {
-    return get_info_impl(tp, static_cast<int>(tz::utc));
+    return get_sys_info<SysInfo>(tp, static_cast<int>(tz::utc));
 }
 
-local_info
-time_zone::get_info_impl(local_seconds tp) const
+template <class LocalInfo>
+LocalInfo
+time_zone::get_local_info(local_seconds tp) const
+{
+    return get_local_info<LocalInfo>(tp, true);
+}
+
+template <class LocalInfo>
+LocalInfo
+time_zone::get_local_info(local_seconds tp, bool table) const
 {
     using namespace std::chrono;
-    local_info i{};
-    i.first = get_info_impl(sys_seconds{tp.time_since_epoch()}, static_cast<int>(tz::local));
+    using SysInfo = decltype(LocalInfo::first);
+    init();
+    // Two days keep the neighbours of the period of tp inside the table for any offset.
+    if (table && !table_.empty() &&
+        tp - days{2} >= local_seconds{table_.front().end.time_since_epoch()} &&
+        tp + days{2} < local_seconds{table_.back().begin.time_since_epoch()})
+        return get_table_info<LocalInfo>(tp);
+    LocalInfo i{};
+    i.first = get_sys_info<SysInfo>(sys_seconds{tp.time_since_epoch()}, static_cast<int>(tz::local),
+                                    table);
     auto tps = sys_seconds{(tp - i.first.offset).time_since_epoch()};
     if (tps < i.first.begin)
     {
         i.second = std::move(i.first);
-        i.first = get_info_impl(i.second.begin - seconds{1}, static_cast<int>(tz::utc));
-        i.result = local_info::nonexistent;
+        i.first = get_sys_info<SysInfo>(i.second.begin - seconds{1}, static_cast<int>(tz::utc),
+                                        table);
+        i.result = LocalInfo::nonexistent;
     }
     else if (i.first.end - tps <= days{1})
     {
-        i.second = get_info_impl(i.first.end, static_cast<int>(tz::utc));
+        i.second = get_sys_info<SysInfo>(i.first.end, static_cast<int>(tz::utc), table);
         tps = sys_seconds{(tp - i.second.offset).time_since_epoch()};
         if (tps >= i.second.begin)
-            i.result = local_info::ambiguous;
+            i.result = LocalInfo::ambiguous;
         else
             i.second = {};
     }
     return i;
 }
 
+sys_info
+time_zone::get_rule_info(sys_seconds tp, detail::undocumented) const
+{
+    return get_sys_info<sys_info>(tp, static_cast<int>(tz::utc), false);
+}
+
+local_info
+time_zone::get_rule_info(local_seconds tp, detail::undocumented) const
+{
+    return get_local_info<local_info>(tp, false);
+}
+
 void
 time_zone::add(const std::string& s)
 {
@@ -2491,8 +3376,128 @@ format_abbrev(std::string format, const std::string& variable, std::chrono::seco
     return format;
 }
 
-sys_info
-time_zone::get_info_impl(sys_seconds tp, int tz_int) const
+void
+time_zone::init() const
+{
+    std::call_once(*adjusted_,
+                   [this]()
+                   {
+                       detail::stat_timer timer(detail::stat_id::zone_loads, detail::stat_id::zone_load_ns);
+                       detail::trace_scope trace("load_zone", name_.c_str());
+                       {
+                           detail::trace_scope adjust("adjust_zone", name_.c_str());
+                           const_cast<time_zone*>(this)->adjust_infos(get_tzdb().rules);
+                       }
+                       detail::trace_scope table("build_table", name_.c_str());
+                       const_cast<time_zone*>(this)->build_table();
+                   });
+}
+
+void
+time_zone::build_table()
+{
+    using namespace std::chrono;
+    using namespace date;
+    if (table_first_year > table_last_year)
+        return;
+    assert(abbrevs_ != nullptr);
+    auto t = sys_seconds{sys_days(table_first_year/January/1)};
+    auto end = sys_seconds{sys_days((table_last_year + years{1})/January/1)};
+    std::vector<detail::table_entry> table;
+    while (t < end)
+    {
+        auto r = get_rule_info(t, static_cast<int>(tz::utc));
+        if (!(r.begin <= t && t < r.end))
+        {
+            // Not a contiguous run of periods, leave every query to the rule engine.
+            return;
+        }
+        t = r.end;
+        table.push_back({r.begin, r.end, r.offset, r.save, &abbrevs_->intern(r.abbrev)});
+    }
+    table.shrink_to_fit();
+    move_into(table_, std::move(table));
+}
+
+// The rule engine formats a new abbreviation for each info, a sys_info takes it over
+// and a sys_info_view refers to its interned copy.
+static
+inline
+void
+adopt_rule_info(sys_info& r, sys_info&& info, detail::abbrev_pool&)
+{
+    r = std::move(info);
+}
+
+#if HAS_STRING_VIEW
+
+static
+inline
+void
+adopt_rule_info(sys_info_view& r, sys_info&& info, detail::abbrev_pool& abbrevs)
+{
+    r.begin = info.begin;
+    r.end = info.end;
+    r.offset = info.offset;
+    r.save = info.save;
+    r.abbrev = abbrevs.intern(info.abbrev);
+}
+
+#endif  // HAS_STRING_VIEW
+
+template <class SysInfo>
+SysInfo
+time_zone::load_sys_info(const detail::table_entry& e) const
+{
+    SysInfo r;
+    r.begin = e.begin;
+    r.end = e.end;
+    r.offset = e.offset;
+    r.save = e.save;
+    set_abbrev(r, *e.abbrev);
+    return r;
+}
+
+template <class LocalInfo>
+LocalInfo
+time_zone::get_table_info(local_seconds tp) const
+{
+    using namespace std::chrono;
+    using SysInfo = decltype(LocalInfo::first);
+    LocalInfo i{};
+    auto tr = std::upper_bound(table_.begin(), table_.end(), tp,
+                               [](const local_seconds& x, const table_entry& e)
+                               {
+                                   return sys_seconds{x.time_since_epoch()} - e.offset < e.begin;
+                               });
+    --tr;
+    i.first = load_sys_info<SysInfo>(*tr);
+    auto tps = sys_seconds{(tp - i.first.offset).time_since_epoch()};
+    if (tps < i.first.begin + days{1})
+    {
+        auto prev = tr - 1;
+        if (sys_seconds{(tp - prev->offset).time_since_epoch()} < prev->end)
+        {
+            i.result = LocalInfo::ambiguous;
+            i.second = std::move(i.first);
+            i.first = load_sys_info<SysInfo>(*prev);
+        }
+    }
+    else if (tps >= i.first.end)
+    {
+        auto next = tr + 1;
+        if (sys_seconds{(tp - next->offset).time_since_epoch()} < next->begin)
+        {
+            i.result = LocalInfo::nonexistent;
+            i.second = load_sys_info<SysInfo>(*next);
+        }
+    }
+    return i;
+}
+
+template <class SysInfo>
+SysInfo
+time_zone::get_sys_info(sys_seconds tp, int tz_int, bool table) const
 {
     using namespace std::chrono;
     using namespace date;
@@ -2503,11 +3508,28 @@ time_zone::get_info_impl(sys_seconds tp, int tz_int) const
         throw std::runtime_error("The year " + std::to_string(static_cast<int>(y)) +
             " is out of range:[" + std::to_string(static_cast<int>(min_year)) + ", "
                                  + std::to_string(static_cast<int>(max_year)) + "]");
-    std::call_once(*adjusted_,
-                   [this]()
-                   {
-                       const_cast<time_zone*>(this)->adjust_infos(get_tzdb().rules);
-                   });
+    init();
+    if (table && timezone == tz::utc && !table_.empty() && table_.front().begin <= tp &&
+                                                            tp < table_.back().end)
+    {
+        return load_sys_info<SysInfo>(*--std::upper_bound(table_.begin(), table_.end(), tp,
+                                          [](const sys_seconds& x, const table_entry& e)
+                                          {
+                                              return x < e.begin;
+                                          }));
+    }
+    SysInfo r;
+    adopt_rule_info(r, get_rule_info(tp, tz_int), *abbrevs_);
+    return r;
+}
+
+sys_info
+time_zone::get_rule_info(sys_seconds tp, int tz_int) const
+{
+    using namespace std::chrono;
+    using namespace date;
+    tz timezone = static_cast<tz>(tz_int);
+    auto y = year_month_day(floor<days>(tp)).year();
     auto i = std::upper_bound(zonelets_.begin(), zonelets_.end(), tp,
         [timezone](sys_seconds t, const zonelet& zl)
         {
@@ -2562,11 +3584,7 @@ operator<<(std::ostream& os, const time_zone& z)
     detail::save_ostream<char> _(os);
     os.fill(' ');
     os.flags(std::ios::dec | std::ios::left);
-    std::call_once(*z.adjusted_,
-                   [&z]()
-                   {
-                       const_cast<time_zone&>(z).adjust_infos(get_tzdb().rules);
-                   });
+    z.init();
     os.width(35);
     os << z.name_;
     std::string indent;
@@ -2643,6 +3661,8 @@ static
 std::unique_ptr<tzdb>
 init_tzdb()
 {
+    detail::stat_timer timer(detail::stat_id::tzdb_loads, detail::stat_id::tzdb_load_ns);
+    detail::trace_scope trace("init_tzdb", get_tz_dir().c_str());
     std::unique_ptr<tzdb> db(new tzdb);
 
     //Iterate through folders
@@ -2684,8 +3704,13 @@ init_tzdb()
                 }
                 else
                 {
+#  if TZ_ARENA
+                    db->zones.emplace_back(subname.substr(get_tz_dir().size()+1),
+                                           db->arena.get(), detail::undocumented{});
+#  else
                     db->zones.emplace_back(subname.substr(get_tz_dir().size()+1),
                                            detail::undocumented{});
+#  endif
                 }
             }
         }
@@ -2693,7 +3718,10 @@ init_tzdb()
     }
     db->zones.shrink_to_fit();
     std::sort(db->zones.begin(), db->zones.end());
+    for (auto& z : db->zones)
+        z.set_abbrev_pool(db->abbrevs.get(), detail::undocumented{});
 #  if !MISSING_LEAP_SECONDS
+    detail::trace_scope leaps("load_leap_seconds");
     std::ifstream in(get_tz_dir() + std::string(1, folder_delimiter) + "right/UTC",
                      std::ios_base::binary);
     if (in)
@@ -2711,6 +3739,8 @@ init_tzdb()
         in.exceptions(std::ios::failbit | std::ios::badbit);
         db->leap_seconds = load_just_leaps(in);
     }
+    leaps.add_bytes(static_cast<std::uintmax_t>(in.tellg()));
+    trace.add_bytes(static_cast<std::uintmax_t>(in.tellg()));
 #  endif  // !MISSING_LEAP_SECONDS
 #  ifdef __APPLE__
     db->version = get_version();
@@ -3360,8 +4390,10 @@ static
 std::unique_ptr<tzdb>
 init_tzdb()
 {
+    detail::stat_timer timer(detail::stat_id::tzdb_loads, detail::stat_id::tzdb_load_ns);
     using namespace date;
     const std::string install = get_install();
+    detail::trace_scope trace("init_tzdb", install.c_str());
     const std::string path = install + folder_delimiter;
     std::string line;
     bool continue_zone = false;
@@ -3424,10 +4456,16 @@ init_tzdb()
 
     for (const auto& filename : files)
     {
+        detail::trace_scope file(std::strcmp(filename, "leapseconds") == 0 ? "load_leap_seconds"
+                                                                            : "parse_file",
+                                 filename);
         std::ifstream infile(path + filename);
         while (infile)
         {
             std::getline(infile, line);
+            auto bytes = line.size() + (infile.eof() ? 0 : 1);
+            file.add_bytes(bytes);
+            trace.add_bytes(bytes);
             if (!line.empty() && line[0] != '#')
             {
                 std::istringstream in(line);
@@ -3450,7 +4488,12 @@ init_tzdb()
                 }
                 else if (word == "Zone")
                 {
+#  if TZ_ARENA
+                    db->zones.push_back(time_zone(line, db->arena.get(),
+                                                  detail::undocumented{}));
+#  else
                     db->zones.push_back(time_zone(line, detail::undocumented{}));
+#  endif
                     continue_zone = true;
                 }
                 else if (line[0] == '\t' && continue_zone)
@@ -3468,6 +4511,8 @@ init_tzdb()
     Rule::split_overlaps(db->rules);
     std::sort(db->zones.begin(), db->zones.end());
     db->zones.shrink_to_fit();
+    for (auto& z : db->zones)
+        z.set_abbrev_pool(db->abbrevs.get(), detail::undocumented{});
     std::sort(db->links.begin(), db->links.end());
     db->links.shrink_to_fit();
     std::sort(db->leap_seconds.begin(), db->leap_seconds.end());
@@ -3482,9 +4527,12 @@ init_tzdb()
     return db;
 }
 
+#endif  // !USE_OS_TZDB
+
 const tzdb&
 reload_tzdb()
 {
+    detail::trace_scope trace("reload_tzdb");
 #if AUTO_DOWNLOAD
     auto const& v = get_tzdb_list().front().version;
     if (!v.empty() && v == remote_version())
@@ -3494,8 +4542,6 @@ reload_tzdb()
     return get_tzdb_list().front();
 }
 
-#endif  // !USE_OS_TZDB
-
 const tzdb&
 get_tzdb()
 {
@@ -3538,11 +4584,17 @@ tzdb::locate_zone(const std::string& tz_name) const
                     return z.name() < nm;
                 });
             if (zi != zones.end() && zi->name() == li->target())
+            {
+                detail::add_stat(detail::stat_id::locate_zone_hits);
                 return &*zi;
+            }
         }
 #endif  // !USE_OS_TZDB
+        detail::add_stat(detail::stat_id::locate_zone_misses);
+        detail::add_stat(detail::stat_id::exceptions);
         throw std::runtime_error(std::string(tz_name) + " not found in timezone database");
     }
+    detail::add_stat(detail::stat_id::locate_zone_hits);
     return &*zi;
 }
 
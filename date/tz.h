@@ -82,6 +82,23 @@ static_assert(HAS_REMOTE_API == 0 ? AUTO_DOWNLOAD == 0 : true,
 #  define USE_SHELL_API 1
 #endif
 
+#ifndef TZ_STATS
+#  define TZ_STATS 0
+#endif
+
+#ifndef TZ_ARENA
+#  define TZ_ARENA 0
+#endif
+
+#ifndef TZ_ZONE_BUDGET
+#  define TZ_ZONE_BUDGET 0
+#endif
+
+static_assert(!TZ_ZONE_BUDGET || USE_OS_TZDB,
+              "TZ_ZONE_BUDGET requires USE_OS_TZDB");
+static_assert(!(TZ_ZONE_BUDGET && TZ_ARENA),
+              "TZ_ZONE_BUDGET and TZ_ARENA can not be used together");
+
 #if USE_OS_TZDB
 #  ifdef _WIN32
 #    error "USE_OS_TZDB can not be used on Windows"
@@ -115,11 +132,16 @@ static_assert(HAS_REMOTE_API == 0 ? AUTO_DOWNLOAD == 0 : true,
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
 #include <istream>
 #include <locale>
 #include <memory>
+#if TZ_ARENA
+#  include <memory_resource>
+#endif
 #include <mutex>
 #include <ostream>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -207,6 +229,28 @@ operator<<(std::basic_ostream<CharT, Traits>& os, const local_info& r)
     return os;
 }
 
+#if HAS_STRING_VIEW
+
+// sys_info without a string of its own, abbrev refers to the abbreviation interned by
+// the tzdb of the time_zone and stays valid as long as that tzdb.
+struct sys_info_view
+{
+    sys_seconds          begin;
+    sys_seconds          end;
+    std::chrono::seconds offset;
+    std::chrono::minutes save;
+    std::string_view     abbrev;
+};
+
+struct local_info_view
+{
+    enum {unique, nonexistent, ambiguous} result;
+    sys_info_view first;
+    sys_info_view second;
+};
+
+#endif  // HAS_STRING_VIEW
+
 class nonexistent_local_time
     : public std::runtime_error
 {
@@ -771,25 +815,264 @@ namespace detail
 #  if USE_OS_TZDB
     struct transition;
     struct expanded_ttinfo;
+    struct posix_rule;
+#    if TZ_ZONE_BUDGET
+    struct zone_residency;
+    class residency_list;
+#    endif
 #  else  // !USE_OS_TZDB
     struct zonelet;
+    struct table_entry;
     class Rule;
 #  endif  // !USE_OS_TZDB
 }
 
 #endif  // !defined(_MSC_VER) || (_MSC_VER >= 1900)
 
+namespace detail
+{
+
+// Events counted when TZ_STATS is on, timers count nanoseconds.
+enum class stat_id : unsigned
+{
+    tzdb_loads,
+    tzdb_load_ns,
+    zone_loads,
+    zone_load_ns,
+    locate_zone_hits,
+    locate_zone_misses,
+    sys_info_calls,
+    local_info_calls,
+    exceptions,
+    parse_calls,
+    parse_bytes,
+    format_calls,
+    format_bytes,
+    count
+};
+
+#if TZ_STATS
+
+// Adds n to the counter s of the calling thread, a relaxed store no other thread writes.
+DATE_API void add_stat(stat_id s, std::uint64_t n = 1) NOEXCEPT;
+
+// The sums over all threads, including those that have exited.
+DATE_API void read_stats(std::uint64_t (&values)[static_cast<unsigned>(stat_id::count)]);
+
+// Counts one event and the nanoseconds until it is destroyed.
+class stat_timer
+{
+    stat_id                               event_;
+    stat_id                               ns_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    stat_timer(stat_id event, stat_id ns)
+        : event_(event)
+        , ns_(ns)
+        , start_(std::chrono::steady_clock::now())
+        {}
+
+    ~stat_timer()
+    {
+        add_stat(event_);
+        add_stat(ns_, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_).count()));
+    }
+
+    stat_timer(const stat_timer&) = delete;
+    stat_timer& operator=(const stat_timer&) = delete;
+};
+
+#else  // !TZ_STATS
+
+// Empty and usable in constant expressions, so that calls compile to nothing.
+CONSTCD14 inline void add_stat(stat_id, std::uint64_t = 1) NOEXCEPT {}
+
+class stat_timer
+{
+public:
+    CONSTCD11 stat_timer(stat_id, stat_id) NOEXCEPT {}
+};
+
+#endif  // !TZ_STATS
+
+#if TZ_ARENA
+
+// The memory of a tzdb.  The tables of its zones, their abbreviations and the other
+// pieces a zone owns are carved out of a few large blocks, which are freed at once
+// with the tzdb instead of piece by piece.  Zones of the OS database are read on
+// first use from any thread, hence the lock.
+class tzdb_arena
+    : public std::pmr::memory_resource
+{
+    std::mutex                          mutex_;
+    std::pmr::monotonic_buffer_resource blocks_{64*1024};
+    std::size_t                         bytes_ = 0;
+
+public:
+    // Bytes handed out so far, what the tzdb uses of the blocks.
+    std::size_t
+    bytes()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return bytes_;
+    }
+
+private:
+    void*
+    do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bytes_ += bytes;
+        return blocks_.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool
+    do_is_equal(const std::pmr::memory_resource& other) const NOEXCEPT override
+    {
+        return this == &other;
+    }
+};
+
+// Destroys an object allocated from resource, and gives its memory back, which an
+// arena ignores.
+struct arena_delete
+{
+    std::pmr::memory_resource* resource = nullptr;
+
+    template <class T>
+    void
+    operator()(T* p) const NOEXCEPT
+    {
+        p->~T();
+        resource->deallocate(p, sizeof(T), alignof(T));
+    }
+};
+
+template <class T> using tz_vector = std::pmr::vector<T>;
+template <class T> using tz_unique_ptr = std::unique_ptr<T, arena_delete>;
+using tz_string = std::pmr::string;
+
+#else  // !TZ_ARENA
+
+template <class T> using tz_vector = std::vector<T>;
+template <class T> using tz_unique_ptr = std::unique_ptr<T>;
+using tz_string = std::string;
+
+#endif  // !TZ_ARENA
+
+// The abbreviations of the zones of a tzdb, each stored once so that infos can refer
+// to them for as long as the tzdb exists.  Interned strings are also published in a
+// fixed open addressing table that only ever gains entries, so interning a string
+// that is already there takes no lock.
+class abbrev_pool
+{
+#if TZ_ARENA
+    struct less
+    {
+        using is_transparent = void;
+
+        bool
+        operator()(std::string_view x, std::string_view y) const NOEXCEPT
+        {
+            return x < y;
+        }
+    };
+
+    std::pmr::set<tz_string, less>   abbrevs_;
+#else  // !TZ_ARENA
+    std::set<std::string>            abbrevs_;
+#endif  // !TZ_ARENA
+    std::mutex                       mutex_;
+
+    static const std::size_t slots = 1024;  // a tzdb has a few hundred abbreviations
+    static const std::size_t probes = 16;   // past that an abbreviation is not published
+    std::atomic<const tz_string*>    published_[slots] = {};
+
+    static
+    std::size_t
+    hash(const std::string& s) NOEXCEPT
+    {
+        std::size_t h = 2166136261u;
+        for (auto c : s)
+            h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+        return h;
+    }
+
+public:
+#if TZ_ARENA
+    explicit abbrev_pool(std::pmr::memory_resource* arena)
+        : abbrevs_(arena)
+        {}
+#endif
+
+    const tz_string&
+    intern(const std::string& abbrev)
+    {
+        auto h = hash(abbrev);
+        for (std::size_t i = 0; i < probes; ++i)
+        {
+            auto p = published_[(h + i) % slots].load(std::memory_order_acquire);
+            if (p == nullptr)
+                break;
+            if (abbrev.compare(0, abbrev.npos, p->data(), p->size()) == 0)
+                return *p;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+#if TZ_ARENA
+        auto j = abbrevs_.find(abbrev);
+        if (j == abbrevs_.end())
+            j = abbrevs_.emplace(abbrev.data(), abbrev.size()).first;
+#else
+        auto j = abbrevs_.insert(abbrev).first;
+#endif
+        const tz_string& r = *j;
+        for (std::size_t i = 0; i < probes; ++i)
+        {
+            auto& slot = published_[(h + i) % slots];
+            auto p = slot.load(std::memory_order_relaxed);
+            if (p == &r)
+                break;
+            if (p == nullptr)
+            {
+                slot.store(&r, std::memory_order_release);
+                break;
+            }
+        }
+        return r;
+    }
+};
+
+}  // namespace detail
+
 class time_zone
 {
 private:
-    std::string                          name_;
+    std::string                              name_;
 #if USE_OS_TZDB
-    std::vector<detail::transition>      transitions_;
-    std::vector<detail::expanded_ttinfo> ttinfos_;
+    detail::tz_vector<detail::transition>      transitions_;
+    detail::tz_vector<detail::expanded_ttinfo> ttinfos_;
+    detail::tz_unique_ptr<detail::posix_rule>  posix_;  // after the last transition, may be null
+    // The search index of transitions_: their timepoints in Eytzinger order, a complete
+    // tree from index 1 padded with the largest time, and in parallel to transitions_
+    // the offset, DST flag and abbreviation, as an index into ttinfos_, of each.
+    detail::tz_vector<std::int64_t>            search_tree_;
+    detail::tz_vector<std::int32_t>            offsets_;
+    detail::tz_vector<std::uint8_t>            is_dst_;
+    detail::tz_vector<std::uint8_t>            abbrev_indices_;
+#  if TZ_ZONE_BUDGET
+    std::unique_ptr<detail::zone_residency>    residency_;
+#  endif
 #else  // !USE_OS_TZDB
-    std::vector<detail::zonelet>         zonelets_;
+    std::vector<detail::zonelet>               zonelets_;  // not assignable, stays on the heap
+    detail::tz_vector<detail::table_entry>     table_;
 #endif  // !USE_OS_TZDB
-    std::unique_ptr<std::once_flag>      adjusted_;
+    detail::tz_unique_ptr<std::once_flag>      adjusted_;
+    detail::abbrev_pool*                       abbrevs_ = nullptr;
 
 public:
 #if !defined(_MSC_VER) || (_MSC_VER >= 1900)
@@ -801,12 +1084,25 @@ public:
 #endif  // defined(_MSC_VER) && (_MSC_VER < 1900)
 
     DATE_API explicit time_zone(const std::string& s, detail::undocumented);
+#if TZ_ZONE_BUDGET
+    DATE_API ~time_zone();
+#endif
+#if TZ_ARENA
+    // Keeps what the zone owns in arena, which has to outlive it.
+    DATE_API time_zone(const std::string& s, std::pmr::memory_resource* arena,
+                       detail::undocumented);
+#endif
 
     const std::string& name() const NOEXCEPT;
 
     template <class Duration> sys_info   get_info(sys_time<Duration> st) const;
     template <class Duration> local_info get_info(local_time<Duration> tp) const;
 
+#if HAS_STRING_VIEW
+    template <class Duration> sys_info_view   get_info_view(sys_time<Duration> st) const;
+    template <class Duration> local_info_view get_info_view(local_time<Duration> tp) const;
+#endif
+
     template <class Duration>
         sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
         to_sys(local_time<Duration> tp) const;
@@ -825,11 +1121,24 @@ public:
 
 #if !USE_OS_TZDB
     DATE_API void add(const std::string& s);
+
+    // The answers of the rules alone, without the transition table, to check it against.
+    DATE_API sys_info   get_rule_info(sys_seconds tp, detail::undocumented) const;
+    DATE_API local_info get_rule_info(local_seconds tp, detail::undocumented) const;
 #endif  // !USE_OS_TZDB
 
+    void set_abbrev_pool(detail::abbrev_pool* abbrevs, detail::undocumented) NOEXCEPT;
+
 private:
     DATE_API sys_info   get_info_impl(sys_seconds tp) const;
     DATE_API local_info get_info_impl(local_seconds tp) const;
+#if HAS_STRING_VIEW
+    DATE_API sys_info_view   get_info_view_impl(sys_seconds tp) const;
+    DATE_API local_info_view get_info_view_impl(local_seconds tp) const;
+#endif
+
+    template <class SysInfo> SysInfo get_sys_info(sys_seconds tp) const;
+    template <class LocalInfo> LocalInfo get_local_info(local_seconds tp) const;
 
     template <class Duration>
         sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
@@ -841,16 +1150,32 @@ private:
 #if USE_OS_TZDB
     DATE_API void init() const;
     DATE_API void init_impl();
-    DATE_API sys_info
-        load_sys_info(std::vector<detail::transition>::const_iterator i) const;
+    template <class SysInfo>
+        SysInfo load_sys_info(const detail::transition* i,
+                              const detail::transition* last) const;
+    template <class SysInfo> SysInfo load_sys_info(std::size_t i) const;
+    DATE_API void build_search_index();
+#  if TZ_ZONE_BUDGET
+    DATE_API std::size_t table_bytes() const NOEXCEPT;
+    DATE_API void drop_tables();
+
+    friend class detail::residency_list;
+#  endif
 
     template <class TimeType>
     DATE_API void
     load_data(std::istream& inf, std::int32_t tzh_leapcnt, std::int32_t tzh_timecnt,
                                  std::int32_t tzh_typecnt, std::int32_t tzh_charcnt);
 #else  // !USE_OS_TZDB
-    DATE_API sys_info   get_info_impl(sys_seconds tp, int timezone) const;
+    DATE_API void init() const;
+    DATE_API sys_info   get_rule_info(sys_seconds tp, int timezone) const;
+    template <class SysInfo> SysInfo get_sys_info(sys_seconds tp, int timezone,
+                                                  bool table = true) const;
+    template <class LocalInfo> LocalInfo get_local_info(local_seconds tp, bool table) const;
+    template <class SysInfo> SysInfo load_sys_info(const detail::table_entry& e) const;
+    template <class LocalInfo> LocalInfo get_table_info(local_seconds tp) const;
     DATE_API void adjust_infos(const std::vector<detail::Rule>& rules);
+    DATE_API void build_table();
     DATE_API void parse_info(std::istream& in);
 #endif  // !USE_OS_TZDB
 };
@@ -861,7 +1186,9 @@ inline
 time_zone::time_zone(time_zone&& src)
     : name_(std::move(src.name_))
     , zonelets_(std::move(src.zonelets_))
+    , table_(std::move(src.table_))
     , adjusted_(std::move(src.adjusted_))
+    , abbrevs_(src.abbrevs_)
     {}
 
 inline
@@ -870,7 +1197,9 @@ time_zone::operator=(time_zone&& src)
 {
     name_ = std::move(src.name_);
     zonelets_ = std::move(src.zonelets_);
+    table_ = std::move(src.table_);
     adjusted_ = std::move(src.adjusted_);
+    abbrevs_ = src.abbrevs_;
     return *this;
 }
 
@@ -899,6 +1228,33 @@ time_zone::get_info(local_time<Duration> tp) const
     return get_info_impl(date::floor<std::chrono::seconds>(tp));
 }
 
+#if HAS_STRING_VIEW
+
+template <class Duration>
+inline
+sys_info_view
+time_zone::get_info_view(sys_time<Duration> st) const
+{
+    return get_info_view_impl(date::floor<std::chrono::seconds>(st));
+}
+
+template <class Duration>
+inline
+local_info_view
+time_zone::get_info_view(local_time<Duration> tp) const
+{
+    return get_info_view_impl(date::floor<std::chrono::seconds>(tp));
+}
+
+#endif  // HAS_STRING_VIEW
+
+inline
+void
+time_zone::set_abbrev_pool(detail::abbrev_pool* abbrevs, detail::undocumented) NOEXCEPT
+{
+    abbrevs_ = abbrevs;
+}
+
 template <class Duration>
 inline
 sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
@@ -921,7 +1277,11 @@ local_time<typename std::common_type<Duration, std::chrono::seconds>::type>
 time_zone::to_local(sys_time<Duration> tp) const
 {
     using LT = local_time<typename std::common_type<Duration, std::chrono::seconds>::type>;
+#if HAS_STRING_VIEW
+    auto i = get_info_view(tp);
+#else
     auto i = get_info(tp);
+#endif
     return LT{(tp + i.offset).time_since_epoch()};
 }
 
@@ -937,12 +1297,18 @@ template <class Duration>
 sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
 time_zone::to_sys_impl(local_time<Duration> tp, choose z, std::false_type) const
 {
+#if HAS_STRING_VIEW
+    using info = local_info_view;
+    auto i = get_info_view(tp);
+#else
+    using info = local_info;
     auto i = get_info(tp);
-    if (i.result == local_info::nonexistent)
+#endif
+    if (i.result == info::nonexistent)
     {
         return i.first.end;
     }
-    else if (i.result == local_info::ambiguous)
+    else if (i.result == info::ambiguous)
     {
         if (z == choose::latest)
             return sys_time<Duration>{tp.time_since_epoch()} - i.second.offset;
@@ -954,11 +1320,24 @@ template <class Duration>
 sys_time<typename std::common_type<Duration, std::chrono::seconds>::type>
 time_zone::to_sys_impl(local_time<Duration> tp, choose, std::true_type) const
 {
+    // Only the exception messages need the abbreviations as strings
+#if HAS_STRING_VIEW
+    using info = local_info_view;
+    auto i = get_info_view(tp);
+#else
+    using info = local_info;
     auto i = get_info(tp);
-    if (i.result == local_info::nonexistent)
-        throw nonexistent_local_time(tp, i);
-    else if (i.result == local_info::ambiguous)
-        throw ambiguous_local_time(tp, i);
+#endif
+    if (i.result == info::nonexistent)
+    {
+        detail::add_stat(detail::stat_id::exceptions);
+        throw nonexistent_local_time(tp, get_info(tp));
+    }
+    else if (i.result == info::ambiguous)
+    {
+        detail::add_stat(detail::stat_id::exceptions);
+        throw ambiguous_local_time(tp, get_info(tp));
+    }
     return sys_time<Duration>{tp.time_since_epoch()} - i.first.offset;
 }
 
@@ -1157,6 +1536,10 @@ struct timezone_mapping
 
 struct tzdb
 {
+#if TZ_ARENA
+    // First, so that it outlives everything that lives in it.
+    std::unique_ptr<detail::tzdb_arena> arena{new detail::tzdb_arena};
+#endif
     std::string                 version = "unknown";
     std::vector<time_zone>      zones;
 #if !USE_OS_TZDB
@@ -1170,13 +1553,23 @@ struct tzdb
 #endif
 #ifdef _WIN32
     std::vector<detail::timezone_mapping> mappings;
+#endif
+#if TZ_ARENA
+    std::unique_ptr<detail::abbrev_pool> abbrevs{new detail::abbrev_pool(arena.get())};
+#else
+    std::unique_ptr<detail::abbrev_pool> abbrevs{new detail::abbrev_pool};
 #endif
     tzdb* next = nullptr;
 
     tzdb() = default;
 #if !defined(_MSC_VER) || (_MSC_VER >= 1900)
     tzdb(tzdb&&) = default;
+#  if TZ_ARENA
+    // The old arena would go before the zones that live in it.
+    tzdb& operator=(tzdb&&) = delete;
+#  else
     tzdb& operator=(tzdb&&) = default;
+#  endif
 #else  // defined(_MSC_VER) && (_MSC_VER < 1900)
     tzdb(tzdb&& src)
         : version(std::move(src.version))
@@ -1185,6 +1578,7 @@ struct tzdb
         , leap_seconds(std::move(src.leap_seconds))
         , rules(std::move(src.rules))
         , mappings(std::move(src.mappings))
+        , abbrevs(std::move(src.abbrevs))
     {}
 
     tzdb& operator=(tzdb&& src)
@@ -1195,6 +1589,7 @@ struct tzdb
         leap_seconds = std::move(src.leap_seconds);
         rules = std::move(src.rules);
         mappings = std::move(src.mappings);
+        abbrevs = std::move(src.abbrevs);
         return *this;
     }
 #endif  // defined(_MSC_VER) && (_MSC_VER < 1900)
@@ -1304,9 +1699,55 @@ tzdb_list::cend() const noexcept
 
 DATE_API tzdb_list& get_tzdb_list();
 
+DATE_API const tzdb& reload_tzdb();
+
+// A span of work on the tz database: loading it, reading a zone or expanding its rules.
+struct tzdb_span
+{
+    const char*                           name;    // such as "init_tzdb" or "load_zone"
+    const char*                           detail;  // the zone or file, nullptr for none
+    std::uintmax_t                        bytes;   // bytes read from files
+    std::chrono::steady_clock::time_point begin;
+    std::chrono::steady_clock::time_point end;
+};
+
+// Receives the spans of tz database work, on the thread that did the work and when
+// the work ends.  Spans of one thread nest.
+class tzdb_tracer
+{
+public:
+    virtual ~tzdb_tracer() = default;
+    virtual void span(const tzdb_span& s) = 0;
+};
+
+// Installs t, nullptr for none, and returns the tracer it replaces once no span reports
+// to it any more, so the caller may destroy it.  Spans already running keep reporting to
+// the tracer they started with and are waited for, which makes calling it from a tracer
+// or from tz database work on the same thread a deadlock.
+DATE_API tzdb_tracer* set_tzdb_tracer(tzdb_tracer* t) NOEXCEPT;
+
+#if TZ_ZONE_BUDGET
+
+// The tables of the zones read so far, and what the budget has dropped of them.
+struct zone_memory
+{
+    std::size_t   budget;          // 0 for none
+    std::size_t   resident_bytes;
+    std::size_t   resident_zones;
+    std::uint64_t evictions;       // tables dropped to stay within the budget
+    std::uint64_t reloads;         // zones read again after being dropped
+};
+
+// Keeps the tables of the zones read from zoneinfo files within bytes, 0 for no limit,
+// by dropping those of the zones used longest ago.  A dropped zone is read again on its
+// next use, its time_zone and the pointers to it stay valid throughout.
+DATE_API void        set_zone_memory_budget(std::size_t bytes);
+DATE_API zone_memory get_zone_memory();
+
+#endif  // TZ_ZONE_BUDGET
+
 #if !USE_OS_TZDB
 
-DATE_API const tzdb& reload_tzdb();
 DATE_API void        set_install(const std::string& install);
 
 #endif  // !USE_OS_TZDB
@@ -34,6 +34,10 @@
 #include <vector>
 #endif
 
+#if TZ_ZONE_BUDGET
+#include <shared_mutex>
+#endif
+
 namespace date
 {
 
@@ -256,6 +260,16 @@ struct zonelet
     zonelet& operator=(const zonelet&) = delete;
 };
 
+// A period of the transition table of a zone, abbrev is interned in the tzdb.
+struct table_entry
+{
+    sys_seconds          begin;
+    sys_seconds          end;
+    std::chrono::seconds offset;
+    std::chrono::minutes save;
+    const tz_string*     abbrev;
+};
+
 #else  // USE_OS_TZDB
 
 struct ttinfo
@@ -271,7 +285,7 @@ static_assert(sizeof(ttinfo) == 8, "");
 struct expanded_ttinfo
 {
     std::chrono::seconds offset;
-    std::string          abbrev;
+    const tz_string*     abbrev;  // interned in the tzdb
     bool                 is_dst;
 };
 
@@ -298,11 +312,53 @@ struct transition
             os << " daylight ";
         else
             os << " standard ";
-        os << t.info->abbrev;
+        os << *t.info->abbrev;
         return os;
     }
 };
 
+// The TZ string that ends a TZif file of version 2 or later, such as
+// "EST5EDT,M3.2.0,M11.1.0", which gives the offsets of the zone after the last
+// transition of the file.  Only rules with daylight saving time are kept.
+struct posix_rule
+{
+    // The local day and time of a change: day n of the year counted from 1 without
+    // February 29 (Jn), day n counted from 0 (n), or weekday d of week w of month m
+    // where week 5 is the last one (Mm.w.d).  The time may be negative or past 24h.
+    struct change
+    {
+        enum {julian, zero_based, month_week_day} kind;
+        unsigned             n;
+        unsigned             m;
+        unsigned             w;
+        unsigned             d;
+        std::chrono::seconds time;
+    };
+
+    std::uint64_t   id;  // unique in the process, keys the per thread cache of years
+    expanded_ttinfo std_info;
+    expanded_ttinfo dst_info;
+    change          start;  // in standard time
+    change          end;    // in daylight saving time
+};
+
+#if TZ_ZONE_BUDGET
+
+// How the tables of a zone stand against the memory budget.  Lookups hold mutex shared
+// while they read the tables, dropping them takes it exclusively.  last_use is the
+// residency clock at the last lookup, the clock advancing with each zone read, and the
+// other members are guarded by the list of resident zones.
+struct zone_residency
+{
+    std::shared_mutex          mutex;
+    std::atomic<std::uint64_t> last_use{0};
+    std::size_t                bytes = 0;
+    bool                       resident = false;
+    bool                       dropped = false;  // since it was last read, a reload is due
+};
+
+#endif  // TZ_ZONE_BUDGET
+
 #endif  // USE_OS_TZDB
 
 }  // namespace detail